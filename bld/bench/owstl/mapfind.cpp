@@ -24,12 +24,13 @@
 *
 *  ========================================================================
 *
-* Description: Benchmark program that tests finds in map
+* Description: Benchmark program that tests finds in map and unordered_map
 *
 ****************************************************************************/
 
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include "timer.h"
 #include <cstdlib>
 #include "testdata.hpp"
@@ -39,15 +40,20 @@ int comparecount = 0;
 struct cmp{
     bool operator()( int const x, int const y ) const { comparecount++; return( x < y ); }
 };
+struct eq{
+    bool operator()( int const x, int const y ) const { comparecount++; return( x == y ); }
+};
+
+typedef std::map< int, int, cmp > map_t;
+typedef std::unordered_map< int, int, std::hash< int >, eq > hash_t;
 
-double doit( TestData const & data, int mapsize, int repetitions )
+template< class m_t >
+double doit( m_t &m, TestData const & data, int mapsize, int repetitions )
 {
-    typedef std::map< int, int, cmp > m_t;
-    m_t m;
     int i, j;
     
     for( j = 0; j < mapsize; j++ ){
-        m.insert( m_t::value_type(data[j], j) );
+        m.insert( typename m_t::value_type(data[j], j) );
     }
     
     comparecount = 0;
@@ -74,19 +80,41 @@ int main( )
     TestData data(mapsize);
     data.fill_linear();
     
-    std::cout << "\nfinding " << mapsize
-              << " elements in map, linear order, "
-              << repetitions << " times\n";
-    std::cout << doit( data, mapsize, repetitions ) << " ms/pass\n";
-    std::cout << "compare called " << comparecount/repetitions << " times/pass\n";
+    {
+        map_t m;
+        std::cout << "\nfinding " << mapsize
+                  << " elements in map, linear order, "
+                  << repetitions << " times\n";
+        std::cout << doit( m, data, mapsize, repetitions ) << " ms/pass\n";
+        std::cout << "compare called " << comparecount/repetitions << " times/pass\n";
+    }
+    {
+        hash_t m;
+        std::cout << "\nfinding " << mapsize
+                  << " elements in unordered_map, linear order, "
+                  << repetitions << " times\n";
+        std::cout << doit( m, data, mapsize, repetitions ) << " ms/pass\n";
+        std::cout << "compare called " << comparecount/repetitions << " times/pass\n";
+    }
 
     data.fill_rand();
 
-    std::cout << "\nfinding " << mapsize
-              << " elements in map, random order, "
-              << repetitions << " times\n";
-    std::cout << doit( data, mapsize, repetitions ) << " ms/pass\n";
-    std::cout << "compare called " << comparecount/repetitions << " times/pass\n";
+    {
+        map_t m;
+        std::cout << "\nfinding " << mapsize
+                  << " elements in map, random order, "
+                  << repetitions << " times\n";
+        std::cout << doit( m, data, mapsize, repetitions ) << " ms/pass\n";
+        std::cout << "compare called " << comparecount/repetitions << " times/pass\n";
+    }
+    {
+        hash_t m;
+        std::cout << "\nfinding " << mapsize
+                  << " elements in unordered_map, random order, "
+                  << repetitions << " times\n";
+        std::cout << doit( m, data, mapsize, repetitions ) << " ms/pass\n";
+        std::cout << "compare called " << comparecount/repetitions << " times/pass\n";
+    }
     
     return( 0 );
 }
@@ -24,12 +24,13 @@
 *
 *  ========================================================================
 *
-* Description: Benchmark program that tests insertion into map
+* Description: Benchmark program that tests insertion into map and unordered_map
 *
 ****************************************************************************/
 
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include "timer.h"
 #include "testdata.hpp"
 
@@ -43,18 +44,23 @@ int comparecount = 0;
 struct cmp{
     bool operator()( int const x, int const y ) const { comparecount++; return( x < y ); }
 };
+struct eq{
+    bool operator()( int const x, int const y ) const { comparecount++; return( x == y ); }
+};
 
-double doit( TestData const & data, int const mapsize, int const repetitions )
-{
 #if defined(_STLPORT_VERSION) || defined(_MSC_VER)
-    typedef std::map< int, int, cmp > m_t;
+    typedef std::map< int, int, cmp > map_t;
 #else
-    typedef std::map< int, int, cmp, BlockAlloc<int> > m_t;
-    //typedef std::map< int, int, cmp > m_t;
+    typedef std::map< int, int, cmp, BlockAlloc<int> > map_t;
+    //typedef std::map< int, int, cmp > map_t;
 #endif
-    
+// BlockAlloc only hands out single objects, so it can't allocate the buckets.
+typedef std::unordered_map< int, int, std::hash< int >, eq > hash_t;
+
+template< class m_t >
+double doit( m_t &m, TestData const & data, int const mapsize, int const repetitions )
+{
     //m_t *m = new m_t[repetitions];
-    m_t m;
     int i, j;
     
     comparecount = 0;
@@ -65,7 +71,7 @@ double doit( TestData const & data, int const mapsize, int const repetitions )
         for( j = 0; j < mapsize; j++ ){
             //std::cout<<i<<" "<<j<<"\n";
             //m[i].insert( m_t::value_type(data[j], j) );
-            m.insert( m_t::value_type(data[j], j) );
+            m.insert( typename m_t::value_type(data[j], j) );
             //if( !m[i]._Sane() ) std::cout<<"!!!!!!!!!!!!!!insane\n";
         }
         m.clear();
@@ -87,21 +93,45 @@ int main( )
     
     data.fill_linear();
     
-    std::cout << "\ninserting " << mapsize 
-              << " linearly ordered elements into map "
-              << repetitions << " times\n";
-    std::cout << doit( data, mapsize, repetitions ) << " ms/pass\n";
-    std::cout << "compare called " << comparecount/repetitions 
-              << " times/pass\n";
+    {
+        map_t m;
+        std::cout << "\ninserting " << mapsize 
+                  << " linearly ordered elements into map "
+                  << repetitions << " times\n";
+        std::cout << doit( m, data, mapsize, repetitions ) << " ms/pass\n";
+        std::cout << "compare called " << comparecount/repetitions 
+                  << " times/pass\n";
+    }
+    {
+        hash_t m;
+        std::cout << "\ninserting " << mapsize 
+                  << " linearly ordered elements into unordered_map "
+                  << repetitions << " times\n";
+        std::cout << doit( m, data, mapsize, repetitions ) << " ms/pass\n";
+        std::cout << "compare called " << comparecount/repetitions 
+                  << " times/pass\n";
+    }
 
     data.fill_rand();
     
-    std::cout << "\ninserting " << mapsize 
-              << " randomly ordered elements into map "
-              << repetitions << " times\n";
-    std::cout << doit( data, mapsize, repetitions ) << " ms/pass\n";
-    std::cout << "compare called " << comparecount/repetitions 
-              << " times/pass\n";
+    {
+        map_t m;
+        std::cout << "\ninserting " << mapsize 
+                  << " randomly ordered elements into map "
+                  << repetitions << " times\n";
+        std::cout << doit( m, data, mapsize, repetitions ) << " ms/pass\n";
+        std::cout << "compare called " << comparecount/repetitions 
+                  << " times/pass\n";
+    }
+    {
+        hash_t m;
+        std::cout << "\ninserting " << mapsize 
+                  << " randomly ordered elements into unordered_map "
+                  << repetitions << " times\n";
+        std::cout << doit( m, data, mapsize, repetitions ) << " ms/pass\n";
+        std::cout << "compare called " << comparecount/repetitions 
+                  << " times/pass\n";
+    }
     
     return( 0 );
 }
@@ -24,8 +24,9 @@
 *
 *  ========================================================================
 *
-* Description: Benchmark program that exercises std::sort and compares
-*              its behavior with the C library's qsort().
+* Description: Benchmark program that exercises std::sort and std::stable_sort
+*              on random, sorted, reversed, organ pipe and few unique inputs
+*              and compares their behavior with the C library's qsort().
 *
 ****************************************************************************/
 
@@ -37,9 +38,10 @@
 
 using namespace std;
 
-#define SORT       std::sort  // Name of the STL-like sorting function.
-#define N          1000000    // Size of array to sort.
-#define TEST_COUNT 20         // Number of times array is sorted.
+#define SORT        std::sort         // Name of the STL-like sorting function.
+#define STABLE_SORT std::stable_sort  // Name of the STL-like stable sorting function.
+#define N           1000000           // Size of array to sort.
+#define TEST_COUNT  20                // Number of times array is sorted.
 
 // Make a pseudo-random array of integers.
 void make_random( int *p1, int *p2 )
@@ -59,6 +61,37 @@ void make_sorted( int *p1, int *p2 )
   }
 }
 
+// Make a reverse sorted array of integers.
+void make_reversed( int *p1, int *p2 )
+{
+  int value = p2 - p1;
+  while( p1 != p2 ) {
+    *p1++ = value--;
+  }
+}
+
+// Make an array that rises to a peak in the middle and falls again.
+void make_organ_pipe( int *p1, int *p2 )
+{
+  int  value = 0;
+  int *mid = p1 + ( p2 - p1 ) / 2;
+  while( p1 != mid ) {
+    *p1++ = value++;
+  }
+  while( p1 != p2 ) {
+    *p1++ = value--;
+  }
+}
+
+// Make a pseudo-random array of integers with only a few distinct values.
+void make_few_unique( int *p1, int *p2 )
+{
+  srand( 0 );
+  while( p1 != p2 ) {
+    *p1++ = rand() % 16;
+  }
+}
+
 // Make a pseudo-random array of std::strings.
 void make_random_strings( std::string *p1, std::string *p2 )
 {
@@ -96,6 +129,21 @@ void cpp_sort(T *working, T *holding, int size, char *caption)
             << interval/static_cast<double>( CLOCKS_PER_SEC ) << "\n";
 }
 
+// Use the C++ library std::stable_sort (or something similar) to sort array of Ts.
+template< class T >
+void cpp_stable_sort(T *working, T *holding, int size, char *caption)
+{
+  clock_t interval = clock();
+
+  for(int i = 0; i < TEST_COUNT; ++i) {
+    copy( holding, holding + size, working);
+    STABLE_SORT( working, working + size );
+  }
+  interval = clock() - interval;
+  std::cout << "std::stable_sort => " << caption << ": "
+            << interval/static_cast<double>( CLOCKS_PER_SEC ) << "\n";
+}
+
 // Use C library qsort() to sort arrays of integers.
 void c_sort(int *working, int *holding, int size, char *caption)
 {
@@ -119,14 +167,32 @@ int main( )
 
   make_random( int_holding, int_holding + N );
   cpp_sort( int_working, int_holding, N, "random" );
+  cpp_stable_sort( int_working, int_holding, N, "random" );
   c_sort( int_working, int_holding, N, "random" );
 
   make_sorted( int_holding, int_holding + N );
   cpp_sort( int_working, int_holding, N, "sorted" );
+  cpp_stable_sort( int_working, int_holding, N, "sorted" );
   c_sort( int_working, int_holding, N, "sorted" );
 
+  make_reversed( int_holding, int_holding + N );
+  cpp_sort( int_working, int_holding, N, "reversed" );
+  cpp_stable_sort( int_working, int_holding, N, "reversed" );
+  c_sort( int_working, int_holding, N, "reversed" );
+
+  make_organ_pipe( int_holding, int_holding + N );
+  cpp_sort( int_working, int_holding, N, "organ pipe" );
+  cpp_stable_sort( int_working, int_holding, N, "organ pipe" );
+  c_sort( int_working, int_holding, N, "organ pipe" );
+
+  make_few_unique( int_holding, int_holding + N );
+  cpp_sort( int_working, int_holding, N, "few unique" );
+  cpp_stable_sort( int_working, int_holding, N, "few unique" );
+  c_sort( int_working, int_holding, N, "few unique" );
+
   make_random_strings( string_holding, string_holding + N );
   cpp_sort( string_working, string_holding, N, "string" );
+  cpp_stable_sort( string_working, string_holding, N, "string" );
 
   delete [] int_working;
   delete [] int_holding;
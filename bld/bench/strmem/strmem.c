@@ -0,0 +1,182 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+*    Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Benchmark of the C library string and memory scanning
+*               functions, comparing the scalar and SSE2 versions over a
+*               range of buffer sizes.
+*
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "report.h"
+#include "timer.h"
+
+#define TOTAL_BYTES     (64UL * 1024 * 1024)    /* bytes scanned per test */
+#define MAX_SIZE        65536
+
+#if defined( __WATCOMC__ ) && defined( __386__ ) && ( defined( __NT__ ) || defined( __LINUX__ ) )
+/*
+ * Set by the run-time library when the CPU supports SSE2. Clearing it
+ * makes the library use its scalar code.
+ */
+extern unsigned char    __sse2_present;
+#define SSE2_SWITCH
+#endif
+
+/*
+ * Call through pointers so the compiler can't inline the functions.
+ */
+static size_t   (*p_strlen)( const char * ) = strlen;
+static char     *(*p_strchr)( const char *, int ) = strchr;
+static int      (*p_strcmp)( const char *, const char * ) = strcmp;
+static void     *(*p_memchr)( const void *, int, size_t ) = memchr;
+static int      (*p_memcmp)( const void *, const void *, size_t ) = memcmp;
+
+static char             *buf1;
+static char             *buf2;
+static volatile size_t  sink;
+
+static void run_strlen( size_t size, unsigned long reps )
+{
+    while( reps-- > 0 ) {
+        sink += p_strlen( buf1 );
+    }
+}
+
+static void run_strchr( size_t size, unsigned long reps )
+{
+    while( reps-- > 0 ) {
+        sink += ( p_strchr( buf1, 'y' ) != NULL );
+    }
+}
+
+static void run_strcmp( size_t size, unsigned long reps )
+{
+    while( reps-- > 0 ) {
+        sink += p_strcmp( buf1, buf2 );
+    }
+}
+
+static void run_memchr( size_t size, unsigned long reps )
+{
+    while( reps-- > 0 ) {
+        sink += ( p_memchr( buf1, 'y', size ) != NULL );
+    }
+}
+
+static void run_memcmp( size_t size, unsigned long reps )
+{
+    while( reps-- > 0 ) {
+        sink += p_memcmp( buf1, buf2, size );
+    }
+}
+
+static struct {
+    const char  *name;
+    void        (*run)( size_t size, unsigned long reps );
+} tests[] = {
+    { "strlen", run_strlen },
+    { "strchr", run_strchr },
+    { "strcmp", run_strcmp },
+    { "memchr", run_memchr },
+    { "memcmp", run_memcmp },
+};
+
+static size_t sizes[] = { 8, 16, 32, 64, 256, 1024, 4096, MAX_SIZE };
+
+#define NUM_TESTS   (sizeof( tests ) / sizeof( tests[0] ))
+#define NUM_SIZES   (sizeof( sizes ) / sizeof( sizes[0] ))
+
+static double timeTest( unsigned t, size_t size, const char *mode )
+{
+    unsigned long   reps;
+    char            name[40];
+
+    /*
+     * Both buffers hold size - 1 'x' characters and a nul; they start one
+     * byte past a 16 byte boundary, like most strings do.
+     */
+    memset( buf1, 'x', size - 1 );
+    buf1[size - 1] = '\0';
+    memcpy( buf2, buf1, size );
+    reps = TOTAL_BYTES / size;
+    TimerOn();
+    tests[t].run( size, reps );
+    TimerOff();
+    sprintf( name, "%s(%u,%s)", tests[t].name, (unsigned)size, mode );
+    Report( name, TimerElapsed() );
+    return( (double)TOTAL_BYTES / TimerElapsed() / ( 1024.0 * 1024.0 ) );
+}
+
+int main( void )
+{
+    int             sse2;
+    unsigned        t;
+    size_t          s;
+    double          scalar;
+    double          vector;
+
+    buf1 = (char *)malloc( MAX_SIZE + 32 );
+    buf2 = (char *)malloc( MAX_SIZE + 32 );
+    if( buf1 == NULL || buf2 == NULL ) {
+        printf( "Out of memory\n" );
+        return( EXIT_FAILURE );
+    }
+    buf1 = (char *)( ( (unsigned long)buf1 + 15 ) & ~15UL ) + 1;
+    buf2 = (char *)( ( (unsigned long)buf2 + 15 ) & ~15UL ) + 1;
+
+#ifdef SSE2_SWITCH
+    sse2 = __sse2_present;
+#else
+    sse2 = 0;
+#endif
+    if( !sse2 ) {
+        printf( "No SSE2 support, timing the scalar functions only\n" );
+    }
+    printf( "%-8s %8s %12s %12s %8s\n", "function", "size", "scalar MB/s", "SSE2 MB/s", "ratio" );
+    for( t = 0; t < NUM_TESTS; t++ ) {
+        for( s = 0; s < NUM_SIZES; s++ ) {
+#ifdef SSE2_SWITCH
+            __sse2_present = 0;
+#endif
+            scalar = timeTest( t, sizes[s], "scalar" );
+            if( sse2 ) {
+#ifdef SSE2_SWITCH
+                __sse2_present = 1;
+#endif
+                vector = timeTest( t, sizes[s], "sse2" );
+                printf( "%-8s %8u %12.1f %12.1f %8.2f\n", tests[t].name,
+                    (unsigned)sizes[s], scalar, vector, vector / scalar );
+            } else {
+                printf( "%-8s %8u %12.1f %12s %8s\n", tests[t].name,
+                    (unsigned)sizes[s], scalar, "-", "-" );
+            }
+        }
+    }
+    return( EXIT_SUCCESS );
+}
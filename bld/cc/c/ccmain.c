@@ -85,6 +85,7 @@ void FrontEndInit( bool reuse )
     GlobalCompFlags.ide_console_output = false;
     GlobalCompFlags.progress_messages = false;
 //    GlobalCompFlags.dll_active = false;
+    InitMsg();
 }
 
 void FrontEndFini( void )
@@ -94,6 +95,8 @@ void FrontEndFini( void )
 {
     GlobalCompFlags.cc_reuse = false;
     GlobalCompFlags.cc_first_use = true;
+    CMemFini();     /* free what the last run kept */
+    FiniMsg();
 }
 
 static void initGlobals( void )
@@ -482,7 +485,12 @@ static void OpenCppFile( void )
         if( CppWidth == 0 ) {
             CppWidth = ~0U;
         }
-        setvbuf( CppFile, CPermAlloc( 4096 ), _IOFBF, 4096 );
+        /*
+         * stdout outlives the permanent area of a reused compiler
+         */
+        if( CppFile != stdout ) {
+            setvbuf( CppFile, CPermAlloc( 4096 ), _IOFBF, 4096 );
+        }
     }
 }
 
@@ -1401,7 +1409,9 @@ void CloseFiles( void )
             sprintf( msgbuf, msgtxt, strerror( errno ) );
             NoteMsg( msgbuf );
         }
-        fclose( CppFile );
+        if( CppFile != stdout ) {
+            fclose( CppFile );
+        }
         CppFile = NULL;
     }
     if( ErrFile != NULL ) {
@@ -1430,7 +1440,6 @@ bool FrontEnd( char **cmdline )
 
     InitGlobalVars();
     CMemInit();
-    InitMsg();
     InitPurge();
 
     SwitchChar = _dos_switch_char();
@@ -1438,7 +1447,6 @@ bool FrontEnd( char **cmdline )
     DoCCompile( cmdline );
     finiGlobals();
     PurgeMemory();
-    FiniMsg();
     CMemFini();
     GlobalCompFlags.cc_first_use = false;
     return( ErrCount != 0 );
@@ -137,7 +137,15 @@ void InitGlobalVars( void )
 #endif
 
     MacroDepth              = 0;
+    MacHash                 = NULL;
+    MacHashSize             = 0;
+    EnumTable               = NULL;
+    EnumHashSize            = 0;
     HashTab                 = NULL;
+    SymHashSize             = 0;
+    SymHashCount            = 0;
+    StringHash              = NULL;
+    StringHashSize          = 0;
 
     GenSwitches             = 0;        /* target independant switches for code generator */
     TargetSwitches          = 0;        /* target specific code generator switches */
@@ -101,17 +101,82 @@ struct {
     { TYP_ULONG64,  TARGET_LONG64 },    //U64
 };
 
+static unsigned     EnumHashCount;      /* # of entries in EnumTable */
+static ENUMPTR      EnumLevelList[ID_LEVEL_COUNT];  /* constants of each level, newest first */
+
 void EnumInit( void )
 {
     id_hash_idx   hash;
+    unsigned      level;
 
-    for( hash = 0; hash < ID_HASH_SIZE; hash++ ) {
+    EnumHashCount = 0;
+    EnumHashSize = ID_HASH_SIZE;
+    EnumTable = CMemAlloc( EnumHashSize * sizeof( ENUMPTR ) );
+    for( hash = 0; hash < EnumHashSize; hash++ ) {
         EnumTable[hash] = NULL;
     }
+    for( level = 0; level < ID_LEVEL_COUNT; level++ ) {
+        EnumLevelList[level] = NULL;
+    }
     EnumRecSize = 0;
 }
 
 
+static void EnumHashGrow( void )
+/*******************************
+ * double the enum table when it averages more than two entries per bucket;
+ * the order within each bucket is kept so inner scopes still come first
+ */
+{
+    ENUMPTR     *old_table;
+    unsigned    old_size;
+    ENUMPTR     **tails;
+    ENUMPTR     esym;
+    ENUMPTR     next_esym;
+    unsigned    bucket;
+    unsigned    i;
+
+    if( ++EnumHashCount <= 2 * EnumHashSize || EnumHashSize >= ID_HASH_SIZE_MAX )
+        return;
+    old_table = EnumTable;
+    old_size = EnumHashSize;
+    EnumHashSize = 2 * old_size;
+    EnumTable = CMemAlloc( EnumHashSize * sizeof( ENUMPTR ) );
+    tails = CMemAlloc( EnumHashSize * sizeof( ENUMPTR * ) );
+    for( i = 0; i < EnumHashSize; i++ ) {
+        EnumTable[i] = NULL;
+        tails[i] = &EnumTable[i];
+    }
+    for( i = 0; i < old_size; i++ ) {
+        for( esym = old_table[i]; esym != NULL; esym = next_esym ) {
+            next_esym = esym->next_enum;
+            esym->next_enum = NULL;
+            bucket = HASH_BUCKET( esym->hash, EnumHashSize );
+            *tails[bucket] = esym;
+            tails[bucket] = &esym->next_enum;
+        }
+    }
+    CMemFree( tails );
+    CMemFree( old_table );
+}
+
+
+static void EnumAddLevel( ENUMPTR esym )
+{
+    esym->next_level = EnumLevelList[esym->parent->level];
+    EnumLevelList[esym->parent->level] = esym;
+}
+
+
+void EnumAddHash( ENUMPTR esym )
+{
+    EnumHashGrow();
+    esym->next_enum = EnumTable[HASH_BUCKET( esym->hash, EnumHashSize )];
+    EnumTable[HASH_BUCKET( esym->hash, EnumHashSize )] = esym;
+    EnumAddLevel( esym );
+}
+
+
 static ENUMPTR EnumLkAdd( TAGPTR tag )
 {
     ENUMPTR     esym;
@@ -128,7 +193,12 @@ static ENUMPTR EnumLkAdd( TAGPTR tag )
     esym->parent = tag;
     esym->hash = hash;
     esym->src_loc = TokenLoc;
-    esym->next_enum = EnumTable[hash];
+    /*
+     * the constant is not visible until its value is known,
+     * so it is only linked in once EnumDecl has computed it
+     */
+    EnumHashGrow();
+    esym->next_enum = EnumTable[HASH_BUCKET( hash, EnumHashSize )];
     ++EnumCount;
     if( tag->u.enum_list == NULL ) {
         tag->u.enum_list = esym;
@@ -308,7 +378,8 @@ TYPEPTR EnumDecl( type_modifiers flags )
                 InitErrLoc();
             }
             esym->value = n;
-            EnumTable[esym->hash] = esym;
+            EnumTable[HASH_BUCKET( esym->hash, EnumHashSize )] = esym;
+            EnumAddLevel( esym );
             if( CurToken == T_RIGHT_BRACE )
                 break;
             U64Add( &n, &Inc, &n );
@@ -329,7 +400,7 @@ ENUMPTR EnumLookup( id_hash_idx hash, const char *name )
 {
     ENUMPTR     esym;
 
-    for( esym = EnumTable[hash]; esym != NULL; esym = esym->next_enum ) {
+    for( esym = EnumTable[HASH_BUCKET( hash, EnumHashSize )]; esym != NULL; esym = esym->next_enum ) {
         if( strcmp( esym->name, name ) == 0 ) {
             break;
         }
@@ -339,16 +410,22 @@ ENUMPTR EnumLookup( id_hash_idx hash, const char *name )
 
 
 void FreeEnums( void )
+/*********************
+ * unlink the constants of the current level; the newest one is
+ * normally at the head of its bucket
+ */
 {
     ENUMPTR         esym;
-    id_hash_idx     hash;
+    ENUMPTR         *head;
 
-    for( hash = 0; hash < ID_HASH_SIZE; hash++ ) {
-        for( ; (esym = EnumTable[hash]) != NULL; EnumTable[hash] = esym->next_enum ) {
-            if( !ChkEqSymLevel( esym->parent ) ) {
-                break;
-            }
+    esym = EnumLevelList[(id_level_type)SymLevel];
+    EnumLevelList[(id_level_type)SymLevel] = NULL;
+    for( ; esym != NULL; esym = esym->next_level ) {
+        for( head = &EnumTable[HASH_BUCKET( esym->hash, EnumHashSize )]; *head != esym; ) {
+            head = &(*head)->next_enum;
         }
+        *head = esym->next_enum;
+        --EnumHashCount;
     }
 }
 
@@ -360,7 +437,7 @@ void DumpEnumTable( void )
     id_hash_idx     hash;
 
     puts( "ENUM TABLE DUMP" );
-    for( hash = 0; hash < ID_HASH_SIZE; hash++ ) {
+    for( hash = 0; hash < EnumHashSize; hash++ ) {
         for( esym = EnumTable[hash]; esym != NULL; esym = esym->next_enum ) {
             if( ChkEqSymLevel( esym->parent ) ) {
                 printf( "%s = %lld\n", esym->name, esym->value.u._64[0] );
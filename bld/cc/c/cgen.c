@@ -839,7 +839,7 @@ static void FreeStrings( void )
     STR_HANDLE      strlit_next;
     str_hash_idx    hash;
 
-    for( hash = 0; hash < STRING_HASH_SIZE; hash++ ) {
+    for( hash = 0; hash < StringHashSize; hash++ ) {
         for( strlit = StringHash[hash]; strlit != NULL; strlit = strlit_next ) {
             strlit_next = strlit->next_string;
             if( strlit->back_handle != NULL ) {
@@ -869,7 +869,7 @@ static void EmitCS_Strings( void )
     str_hash_idx    hash;
 
     if( CompFlags.strings_in_code_segment ) {
-        for( hash = STRING_HASH_SIZE; hash-- > 0; ) {
+        for( hash = StringHashSize; hash-- > 0; ) {
             DumpCS_Strings( StringHash[hash] );
         }
     }
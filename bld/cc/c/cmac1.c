@@ -44,6 +44,13 @@
 #define MACRO_END_CHAR          'Z'
 #define MACRO_END_STRING        "Z-<end of macro>"
 
+#define MTOK_BUF_SIZE           256
+
+/*
+ * a macro token is a TOKEN followed by its data and a null character
+ */
+#define MTOK_DATA(p)            ((p) + sizeof( TOKEN ))
+
 typedef enum exp_state {
     EXPANDABLE_NO       = 0,    // macro is currently not expandable
     EXPANDABLE_YES      = 1,    // macro is expandable
@@ -56,14 +63,24 @@ typedef struct tokens {
     char            buf[1];
 } tokens;
 
-typedef struct macro_token {
-    struct macro_token  *next;
-    TOKEN               token;
-    char                data[1];
-} MACRO_TOKEN;
+/*
+ * Macro tokens are kept one after the other in a buffer. Tokens are read
+ * from the front and written at the end; an expansion is put back in
+ * front of the tokens still to be read
+ */
+typedef struct mtok_buf {
+    struct mtok_buf *next;          // next free buffer
+    char            *tokens;
+    size_t          size;           // allocated size of tokens
+    size_t          beg;            // offset of the first token
+    size_t          end;            // offset past the last token
+} MTOK_BUF;
 
 typedef struct macro_arg {
-    char    *arg;
+    char        *arg;
+    size_t      expanded_beg;       // arg after macro replacement, kept in
+    size_t      expanded_end;       // - the replacement list being built
+    bool        expanded_done;      // expanded_beg and expanded_end are valid
 } MACRO_ARG;
 
 typedef struct nested_macros {
@@ -80,13 +97,14 @@ typedef struct special_macro_names {
     macro_flags     flags;
 } special_macro_names;
 
-extern void         DumpMTokens( MACRO_TOKEN *mtok );
+extern void         DumpMTokens( MTOK_BUF *mbuf );
 
 static NESTED_MACRO *NestedMacros;
-static MACRO_TOKEN  *TokenList;
+static MTOK_BUF     *TokenList;
 static size_t       TokenBufSize;
+static MTOK_BUF     *MTokBufFree;
 
-static MACRO_TOKEN  *ExpandNestedMacros( MACRO_TOKEN *head, bool rescanning );
+static void         ExpandNestedMacros( MTOK_BUF *out, MTOK_BUF *in, bool rescanning );
 
 static struct special_macro_names  SpcMacros[] = {
     #define pick(s,i,f)     { s, i, f },
@@ -149,6 +167,143 @@ static size_t TokenBufRemoveWSToken( size_t i )
     return( i );
 }
 
+static MTOK_BUF *GetMTokBuf( void )
+/**********************************/
+{
+    MTOK_BUF    *mbuf;
+
+    mbuf = MTokBufFree;
+    if( mbuf != NULL ) {
+        MTokBufFree = mbuf->next;
+    } else {
+        mbuf = CMemAlloc( sizeof( MTOK_BUF ) );
+        mbuf->tokens = CMemAlloc( MTOK_BUF_SIZE );
+        mbuf->size = MTOK_BUF_SIZE;
+    }
+    mbuf->beg = 0;
+    mbuf->end = 0;
+    return( mbuf );
+}
+
+static void FreeMTokBuf( MTOK_BUF *mbuf )
+/***************************************/
+{
+    mbuf->next = MTokBufFree;
+    MTokBufFree = mbuf;
+}
+
+static size_t MTokSize( const char *p )
+/*************************************/
+{
+    return( sizeof( TOKEN ) + strlen( MTOK_DATA( p ) ) + 1 );
+}
+
+static char *MTokFirst( MTOK_BUF *mbuf )
+/**************************************/
+{
+    if( mbuf->beg == mbuf->end )
+        return( NULL );
+    return( mbuf->tokens + mbuf->beg );
+}
+
+static void MTokSkip( MTOK_BUF *mbuf )
+/************************************/
+{
+    mbuf->beg += MTokSize( mbuf->tokens + mbuf->beg );
+}
+
+static void MTokReserve( MTOK_BUF *mbuf, size_t len )
+/****************************************************
+ * make room for len more bytes after the last token
+ */
+{
+    size_t      size;
+
+    if( mbuf->end + len > mbuf->size ) {
+        size = _RoundUp( 2 * ( mbuf->end + len ), MTOK_BUF_SIZE );
+        mbuf->tokens = CMemRealloc( mbuf->tokens, size );
+        mbuf->size = size;
+    }
+}
+
+static void MTokAppend( MTOK_BUF *mbuf, TOKEN token, const char *data )
+/*********************************************************************/
+{
+    size_t      len;
+    char        *p;
+
+    len = strlen( data ) + 1;
+    MTokReserve( mbuf, sizeof( TOKEN ) + len );
+    p = mbuf->tokens + mbuf->end;
+    MTOK( p ) = token;
+    memcpy( MTOK_DATA( p ), data, len );
+    mbuf->end += sizeof( TOKEN ) + len;
+}
+
+static void MTokAppendMem( MTOK_BUF *mbuf, const char *p, size_t len )
+/********************************************************************/
+{
+    MTokReserve( mbuf, len );
+    memcpy( mbuf->tokens + mbuf->end, p, len );
+    mbuf->end += len;
+}
+
+static void MTokAppendCopy( MTOK_BUF *mbuf, size_t beg, size_t end )
+/*******************************************************************
+ * append a copy of tokens already in the buffer
+ */
+{
+    MTokReserve( mbuf, end - beg );
+    memcpy( mbuf->tokens + mbuf->end, mbuf->tokens + beg, end - beg );
+    mbuf->end += end - beg;
+}
+
+static void MTokMove( MTOK_BUF *out, MTOK_BUF *in )
+/**************************************************
+ * move the first token of in to the end of out
+ */
+{
+    size_t      len;
+
+    len = MTokSize( in->tokens + in->beg );
+    MTokAppendMem( out, in->tokens + in->beg, len );
+    in->beg += len;
+}
+
+static void MTokPrepend( MTOK_BUF *mbuf, MTOK_BUF *src )
+/*******************************************************
+ * put the tokens of src in front of the first token
+ */
+{
+    size_t      len;
+    size_t      used;
+    size_t      size;
+    char        *tokens;
+
+    len = src->end - src->beg;
+    if( mbuf->beg < len ) {
+        /*
+         * move the tokens to the end of the buffer, leaving at least
+         * half of it free in front of them
+         */
+        used = mbuf->end - mbuf->beg;
+        if( 2 * ( used + len ) > mbuf->size ) {
+            size = _RoundUp( 2 * ( used + len ), MTOK_BUF_SIZE );
+            tokens = CMemAlloc( size );
+            memcpy( tokens + size - used, mbuf->tokens + mbuf->beg, used );
+            CMemFree( mbuf->tokens );
+            mbuf->tokens = tokens;
+            mbuf->size = size;
+        } else {
+            memmove( mbuf->tokens + mbuf->size - used, mbuf->tokens + mbuf->beg, used );
+        }
+        mbuf->beg = mbuf->size - used;
+        mbuf->end = mbuf->size;
+    }
+    mbuf->beg -= len;
+    memcpy( mbuf->tokens + mbuf->beg, src->tokens + src->beg, len );
+}
+
 static void SpecialMacroAdd( special_macro_names *mac )
 /*****************************************************/
 {
@@ -170,11 +325,13 @@ void MacroInit( void )
     CppStackInit();
     InitPPexpn();
     NestedMacros = NULL;
-    TokenList = NULL;
+    MTokBufFree = NULL;
+    TokenList = GetMTokBuf();
     UndefMacroList = NULL;
     InitialMacroFlags = MFLAG_DEFINED_BEFORE_FIRST_INCLUDE;
-    MacHash = PermMemAlloc( MACRO_HASH_SIZE * sizeof( MEPTR ) );
-    for( hash = 0; hash < MACRO_HASH_SIZE; hash++ ) {
+    MacHashSize = MACRO_HASH_SIZE;
+    MacHash = CMemAlloc( MacHashSize * sizeof( MEPTR ) );
+    for( hash = 0; hash < MacHashSize; hash++ ) {
         MacHash[hash] = NULL;
     }
     for( i = MACRO_FIRST; i <= MACRO_LAST; i++ ) {
@@ -199,9 +356,18 @@ void MacroAddComp( void )
 void MacroFini( void )
 /********************/
 {
+    MTOK_BUF        *mbuf;
+
     FiniPPexpn();
     CppStackFini();
     MacroPurge();
+    FreeMTokBuf( TokenList );
+    TokenList = NULL;
+    while( (mbuf = MTokBufFree) != NULL ) {
+        MTokBufFree = mbuf->next;
+        CMemFree( mbuf->tokens );
+        CMemFree( mbuf );
+    }
 }
 
 
@@ -212,7 +378,7 @@ void MacroPurge( void )
     mac_hash_idx    hash;
     MEPTR           mentry;
 
-    for( hash = 0; hash < MACRO_HASH_SIZE; hash++ ) {
+    for( hash = 0; hash < MacHashSize; hash++ ) {
         for( ; (mentry = MacHash[hash]) != NULL; ) {
             MacHash[hash] = mentry->next_macro;
             CMemFree( mentry );
@@ -247,22 +413,22 @@ static void DeleteNestedMacro( void )
 TOKEN GetMacroToken( void )
 /*************************/
 {
-    MACRO_TOKEN     *mtok;
+    char            *p;
+    char            *data;
     bool            keep_token;
     TOKEN           token;
 
-    for( ; (mtok = TokenList) != NULL; ) {
-        if( (token = mtok->token) != T_NULL ) {
+    for( ; (p = MTokFirst( TokenList )) != NULL; ) {
+        if( (token = MTOK( p )) != T_NULL ) {
             break;
         }
-        if( mtok->data[0] == MACRO_END_CHAR ) {     // if end of macro
+        if( *MTOK_DATA( p ) == MACRO_END_CHAR ) {   // if end of macro
             DeleteNestedMacro();
         }
-        TokenList = mtok->next;
-        CMemFree( mtok );
+        MTokSkip( TokenList );
     }
     TokenLen = 0;
-    if( mtok == NULL ) {
+    if( p == NULL ) {
         MacroPtr = NULL;
         token = T_NULL;
         Buffer[0] = '\0';
@@ -270,7 +436,8 @@ TOKEN GetMacroToken( void )
         /*
          * size of Buffer is OK, token data was processed in Buffer before
          */
-        while( (Buffer[TokenLen] = mtok->data[TokenLen]) != '\0' ) {
+        data = MTOK_DATA( p );
+        while( (Buffer[TokenLen] = data[TokenLen]) != '\0' ) {
             TokenLen++;
         }
         keep_token = false;
@@ -284,10 +451,8 @@ TOKEN GetMacroToken( void )
         case T_UNEXPANDABLE_ID:
             if( !CompFlags.doing_macro_expansion ) {
                 if( IS_PPOPERATOR_PRAGMA( Buffer, TokenLen ) ) {
-                    TokenList = mtok->next;
-                    CMemFree( mtok );
+                    MTokSkip( TokenList );
                     token = Process_Pragma();
-                    mtok = TokenList;
                     keep_token = true;
                 } else {
                     token = KwLookup( Buffer, TokenLen );
@@ -296,26 +461,21 @@ TOKEN GetMacroToken( void )
             break;
         case T_BAD_TOKEN:
         case T_CONSTANT:
-            ReScanInit( mtok->data );
+            ReScanInit( data );
             token = ReScanToken();
             break;
         case T_PPNUMBER:
-            ReScanInit( mtok->data );
+            ReScanInit( data );
             token = ReScanToken();
             if( !CompFlags.rescan_buffer_done ) {   // didn't finish string bad boy
-                const char  *tcur;
-                char        *tbeg;
-
-                tbeg = mtok->data;
-                tcur = ReScanPos();
                 /*
-                 * ppnumber is quite general so it may absorb multiple tokens
-                 * overlapping src & dst so do our own copy;
+                 * ppnumber is quite general so it may absorb multiple tokens,
+                 * what is left becomes the first token, it ends where the
+                 * old one did
                  */
-                for( ; (*tbeg = *tcur) != '\0'; ) {
-                    ++tcur;
-                    ++tbeg;
-                }
+                p = (char *)ReScanPos() - sizeof( TOKEN );
+                MTOK( p ) = T_PPNUMBER;
+                TokenList->beg = p - TokenList->tokens;
                 keep_token = true;
             }
             break;
@@ -328,8 +488,7 @@ TOKEN GetMacroToken( void )
             break;
         }
         if( !keep_token ) {
-            TokenList = mtok->next;
-            CMemFree( mtok );
+            MTokSkip( TokenList );
         }
     }
     return( token );
@@ -655,11 +814,13 @@ void DumpMDefn( const char *p )
 }
 
 
-void DumpMTokens( MACRO_TOKEN *mtok )
-/***********************************/
+void DumpMTokens( MTOK_BUF *mbuf )
+/********************************/
 {
-    for( ; mtok != NULL; mtok = mtok->next ) {
-        printf( "%s\n", mtok->data );
+    size_t      i;
+
+    for( i = mbuf->beg; i < mbuf->end; i += MTokSize( mbuf->tokens + i ) ) {
+        printf( "%s\n", MTOK_DATA( mbuf->tokens + i ) );
     }
     fflush( stdout );
 }
@@ -678,45 +839,7 @@ void DumpNestedMacros( void )
 #endif
 
 
-static MACRO_TOKEN *BuildAToken( TOKEN token, const char *data )
-/**************************************************************/
-{
-    MACRO_TOKEN *mtok;
-
-    mtok = (MACRO_TOKEN *)CMemAlloc( sizeof( MACRO_TOKEN ) + strlen( data ) );
-    strcpy( mtok->data, data );
-    mtok->token = token;
-    mtok->next = NULL;
-    return( mtok );
-}
-
-
-static MACRO_TOKEN **BuildATokenOnEnd( MACRO_TOKEN **ptail, TOKEN token, const char *data )
-/*****************************************************************************************/
-{
-    *ptail = BuildAToken( token, data );
-    return( &(*ptail)->next );
-}
-
 
-static MACRO_TOKEN *AppendToken( MACRO_TOKEN *head, TOKEN token, const char *data )
-/*********************************************************************************/
-{
-    MACRO_TOKEN *tail;
-    MACRO_TOKEN *new;
-
-    new = BuildAToken( token, data );
-    if( head == NULL ) {
-        head = new;
-    } else {
-        tail = head;
-        while( tail->next != NULL ) {
-            tail = tail->next;
-        }
-        tail->next = new;
-    }
-    return( head );
-}
 
 static bool MacroBeingExpanded( MEPTR mentry )
 /********************************************/
@@ -733,9 +856,13 @@ static bool MacroBeingExpanded( MEPTR mentry )
     return( false );
 }
 
-static exp_state isExpandable( MEPTR mentry, MACRO_TOKEN *mtok, bool macro_parm )
-/*******************************************************************************/
+static exp_state isExpandable( MEPTR mentry, MTOK_BUF *in, bool macro_parm )
+/***************************************************************************
+ * mentry is the first token of in
+ */
 {
+    const char  *p;
+    const char  *end;
     int         lparen;
 
     if( MacroIsSpecial( mentry ) ) {            /* if special macro */
@@ -749,20 +876,22 @@ static exp_state isExpandable( MEPTR mentry, MACRO_TOKEN *mtok, bool macro_parm
         }
         return( EXPANDABLE_YES );
     }
-    for( ; mtok != NULL; mtok = mtok->next ) {
-        if( mtok->token != T_WHITE_SPACE && mtok->token != T_NULL ) {
+    p = in->tokens + in->beg;
+    end = in->tokens + in->end;
+    for( p += MTokSize( p ); p < end; p += MTokSize( p ) ) {
+        if( MTOK( p ) != T_WHITE_SPACE && MTOK( p ) != T_NULL ) {
             break;
         }
     }
-    if( mtok != NULL ) {
-        if( mtok->token == T_LEFT_PAREN ) {
+    if( p < end ) {
+        if( MTOK( p ) == T_LEFT_PAREN ) {
             if( MacroDepth == 1 && !macro_parm )
                 return( EXPANDABLE_YES );
             lparen = 0;
-            for( ; (mtok = mtok->next) != NULL; ) {
-                if( mtok->token == T_LEFT_PAREN ) {
+            for( p += MTokSize( p ); p < end; p += MTokSize( p ) ) {
+                if( MTOK( p ) == T_LEFT_PAREN ) {
                     ++lparen;
-                } else if( mtok->token == T_RIGHT_PAREN ) {
+                } else if( MTOK( p ) == T_RIGHT_PAREN ) {
                     if( lparen == 0 )
                         return( EXPANDABLE_YES );
                     --lparen;
@@ -780,8 +909,8 @@ static exp_state isExpandable( MEPTR mentry, MACRO_TOKEN *mtok, bool macro_parm
     return( EXPANDABLE_NO );
 }
 
-static char *GlueTokenToBuffer( MACRO_TOKEN *first, char *gluebuf )
-/*****************************************************************/
+static char *GlueTokenToBuffer( char *first, char *gluebuf )
+/**********************************************************/
 {
     size_t      gluelen;
     size_t      tokenlen;
@@ -789,7 +918,7 @@ static char *GlueTokenToBuffer( MACRO_TOKEN *first, char *gluebuf )
 
     buf = NULL;
     if( first != NULL ) {
-        MacroPtr = (char *)&first->token;
+        MacroPtr = first;
         buf = ExpandMacroToken();
     }
     if( buf == NULL ) {
@@ -808,149 +937,160 @@ static char *GlueTokenToBuffer( MACRO_TOKEN *first, char *gluebuf )
     return( buf );
 }
 
-static MACRO_TOKEN *ReTokenBuffer( const char *buffer )
-/******************************************************
+static void ReTokenBuffer( MTOK_BUF *mbuf, const char *buffer )
+/**************************************************************
  * retokenize starting at buffer
  */
 {
-    MACRO_TOKEN *head;
-    MACRO_TOKEN **ptail;
     bool        ppscan_mode;
 
     ppscan_mode = InitPPScan();
     ReScanInit( buffer );
-    head = NULL;
-    ptail = &head;
     for( CompFlags.rescan_buffer_done = false; !CompFlags.rescan_buffer_done; ) {
-        ptail = BuildATokenOnEnd( ptail, ReScanToken(), Buffer );
+        MTokAppend( mbuf, ReScanToken(), Buffer );
     }
     FiniPPScan( ppscan_mode );
-    return( head );
 }
 
 
-static MACRO_TOKEN *GlueTokens( MACRO_TOKEN *head )
-/*************************************************/
+static void GlueTokens( MTOK_BUF *mbuf, size_t start )
+/*****************************************************
+ * paste the tokens around ## from start to the end of mbuf, tokens are
+ * moved around by their offsets; pasted tokens are added at the end
+ */
 {
-    MACRO_TOKEN *mtok;
-    MACRO_TOKEN **ptail;
-    MACRO_TOKEN **prev_ptail;   // prior ptail
-    MACRO_TOKEN *next;
-    char        *buf;
+    size_t      *toks;
+    size_t      count;
+    size_t      max;
+    size_t      i;
+    size_t      prev;
+    bool        have_prev;
+    size_t      next;
+    size_t      last;
+    size_t      rest;
+    size_t      glued;
+    size_t      n;
     char        *gluebuf;
-
-    gluebuf = NULL;
-    prev_ptail = NULL;
-    ptail = &head;
-    mtok = *ptail;
-    buf = Buffer;
-    for( ; mtok != NULL; ) {
-        if( mtok->token != T_WHITE_SPACE ) {
-            next = mtok->next;
-            if( next == NULL )
-                break;
-            if( next->token == T_WHITE_SPACE )
-                next = next->next;
-            if( next == NULL )
+    TOKEN       tok;
+    MTOK_BUF    *out;
+
+    count = 0;
+    max = 0;
+    toks = NULL;
+    for( i = start; i < mbuf->end; i += MTokSize( mbuf->tokens + i ) ) {
+        if( count == max ) {
+            max += MTOK_BUF_SIZE;
+            toks = CMemRealloc( toks, max * sizeof( *toks ) );
+        }
+        toks[count++] = i;
+    }
+    prev = 0;
+    have_prev = false;
+    for( i = 0; i < count; ) {
+        tok = MTOK( mbuf->tokens + toks[i] );
+        if( tok != T_WHITE_SPACE ) {
+            next = i + 1;
+            if( next < count && MTOK( mbuf->tokens + toks[next] ) == T_WHITE_SPACE )
+                next++;
+            if( next == count )
                 break;
-            if( next->token == T_MACRO_SHARP_SHARP ) {  // let's paste
-                int         pos;
-                MACRO_TOKEN *rem;
-
-                next = next->next;
-                pos = 0;
+            if( MTOK( mbuf->tokens + toks[next] ) == T_MACRO_SHARP_SHARP ) {  // let's paste
                 /*
-                 * glue mtok->token with next->token to make one token
+                 * glue token i with the token after ## to make one token
                  */
-                if( ( mtok->token == T_COMMA && next->token == T_MACRO_EMPTY_VAR_PARM ) ||
-                    ( mtok->token == T_MACRO_EMPTY_VAR_PARM && next->token == T_COMMA ) )
-                {
-                    /*
-                     * delete [mtoken(a comma),##,empty __VA_ARGS__]
-                     * delete [empty __VA_ARGS__,##,mtoken(a comma)]
-                     */
-                    buf[10] = '\0';
-                    pos = -1;
-                } else {
-                    if( mtok->token == T_MACRO_EMPTY_VAR_PARM ) {
+                last = next++;
+                if( next < count ) {
+                    last = next;
+                    if( ( tok == T_COMMA && MTOK( mbuf->tokens + toks[next] ) == T_MACRO_EMPTY_VAR_PARM ) ||
+                        ( tok == T_MACRO_EMPTY_VAR_PARM && MTOK( mbuf->tokens + toks[next] ) == T_COMMA ) )
+                    {
                         /*
-                         * well should never be in this state if no next - since ## cannot
-                         * appear at the end of a macro
+                         * delete [mtoken(a comma),##,empty __VA_ARGS__]
+                         * delete [empty __VA_ARGS__,##,mtoken(a comma)]
                          */
-                        gluebuf = GlueTokenToBuffer( next, NULL );
-                    } else {
-                        gluebuf = GlueTokenToBuffer( mtok, NULL );
-                        if( next != NULL && next->token != T_MACRO_EMPTY_VAR_PARM ) {
-                            gluebuf = GlueTokenToBuffer( next, gluebuf ); //paste in next
-                        }
+                        memmove( toks + i, toks + last + 1, ( count - last - 1 ) * sizeof( *toks ) );
+                        count -= last + 1 - i;
+                        if( have_prev )
+                            i = prev;
+                        continue;
                     }
                 }
-                if( next != NULL ) {
-                    rem = next->next;   // save unseen stuff
-                    next->next = NULL;  // break link;
-                } else {
-                    rem = NULL;         // happens if no arg after comma
-                }
-                while( mtok != NULL ) { // free old stuff [mtoken,##,{atok,} next]
-                    next = mtok->next;
-                    CMemFree( mtok );
-                    mtok = next;
-                }
-                if( pos >= 0 ) {
-                    if( gluebuf != NULL ) {
-                        mtok = ReTokenBuffer( gluebuf );
-                        CMemFree( gluebuf );
-                    } else {
-                        /*
-                         * Both ends of ## were empty
-                         */
-                        mtok = BuildAToken( T_NULL, "P-<placemarker>" );
-                    }
-                    *ptail = mtok;  // link in new mtok to mtok's link
-                    while( mtok != NULL && mtok->next != NULL ) {   //position mtok & ptail to last token
-                        prev_ptail = ptail;
-                        ptail = &mtok->next;
-                        mtok = *ptail;
-                        if( mtok == mtok->next ) {
-                            return( head );
-                        }
-                    }
+                if( tok == T_MACRO_EMPTY_VAR_PARM ) {
                     /*
-                     * mtok == last token of retokenizing
-                     * ptail == the pointer which references mtok
+                     * well should never be in this state if no next - since ## cannot
+                     * appear at the end of a macro
                      */
-                    mtok->next = rem;
+                    gluebuf = NULL;
+                    if( next < count ) {
+                        gluebuf = GlueTokenToBuffer( mbuf->tokens + toks[next], NULL );
+                    }
                 } else {
-                    if( prev_ptail != NULL ) {
-                        *ptail = rem;
-                        ptail = prev_ptail;
-                        mtok = *ptail;
-                    } else {
-                        *ptail = rem;
-                        mtok = head;
+                    gluebuf = GlueTokenToBuffer( mbuf->tokens + toks[i], NULL );
+                    if( next < count && MTOK( mbuf->tokens + toks[next] ) != T_MACRO_EMPTY_VAR_PARM ) {
+                        gluebuf = GlueTokenToBuffer( mbuf->tokens + toks[next], gluebuf ); //paste in next
                     }
                 }
-                continue;          //ready to go
+                glued = mbuf->end;
+                if( gluebuf != NULL ) {
+                    ReTokenBuffer( mbuf, gluebuf );
+                    CMemFree( gluebuf );
+                } else {
+                    /*
+                     * Both ends of ## were empty
+                     */
+                    MTokAppend( mbuf, T_NULL, "P-<placemarker>" );
+                }
+                /*
+                 * the new tokens replace tokens i to last
+                 */
+                n = 0;
+                for( next = glued; next < mbuf->end; next += MTokSize( mbuf->tokens + next ) ) {
+                    n++;
+                }
+                rest = count - last - 1;
+                count = i + n + rest;
+                if( count > max ) {
+                    max = count + MTOK_BUF_SIZE;
+                    toks = CMemRealloc( toks, max * sizeof( *toks ) );
+                }
+                memmove( toks + i + n, toks + last + 1, rest * sizeof( *toks ) );
+                for( next = glued; next < mbuf->end; next += MTokSize( mbuf->tokens + next ) ) {
+                    toks[i++] = next;
+                }
+                /*
+                 * carry on with the last new token
+                 */
+                i--;
+                if( n > 1 ) {
+                    prev = i - 1;
+                    have_prev = true;
+                }
+                continue;
             }
         }
-        prev_ptail = ptail;
-        ptail = &mtok->next;
-        mtok = *ptail;
+        prev = i++;
+        have_prev = true;
     }
-    return( head );
+    /*
+     * put the tokens back in their new order
+     */
+    out = GetMTokBuf();
+    for( i = 0; i < count; i++ ) {
+        MTokAppendMem( out, mbuf->tokens + toks[i], MTokSize( mbuf->tokens + toks[i] ) );
+    }
+    mbuf->end = start;
+    MTokAppendMem( mbuf, out->tokens, out->end );
+    FreeMTokBuf( out );
+    CMemFree( toks );
 }
 
-static MACRO_TOKEN *BuildString( const char *p )
-/**********************************************/
+static void BuildString( MTOK_BUF *mbuf, const char *p )
+/******************************************************/
 {
-    MACRO_TOKEN     *head;
-    MACRO_TOKEN     **ptail;
     char            c;
     TOKEN           tok;
 
-    head = NULL;
     if( p != NULL ) {
-        ptail = &head;
         TokenLen = 0;
         while( MTOK( p ) == T_WHITE_SPACE ) {
             MTOKINC( p );   //eat leading white space
@@ -1004,35 +1144,63 @@ static MACRO_TOKEN *BuildString( const char *p )
         }
         if( TokenLen > 0 ) {
             WriteBufferNullChar();
-            ptail = BuildATokenOnEnd( ptail, T_STRING, Buffer );
+            MTokAppend( mbuf, T_STRING, Buffer );
         }
     }
-    return( head );
 }
 
 
-static MACRO_TOKEN *BuildMTokenList( const char *p, MACRO_ARG *macro_parms )
-/**************************************************************************/
+static void BuildMTokenList( MTOK_BUF *mbuf, const char *p, MACRO_ARG *macro_parms );
+
+static void ExpandMacroParm( MTOK_BUF *mbuf, MACRO_ARG *parm )
+/*************************************************************
+ * an argument is macro replaced only once per invocation, however often
+ * its parameter appears in the replacement list; later uses copy the
+ * tokens of the first one
+ */
+{
+    MTOK_BUF        *in;
+    size_t          start;
+
+    if( parm->expanded_done ) {
+        MTokAppendCopy( mbuf, parm->expanded_beg, parm->expanded_end );
+    } else {
+        start = mbuf->end;
+        in = GetMTokBuf();
+        BuildMTokenList( in, parm->arg, NULL );
+        ExpandNestedMacros( mbuf, in, false );
+        FreeMTokBuf( in );
+        parm->expanded_beg = start;
+        parm->expanded_end = mbuf->end;
+        parm->expanded_done = true;
+    }
+}
+
+static void BuildMTokenList( MTOK_BUF *mbuf, const char *p, MACRO_ARG *macro_parms )
+/**********************************************************************************
+ * append the tokens of a replacement list or of an argument to mbuf
+ */
 {
-    MACRO_TOKEN     *mtok;
-    MACRO_TOKEN     *head;
-    MACRO_TOKEN     **ptail;
     NESTED_MACRO    *nested;
     const char      *p2;
     char            buf[2];
     TOKEN           prev_token;
     TOKEN           tok;
     mac_parm_count  parmno;
+    size_t          start;
+    size_t          piece;
+    bool            glue;
 
-    head = NULL;
-    ptail = &head;
     nested = NestedMacros;
     buf[1] = '\0';
     prev_token = T_NULL;
     if( p == NULL )
-        return( NULL );
+        return;
+    start = mbuf->end;
+    glue = false;
     while( (tok = MTOK( p )) != T_NULL ) {
         MTOKINC( p );
+        piece = mbuf->end;
         switch( tok ) {
         case T_CONSTANT:
         case T_PPNUMBER:
@@ -1041,18 +1209,18 @@ static MACRO_TOKEN *BuildMTokenList( const char *p, MACRO_ARG *macro_parms )
         case T_BAD_TOKEN:
         case T_LSTRING:
         case T_STRING:
-            mtok = BuildAToken( tok, p );
+            MTokAppend( mbuf, tok, p );
             while( *p++ != '\0' )
                 ;
             break;
         case T_WHITE_SPACE:
             if( prev_token == T_MACRO_SHARP_SHARP )
                 continue;
-            mtok = BuildAToken( T_WHITE_SPACE, " " );
+            MTokAppend( mbuf, T_WHITE_SPACE, " " );
             break;
         case T_BAD_CHAR:
             buf[0] = *p++;
-            mtok = BuildAToken( T_BAD_CHAR, buf );
+            MTokAppend( mbuf, T_BAD_CHAR, buf );
             break;
         case T_MACRO_SHARP:
             while( MTOK( p ) == T_WHITE_SPACE ) {
@@ -1065,9 +1233,9 @@ static MACRO_TOKEN *BuildMTokenList( const char *p, MACRO_ARG *macro_parms )
             parmno = MTOKPARM( p );
             MTOKPARMINC( p );
             if( macro_parms != NULL && macro_parms[parmno].arg != NULL && macro_parms[parmno].arg[0] != '\0' ) {
-                mtok = BuildString( macro_parms[parmno].arg );
+                BuildString( mbuf, macro_parms[parmno].arg );
             } else {
-                mtok = BuildAToken( T_STRING, "" );
+                MTokAppend( mbuf, T_STRING, "" );
             }
             break;
         case T_MACRO_PARM:
@@ -1078,21 +1246,21 @@ static MACRO_TOKEN *BuildMTokenList( const char *p, MACRO_ARG *macro_parms )
                 MTOKINC( p2 );
             }
             nested->substituting_parms = true;
-            if( macro_parms != NULL ) {
-                mtok = BuildMTokenList( macro_parms[parmno].arg, NULL );
-                /*
-                 * NB: mtok is now NULL if macro arg was empty
-                 */
-            } else {
-                mtok = BuildAToken( T_WHITE_SPACE, "" );
-            }
             if( MTOK( p2 ) != T_MACRO_SHARP_SHARP && prev_token != T_MACRO_SHARP_SHARP ) {
-                if( mtok != NULL ) {
-                    mtok = AppendToken( mtok, T_NULL, "P-<end of parm>" );
-                    mtok = ExpandNestedMacros( mtok, false );
+                if( macro_parms != NULL ) {
+                    ExpandMacroParm( mbuf, &macro_parms[parmno] );
+                } else {
+                    MTokAppend( mbuf, T_WHITE_SPACE, "" );
+                }
+            } else {
+                if( macro_parms != NULL ) {
+                    BuildMTokenList( mbuf, macro_parms[parmno].arg, NULL );
+                } else {
+                    MTokAppend( mbuf, T_WHITE_SPACE, "" );
+                }
+                if( mbuf->end == piece ) {
+                    MTokAppend( mbuf, T_NULL, "P-<placemarker>" );
                 }
-            } else if( mtok == NULL ) {
-                mtok = BuildAToken( T_NULL, "P-<placemarker>" );
             }
             nested->substituting_parms = false;
             break;
@@ -1103,61 +1271,60 @@ static MACRO_TOKEN *BuildMTokenList( const char *p, MACRO_ARG *macro_parms )
             while( MTOK( p2 ) == T_WHITE_SPACE )
                 MTOKINC( p2 );
             nested->substituting_parms = true;
-            if( macro_parms != NULL ) {
-                if( macro_parms[parmno].arg != NULL ) {
-                    mtok = BuildMTokenList( macro_parms[parmno].arg, NULL );
+            if( MTOK( p2 ) != T_MACRO_SHARP_SHARP && prev_token != T_MACRO_SHARP_SHARP ) {
+                if( macro_parms != NULL && macro_parms[parmno].arg != NULL ) {
+                    ExpandMacroParm( mbuf, &macro_parms[parmno] );
                 } else {
-                    if( prev_token == T_MACRO_SHARP_SHARP || MTOK( p2 ) == T_MACRO_SHARP_SHARP ) {
-                        mtok = BuildAToken( T_MACRO_EMPTY_VAR_PARM, "" );
-                    } else {
-                        mtok = BuildAToken( T_WHITE_SPACE, "" );
-                    }
+                    MTokAppend( mbuf, T_WHITE_SPACE, "" );
                 }
             } else {
-                mtok = BuildAToken( T_WHITE_SPACE, "" );
-            }
-            if( MTOK( p2 ) != T_MACRO_SHARP_SHARP && prev_token != T_MACRO_SHARP_SHARP ) {
-                if( mtok != NULL ) {
-                    mtok = AppendToken( mtok, T_NULL, "P-<end of parm>" );
-                    mtok = ExpandNestedMacros( mtok, false );
+                if( macro_parms == NULL ) {
+                    MTokAppend( mbuf, T_WHITE_SPACE, "" );
+                } else if( macro_parms[parmno].arg != NULL ) {
+                    BuildMTokenList( mbuf, macro_parms[parmno].arg, NULL );
+                } else {
+                    MTokAppend( mbuf, T_MACRO_EMPTY_VAR_PARM, "" );
                 }
             }
             nested->substituting_parms = false;
             break;
+        case T_MACRO_SHARP_SHARP:
+            glue = true;
+            /* fall through */
         default:
-            mtok = BuildAToken( tok, Tokens[tok] );
+            MTokAppend( mbuf, tok, Tokens[tok] );
             break;
         }
-        if( mtok != NULL ) {
-            if( mtok->token != T_WHITE_SPACE ) {
-                prev_token = mtok->token;
-            }
-            *ptail = mtok;
-            while( *ptail != NULL ) {
-                ptail = &(*ptail)->next;
+        if( mbuf->end != piece ) {
+            tok = MTOK( mbuf->tokens + piece );
+            if( tok != T_WHITE_SPACE ) {
+                prev_token = tok;
             }
         }
     }
-    head = GlueTokens( head );
-    return( head );
+    if( glue ) {
+        GlueTokens( mbuf, start );
+    }
 }
 
-static void markUnexpandableIds( MACRO_TOKEN *head )
-/**************************************************/
+static void markUnexpandableIds( MTOK_BUF *mbuf )
+/***********************************************/
 {
     NESTED_MACRO    *nested;
-    MACRO_TOKEN     *mtok;
+    char            *p;
+    size_t          i;
 
-    for( mtok = head; mtok != NULL; mtok = mtok->next ) {
-        if( mtok->token == T_ID ) {
+    for( i = mbuf->beg; i < mbuf->end; i += MTokSize( p ) ) {
+        p = mbuf->tokens + i;
+        if( MTOK( p ) == T_ID ) {
             for( nested = NestedMacros; nested != NULL; nested = nested->next ) {
-                if( strcmp( nested->mentry->macro_name, mtok->data ) == 0 ) {
+                if( strcmp( nested->mentry->macro_name, MTOK_DATA( p ) ) == 0 ) {
                     if( !nested->substituting_parms ) {
                         /*
                          * change token so it won't be considered a
                          * candidate as a macro
                          */
-                        mtok->token = T_UNEXPANDABLE_ID;
+                        MTOK( p ) = T_UNEXPANDABLE_ID;
                         break;
                     }
                 }
@@ -1166,11 +1333,11 @@ static void markUnexpandableIds( MACRO_TOKEN *head )
     }
 }
 
-static MACRO_TOKEN *MacroExpansion( bool rescanning, MEPTR mentry )
-/*****************************************************************/
+static MTOK_BUF *MacroExpansion( bool rescanning, MEPTR mentry )
+/**************************************************************/
 {
     MACRO_ARG       *macro_parms;
-    MACRO_TOKEN     *head;
+    MTOK_BUF        *mbuf;
     NESTED_MACRO    *nested;
 
     nested = (NESTED_MACRO *)CMemAlloc( sizeof( NESTED_MACRO ) );
@@ -1179,7 +1346,8 @@ static MACRO_TOKEN *MacroExpansion( bool rescanning, MEPTR mentry )
     nested->substituting_parms = false;
     nested->macro_parms = NULL;
     if( MacroIsSpecial( mentry ) ) {    /* if special macro */
-        head = BuildAToken( SpecialMacro( mentry ), Buffer );
+        mbuf = GetMTokBuf();
+        MTokAppend( mbuf, SpecialMacro( mentry ), Buffer );
         nested->next = NestedMacros;
         NestedMacros = nested;
     } else {
@@ -1187,38 +1355,40 @@ static MACRO_TOKEN *MacroExpansion( bool rescanning, MEPTR mentry )
         nested->next = NestedMacros;
         NestedMacros = nested;
         nested->macro_parms = macro_parms;
-        head = BuildMTokenList( (char *)mentry + mentry->macro_defn, macro_parms );
-        markUnexpandableIds( head );
+        mbuf = GetMTokBuf();
+        BuildMTokenList( mbuf, (char *)mentry + mentry->macro_defn, macro_parms );
+        markUnexpandableIds( mbuf );
     }
-    head = AppendToken( head, T_NULL, MACRO_END_STRING );
-    return( head );
+    MTokAppend( mbuf, T_NULL, MACRO_END_STRING );
+    return( mbuf );
 }
 
-static MACRO_TOKEN *ExpandNestedMacros( MACRO_TOKEN *head, bool rescanning )
-/**************************************************************************/
+static void ExpandNestedMacros( MTOK_BUF *out, MTOK_BUF *in, bool rescanning )
+/*****************************************************************************
+ * macro replace the tokens of in, appending the result to out; in is
+ * TokenList when rescanning
+ */
 {
-    MACRO_TOKEN *mtok;
-    MACRO_TOKEN *toklist;
-    MACRO_TOKEN *prev_tok;
-    MACRO_TOKEN *old_tokenlist;
-    exp_state   i;
+    char        *p;
+    MTOK_BUF    *old_tokenlist;
+    MTOK_BUF    *toklist;
+    MTOK_BUF    *result;
+    size_t      start;
     size_t      len;
     char        *buf;
     MEPTR       mentry;
 
-    mtok = head;
+    start = out->end;
     ++MacroDepth;
-    prev_tok = NULL;
-    for( ; mtok != NULL; ) {
-        toklist = NULL;
-        if( mtok->token == T_ID ) {
+    while( (p = MTokFirst( in )) != NULL ) {
+        if( MTOK( p ) == T_ID ) {
             /*
              * if macro and not being expanded, then expand it
-             * only tokens available for expansion are those in mtok list
+             * only tokens available for expansion are those in the in buffer
              */
             buf = Buffer;
             len = 0;
-            while( (buf[len] = mtok->data[len]) != '\0' )
+            while( (buf[len] = MTOK_DATA( p )[len]) != '\0' )
                 len++;
             mentry = MacroLookup( buf );
             if( mentry != NULL ) {
@@ -1227,137 +1397,97 @@ static MACRO_TOKEN *ExpandNestedMacros( MACRO_TOKEN *head, bool rescanning )
                  */
                 if( rescanning ) {
                     if( MacroBeingExpanded( mentry ) ) {
-                        mtok->token = T_UNEXPANDABLE_ID;
+                        MTOK( p ) = T_UNEXPANDABLE_ID;
+                        MTokMove( out, in );
                     } else {
-                        toklist = mtok;
-                        while( toklist->next != NULL ) {
-                            toklist = toklist->next;
-                        }
-                        toklist->next = TokenList;
-                        i = isExpandable( mentry, mtok->next, false );
-                        switch( i ) {
+                        switch( isExpandable( mentry, in, false ) ) {
                         case EXPANDABLE_NO:     // macro is currently not expandable
-                            mtok->token = T_MACRO;
-                            toklist->next = NULL;
-                            toklist = NULL;
+                            MTOK( p ) = T_MACRO;
+                            MTokMove( out, in );
                             break;
                         case EXPANDABLE_YES:    // macro is expandable
-                            TokenList = mtok->next;
-                            if( head == mtok ) {
-                                head = NULL;
-                                prev_tok = NULL;
-                            }
-                            CMemFree( mtok );
+                            MTokSkip( in );
                             toklist = MacroExpansion( rescanning, mentry );
-                            mtok = TokenList;
-                            TokenList = NULL;
+                            MTokPrepend( in, toklist );
+                            FreeMTokBuf( toklist );
                             break;
                         case EXPANDABLE_WSSKIP: // we skipped over some white space
-                            mtok->token = T_UNEXPANDABLE_ID;
-                            toklist->next = NULL;
-                            toklist = BuildAToken( T_WHITE_SPACE, " " );
-                            toklist->next = mtok->next;
-                            mtok->next = toklist;
-                            toklist = NULL;
+                            MTOK( p ) = T_UNEXPANDABLE_ID;
+                            MTokMove( out, in );
+                            MTokAppend( out, T_WHITE_SPACE, " " );
                             break;
                         }
                     }
                 } else {                        // expanding a macro parm
-                    i = isExpandable( mentry, mtok->next, true );
-                    switch( i ) {
+                    switch( isExpandable( mentry, in, true ) ) {
                     case EXPANDABLE_NO:         // macro is currently not expandable
-                        prev_tok = mtok;
-                        mtok = mtok->next;      // advance onto next token
+                        MTokMove( out, in );
                         break;
                     case EXPANDABLE_YES:        // macro is expandable
                     case EXPANDABLE_WSSKIP:     // we skipped over some white space
+                        MTokSkip( in );
                         old_tokenlist = TokenList;
-                        TokenList = mtok->next;
-                        if( head == mtok ) {
-                            head = NULL;
-                            prev_tok = NULL;
-                        }
-                        CMemFree( mtok );
-                        toklist = ExpandNestedMacros( MacroExpansion( false, mentry ), rescanning );
-                        mtok = TokenList;
+                        TokenList = in;
+                        toklist = MacroExpansion( false, mentry );
                         TokenList = old_tokenlist;
+                        result = GetMTokBuf();
+                        ExpandNestedMacros( result, toklist, rescanning );
+                        FreeMTokBuf( toklist );
+                        MTokPrepend( in, result );
+                        FreeMTokBuf( result );
                         break;
                     }
                 }
             } else {
-                mtok->token = T_SAVED_ID;       // avoid rechecking this ID
-                prev_tok = mtok;
-                mtok = mtok->next;              // advance onto next token
+                MTOK( p ) = T_SAVED_ID;         // avoid rechecking this ID
+                MTokMove( out, in );
             }
-        } else if( mtok->token == T_NULL ) {
-            toklist = mtok->next;
-            if( mtok->data[0] == MACRO_END_CHAR ) { // end of a macro
+        } else if( MTOK( p ) == T_NULL ) {
+            if( *MTOK_DATA( p ) == MACRO_END_CHAR ) {   // end of a macro
                 rescanning = NestedMacros->rescanning;
                 DeleteNestedMacro();
-                CMemFree( mtok );
-                mtok = toklist;
-            } else {                            // end of a macro parm
-                if( toklist != NULL ) {
-                    TokenList = toklist;
-                }
-                CMemFree( mtok );
-                mtok = NULL;                    // will cause us to exit
-            }
-            toklist = NULL;
-        } else {                                // advance onto next token
-            prev_tok = mtok;
-            mtok = mtok->next;
-        }
-        if( toklist != NULL ) {                 // new tokens to insert
-            if( prev_tok == NULL ) {
-                head = toklist;
-            } else {
-                prev_tok->next = toklist;
-            }
-            if( mtok != NULL ) {
-                while( toklist->next != NULL )
-                    toklist = toklist->next;
-                toklist->next = mtok;
-            }
-            if( prev_tok == NULL ) {
-                mtok = head;
-            } else {
-                mtok = prev_tok->next;
             }
+            MTokSkip( in );                     // or a placemarker left by ##
         } else {
-            /*
-             * either no change, or tokens were deleted
-             */
-            if( prev_tok == NULL ) {
-                head = mtok;
-            } else {
-                prev_tok->next = mtok;
-            }
+            MTokMove( out, in );
         }
     }
-    for( mtok = head; mtok != NULL; mtok = mtok->next ) {
+    for( ; start < out->end; start += MTokSize( p ) ) {
+        p = out->tokens + start;
         /*
          * change a temporarily unexpandable ID into an ID because it
          * could become expandable in a later rescanning phase
          */
-        if( mtok->token == T_MACRO ) {
-            mtok->token = T_ID;
+        if( MTOK( p ) == T_MACRO ) {
+            MTOK( p ) = T_ID;
         }
     }
     --MacroDepth;
-    return( head );
 }
 
 void DoMacroExpansion( MEPTR mentry )               // called from cscan
 /***********************************/
 {
+    MTOK_BUF    *toklist;
+
     MacroDepth = 0;
-    TokenList = ExpandNestedMacros( MacroExpansion( false, mentry ), true );
+    toklist = MacroExpansion( false, mentry );
+    if( MTokFirst( TokenList ) == NULL ) {
+        FreeMTokBuf( TokenList );
+        TokenList = toklist;
+    } else {
+        MTokPrepend( TokenList, toklist );
+        FreeMTokBuf( toklist );
+    }
+    toklist = GetMTokBuf();
+    ExpandNestedMacros( toklist, TokenList, true );
+    FreeMTokBuf( TokenList );
+    TokenList = toklist;
     /*
      * GetMacroToken will feed back tokens from the TokenList
      * when the TokenList is exhausted, then revert back to normal scanning
      */
-    if( TokenList == NULL ) {
+    if( MTokFirst( TokenList ) == NULL ) {
         MacroPtr = NULL;
     } else {
         MacroPtr = "";
@@ -1368,33 +1498,26 @@ void DoMacroExpansion( MEPTR mentry )               // called from cscan
 void InsertReScanPragmaTokens( const char *pragma )
 /*************************************************/
 {
-    MACRO_TOKEN *toklist;
-
-    toklist = ReTokenBuffer( pragma );
-    if( toklist != NULL ) {
-        MACRO_TOKEN *old_list;
+    MTOK_BUF    *toklist;
 
-        old_list = TokenList;
-        TokenList = toklist;
-        while( toklist->next != NULL ) {
-            toklist = toklist->next;
-        }
-        toklist->next = BuildAToken( T_PRAGMA_END, "" );
-        toklist = toklist->next;
-        toklist->next = old_list;
+    toklist = GetMTokBuf();
+    ReTokenBuffer( toklist, pragma );
+    if( MTokFirst( toklist ) != NULL ) {
+        MTokAppend( toklist, T_PRAGMA_END, "" );
+        MTokPrepend( TokenList, toklist );
         MacroPtr = "";
     }
+    FreeMTokBuf( toklist );
 }
 
 void InsertToken( TOKEN token, const char *str )
 /**********************************************/
 {
-    MACRO_TOKEN *toklist;
+    MTOK_BUF    *toklist;
 
-    toklist = BuildAToken( token, str );
-    if( toklist != NULL ) {
-        toklist->next = TokenList;
-        TokenList = toklist;
-        MacroPtr = "";
-    }
+    toklist = GetMTokBuf();
+    MTokAppend( toklist, token, str );
+    MTokPrepend( TokenList, toklist );
+    FreeMTokBuf( toklist );
+    MacroPtr = "";
 }
@@ -719,7 +719,7 @@ bool MacroDel( const char *name )
         CErr2p( ERR_CANT_UNDEF_THESE_NAMES, name  );
         return( ret );
     }
-    hash = CalcHashMacro( name );
+    hash = HASH_BUCKET( CalcHashMacro( name ), MacHashSize );
     prev_mentry = NULL;
     for( mentry = MacHash[hash]; mentry != NULL; mentry = mentry->next_macro ) {
         if( strcmp( mentry->macro_name, name ) == 0 )
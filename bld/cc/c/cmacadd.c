@@ -116,12 +116,48 @@ static void MacroReallocOverflow( size_t amount_needed, size_t amount_used )
     }
 }
 
+void MacroHashResize( unsigned size )
+/***********************************
+ * rehash the macro table into size buckets, keeping
+ * the order of the entries within each bucket
+ */
+{
+    MEPTR       *old_hash;
+    unsigned    old_size;
+    MEPTR       **tails;
+    MEPTR       mentry;
+    MEPTR       next_mentry;
+    unsigned    bucket;
+    unsigned    i;
+
+    old_hash = MacHash;
+    old_size = MacHashSize;
+    MacHash = CMemAlloc( size * sizeof( MEPTR ) );
+    MacHashSize = size;
+    tails = CMemAlloc( size * sizeof( MEPTR * ) );
+    for( i = 0; i < size; i++ ) {
+        MacHash[i] = NULL;
+        tails[i] = &MacHash[i];
+    }
+    for( i = 0; i < old_size; i++ ) {
+        for( mentry = old_hash[i]; mentry != NULL; mentry = next_mentry ) {
+            next_mentry = mentry->next_macro;
+            mentry->next_macro = NULL;
+            bucket = HASH_BUCKET( CalcHashMacro( mentry->macro_name ), size );
+            *tails[bucket] = mentry;
+            tails[bucket] = &mentry->next_macro;
+        }
+    }
+    CMemFree( tails );
+    CMemFree( old_hash );
+}
+
 static MEPTR *MacroLkUp( mac_hash_idx hash, const char *name )
 {
     MEPTR       mentry;
     MEPTR       *lnk;
 
-    for( lnk = &MacHash[hash]; (mentry = *lnk) != NULL; lnk = &mentry->next_macro ) {
+    for( lnk = &MacHash[HASH_BUCKET( hash, MacHashSize )]; (mentry = *lnk) != NULL; lnk = &mentry->next_macro ) {
         if( strcmp( mentry->macro_name, name ) == 0 ) {
             break;
         }
@@ -167,8 +203,14 @@ MEPTR MacroDefine( size_t mlen, macro_flags mflags )
         ++MacroCount;
         new_mentry = MacroAllocateInSeg( mlen );
         new_mentry->macro_flags = InitialMacroFlags | mflags;
-        new_mentry->next_macro = MacHash[hash];
-        MacHash[hash] = new_mentry;
+        /*
+         * MacroCount is not decremented by #undef, so this errs on the side of growing
+         */
+        if( MacroCount > 2 * MacHashSize && MacHashSize < MACRO_HASH_SIZE_MAX ) {
+            MacroHashResize( 2 * MacHashSize );
+        }
+        new_mentry->next_macro = MacHash[HASH_BUCKET( hash, MacHashSize )];
+        MacHash[HASH_BUCKET( hash, MacHashSize )] = new_mentry;
     }
     return( new_mentry );
 }
@@ -117,10 +117,18 @@ static  mem_blk     *Blks;
 static void InitPermArea( void )
 /******************************/
 {
-    Blks = NULL;
-    PermAvail = 0;
-    PermPtr = NULL;
-    PermSize = 0;
+    /*
+     * start with the block kept by the previous run, if any
+     */
+    if( Blks != NULL ) {
+        PermPtr = (char *)Blks + sizeof( mem_blk );
+        PermSize = Blks->size;
+        PermAvail = PermSize;
+    } else {
+        PermAvail = 0;
+        PermPtr = NULL;
+        PermSize = 0;
+    }
 }
 
 static void FiniPermArea( void )
@@ -131,6 +139,13 @@ static void FiniPermArea( void )
 
     for( curr = Blks; curr != NULL; curr = next ) {
         next = curr->next;
+        if( next == NULL && GlobalCompFlags.cc_reuse ) {
+            /*
+             * a reused compiler keeps its first block for the next run
+             */
+            Blks = curr;
+            return;
+        }
         free( curr );
     }
     Blks = NULL;
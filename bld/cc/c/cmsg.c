@@ -107,6 +107,7 @@ void FiniMsg( void )
 {
     if( internationalData != NULL ) {
         FreeInternationalData( internationalData );
+        internationalData = NULL;
     }
 }
 
@@ -145,31 +145,17 @@ static void reScanGetNextCharUndo( int c )
     CompFlags.rescan_buffer_done = false;
 }
 
-unsigned hashpjw( const char *s )
-/*******************************/
+unsigned CalcHash( const char *s )
+/*********************************
+ * FNV-1a; the hash tables are indexed by the low bits of the value
+ */
 {
     unsigned        h;
     unsigned char   c;
 
-    h = *(const unsigned char *)s++;
-    if( h != 0 ) {
-        c = *s++;
-        if( c != '\0' ) {
-            h = ( h << 4 ) + c;
-            for( ;; ) {
-                h &= 0x0fff;
-                c = *s++;
-                if( c == '\0' )
-                    break;
-                h = ( h << 4 ) + c;
-                h = ( h ^ (h >> 12) ) & 0x0fff;
-                c = *s++;
-                if( c == '\0' )
-                    break;
-                h = ( h << 4 ) + c;
-                h = h ^ (h >> 12);
-            }
-        }
+    h = 0x811c9dc5U;
+    while( (c = *(const unsigned char *)s++) != '\0' ) {
+        h = ( h ^ c ) * 0x01000193U;
     }
     return( h );
 }
@@ -177,27 +163,13 @@ unsigned hashpjw( const char *s )
 id_hash_idx CalcHashID( const char *id )
 /**************************************/
 {
-    unsigned    hash;
-
-    hash = hashpjw( id );
-    return( (id_hash_idx)( hash % ID_HASH_SIZE ) );
+    return( (id_hash_idx)CalcHash( id ) );
 }
 
 mac_hash_idx CalcHashMacro( const char *id )
 /******************************************/
 {
-    unsigned    hash;
-
-    hash = hashpjw( id );
-#if ( MACRO_HASH_SIZE > 0x0ff0 ) && ( MACRO_HASH_SIZE < 0x0fff )
-    hash &= 0x0fff;
-    if( hash >= MACRO_HASH_SIZE ) {
-        hash -= MACRO_HASH_SIZE;
-    }
-#else
-    hash = hash % MACRO_HASH_SIZE;
-#endif
-    return( (mac_hash_idx)hash );
+    return( (mac_hash_idx)CalcHash( id ) );
 }
 
 TOKEN KwLookup( const char *buf, size_t len )
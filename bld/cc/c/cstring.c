@@ -44,6 +44,7 @@
 
 
 static target_size  CLitLength;         /* length of string literal */
+static unsigned     StringHashCount;    /* # of literals in StringHash */
 
 static FILE *OpenUnicodeFile( const char *filename )
 {
@@ -107,8 +108,11 @@ void StringInit( void )
 {
     str_hash_idx    hash;
 
-    for( hash = 0; hash < STRING_HASH_SIZE; hash++ ) {
-        StringHash[hash] = 0;
+    StringHashCount = 0;
+    StringHashSize = STRING_HASH_SIZE;
+    StringHash = CMemAlloc( StringHashSize * sizeof( STR_HANDLE ) );
+    for( hash = 0; hash < StringHashSize; hash++ ) {
+        StringHash[hash] = NULL;
     }
 }
 
@@ -275,7 +279,39 @@ static TYPEPTR StringLeafType( void )
 
 static str_hash_idx CalcStringHash( STR_HANDLE lit )
 {
-    return( (str_hash_idx)( hashpjw( lit->literal ) % STRING_HASH_SIZE ) );
+    return( (str_hash_idx)HASH_BUCKET( CalcHash( lit->literal ), StringHashSize ) );
+}
+
+static void StringHashGrow( void )
+/*********************************
+ * double the literal table when it averages more than two entries per bucket
+ */
+{
+    STR_HANDLE      *old_hash;
+    unsigned        old_size;
+    STR_HANDLE      strlit;
+    STR_HANDLE      strlit_next;
+    str_hash_idx    hash;
+    unsigned        i;
+
+    if( ++StringHashCount <= 2 * StringHashSize || StringHashSize >= STRING_HASH_SIZE_MAX )
+        return;
+    old_hash = StringHash;
+    old_size = StringHashSize;
+    StringHashSize = 2 * old_size;
+    StringHash = CMemAlloc( StringHashSize * sizeof( STR_HANDLE ) );
+    for( i = 0; i < StringHashSize; i++ ) {
+        StringHash[i] = NULL;
+    }
+    for( i = 0; i < old_size; i++ ) {
+        for( strlit = old_hash[i]; strlit != NULL; strlit = strlit_next ) {
+            strlit_next = strlit->next_string;
+            hash = CalcStringHash( strlit );
+            strlit->next_string = StringHash[hash];
+            StringHash[hash] = strlit;
+        }
+    }
+    CMemFree( old_hash );
 }
 
 TREEPTR StringLeaf( string_flags flags )
@@ -316,6 +352,8 @@ TREEPTR StringLeaf( string_flags flags )
         new_lit->flags = flags;
         ++LitCount;
         LitPoolSize += CLitLength;
+        StringHashGrow();
+        hash = CalcStringHash( new_lit );
         new_lit->next_string = StringHash[hash];
         StringHash[hash] = new_lit;
     } else {            // we found a duplicate
@@ -63,6 +63,7 @@ static char         *SymBufPtr;
 static unsigned     NextSymHandle;
 static SEGADDR_T    SymBufSegment;              /* segment # for symbol table buffers */
 static seg_info     SymBufSegs[MAX_SYM_SEGS];   /* segments for symbols */
+static SYM_HASHPTR  SymLevelList[ID_LEVEL_COUNT];   /* symbols of each level, newest first */
 
 static SEGADDR_T AllocSegment( seg_info *si )
 {
@@ -96,16 +97,22 @@ void SymInit( void )
 {
     id_hash_idx     hash;
     unsigned        seg_num;
+    unsigned        level;
 
     NextSymHandle = 0;
     Cached_sym_num = ~0u;
     SymLevel = 0;
     GblSymCount = 0;
     LclSymCount = 0;
-    HashTab = PermMemAlloc( ID_HASH_SIZE * sizeof( SYM_HASHPTR ) );
-    for( hash = 0; hash < ID_HASH_SIZE; hash++ ) {
+    SymHashCount = 0;
+    SymHashSize = ID_HASH_SIZE;
+    HashTab = CMemAlloc( SymHashSize * sizeof( SYM_HASHPTR ) );
+    for( hash = 0; hash < SymHashSize; hash++ ) {
         HashTab[hash] = NULL;
     }
+    for( level = 0; level < ID_LEVEL_COUNT; level++ ) {
+        SymLevelList[level] = NULL;
+    }
     TagHead = NULL;
     DeadTags = NULL;
     LabelHead = NULL;
@@ -401,6 +408,58 @@ void SymReplace( SYMPTR sym, SYM_HANDLE sym_handle )
 }
 
 
+void SymHashResize( unsigned size )
+/*********************************
+ * rehash the symbol table into size buckets; the entries of a bucket
+ * stay in the same order, so they remain sorted by level
+ */
+{
+    SYM_HASHPTR     *old_hash;
+    unsigned        old_size;
+    SYM_HASHPTR     **tails;
+    SYM_HASHPTR     hsym;
+    SYM_HASHPTR     next_hsym;
+    unsigned        bucket;
+    unsigned        i;
+
+    old_hash = HashTab;
+    old_size = SymHashSize;
+    HashTab = CMemAlloc( size * sizeof( SYM_HASHPTR ) );
+    SymHashSize = size;
+    tails = CMemAlloc( size * sizeof( SYM_HASHPTR * ) );
+    for( i = 0; i < size; i++ ) {
+        HashTab[i] = NULL;
+        tails[i] = &HashTab[i];
+    }
+    for( i = 0; i < old_size; i++ ) {
+        for( hsym = old_hash[i]; hsym != NULL; hsym = next_hsym ) {
+            next_hsym = hsym->next_sym;
+            hsym->next_sym = NULL;
+            bucket = HASH_BUCKET( hsym->hash, size );
+            *tails[bucket] = hsym;
+            tails[bucket] = &hsym->next_sym;
+        }
+    }
+    CMemFree( tails );
+    CMemFree( old_hash );
+}
+
+void SymAddLevel( SYM_HASHPTR hsym )
+/***********************************
+ * add symbol to the list of its level, which GetSymList empties
+ */
+{
+    hsym->next_level = SymLevelList[hsym->level];
+    SymLevelList[hsym->level] = hsym;
+}
+
+static void SymHashGrow( void )
+{
+    if( ++SymHashCount > 2 * SymHashSize && SymHashSize < ID_HASH_SIZE_MAX ) {
+        SymHashResize( 2 * SymHashSize );
+    }
+}
+
 static SYM_HASHPTR SymHash( SYMPTR sym, SYM_HANDLE sym_handle )
 {
     SYM_HASHPTR     hsym;
@@ -439,11 +498,14 @@ SYM_HANDLE SymAdd( id_hash_idx hash, SYMPTR sym )
     NewSym();
     sym->level = (id_level_type)SymLevel;
     hsym = SymHash( sym, CURR_SYM_HANDLE() );
+    hsym->hash = hash;
     sym->info.hash = hash;
+    SymHashGrow();
+    SymAddLevel( hsym );
     /*
      * add name to head of list
      */
-    for( head = &HashTab[hash]; *head != NULL; head = &(*head)->next_sym ) {
+    for( head = &HashTab[HASH_BUCKET( hash, SymHashSize )]; *head != NULL; head = &(*head)->next_sym ) {
         if( ChkLtSymLevel( *head ) || ChkEqSymLevel( *head ) ) {
             break;
         }
@@ -469,10 +531,13 @@ SYM_HANDLE SymAddL0( id_hash_idx hash, SYMPTR new_sym )
     new_sym->level = 0;
     new_hsym = SymHash( new_sym, CURR_SYM_HANDLE() );
     new_hsym->next_sym = NULL;
+    new_hsym->hash = hash;
     new_sym->info.hash = hash;
-    hsym = HashTab[hash];
+    SymHashGrow();
+    SymAddLevel( new_hsym );
+    hsym = HashTab[HASH_BUCKET( hash, SymHashSize )];
     if( hsym == NULL ) {
-        HashTab[hash] = new_hsym;
+        HashTab[HASH_BUCKET( hash, SymHashSize )] = new_hsym;
     } else {
         while( hsym->next_sym != NULL ) {
             hsym = hsym->next_sym;
@@ -518,7 +583,7 @@ SYM_HANDLE SymLook( id_hash_idx hash, const char *id )
 {
     SYM_HASHPTR     hsym;
 
-    for( hsym = HashTab[hash]; hsym != NULL; hsym = hsym->next_sym ) {
+    for( hsym = HashTab[HASH_BUCKET( hash, SymHashSize )]; hsym != NULL; hsym = hsym->next_sym ) {
         if( strcmp( hsym->name, id ) == 0 ) {
             return( hsym->handle );
         }
@@ -531,7 +596,7 @@ SYM_HANDLE SymLookTypedef( id_hash_idx hash, const char *id, SYMPTR sym )
 {
     SYM_HASHPTR     hsym;
 
-    for( hsym = HashTab[hash]; hsym != NULL; hsym = hsym->next_sym ) {
+    for( hsym = HashTab[HASH_BUCKET( hash, SymHashSize )]; hsym != NULL; hsym = hsym->next_sym ) {
         if( strcmp( hsym->name, id ) == 0 ) {
             if( hsym->sym_type == NULL )
                 break;
@@ -552,7 +617,7 @@ SYM_HANDLE Sym0Look( id_hash_idx hash, const char *id )
 {
     SYM_HASHPTR     hsym;
 
-    for( hsym = HashTab[hash]; hsym != NULL; hsym = hsym->next_sym ) {
+    for( hsym = HashTab[HASH_BUCKET( hash, SymHashSize )]; hsym != NULL; hsym = hsym->next_sym ) {
         if( strcmp( hsym->name, id ) == 0 ) {  /* name matches */
             if( hsym->level == 0 ) {
                 return( hsym->handle );
@@ -787,23 +852,30 @@ static SYM_HASHPTR GetSymList( void )
     SYM_HASHPTR     next_hsymptr;
     SYM_HASHPTR     sym_list;
     SYM_HASHPTR     sym_tail;
-    id_hash_idx     hash;
+    SYM_HASHPTR     *head;
     unsigned        i;
     unsigned        j;
     SYM_HASHPTR     sym_seglist[MAX_SYM_SEGS];
     SYM_HASHPTR     sym_buflist[SYMBUFS_PER_SEG];
     SYM_HASHPTR     sym_buftail[SYMBUFS_PER_SEG];
 
+    /*
+     * unlink the symbols of this level from the hash table; the newest
+     * symbol of a level is normally at the head of its bucket, and
+     * sym_list ends up in declaration order
+     */
     sym_list = NULL;
-    for( hash = 0; hash < ID_HASH_SIZE; hash++ ) {
-        for( hsym = HashTab[hash]; hsym != NULL; hsym = next_hsymptr ) {
-            if( !ChkEqSymLevel( hsym ) )
-                break;
-            next_hsymptr = hsym->next_sym;
-            hsym->next_sym = sym_list;
-            sym_list = hsym;
+    hsym = SymLevelList[(id_level_type)SymLevel];
+    SymLevelList[(id_level_type)SymLevel] = NULL;
+    for( ; hsym != NULL; hsym = next_hsymptr ) {
+        next_hsymptr = hsym->next_level;
+        for( head = &HashTab[HASH_BUCKET( hsym->hash, SymHashSize )]; *head != hsym; ) {
+            head = &(*head)->next_sym;
         }
-        HashTab[hash] = hsym;
+        *head = hsym->next_sym;
+        hsym->next_sym = sym_list;
+        sym_list = hsym;
+        --SymHashCount;
     }
     // if SymLevel == 0 then should sort the sym_list so that we don't do
     // a lot of page thrashing.
@@ -799,7 +799,7 @@ static FIELDPTR NewField( FIELDPTR new_field, TYPEPTR decl )
         }
     }
     tag = decl->u.tag;
-    hash = CalcHashID( new_field->name );
+    hash = HASH_BUCKET( CalcHashID( new_field->name ), ID_HASH_SIZE );
     new_field->hash = hash;
     if( new_field->name[0] != '\0' ) {  /* only check non-empty names */
         for( field = FieldHash[hash]; field != NULL; field = field->next_field_same_hash ) {
@@ -1398,7 +1398,7 @@ TAGPTR TagLookup( const char *name )
     TAGPTR      tag;
     id_hash_idx hash;
 
-    hash = CalcHashID( name );
+    hash = HASH_BUCKET( CalcHashID( name ), ID_HASH_SIZE );
     for( tag = TagHash[hash]; tag != NULL; tag = tag->next_tag ) {
         if( strcmp( name, tag->name ) == 0 ) {
             return( tag );
@@ -133,7 +133,7 @@ SYM_NAMEPTR SymName( SYMPTR sym, SYM_HANDLE sym_handle )
         return( "char" );
     if( sym->name != NULL )
         return( sym->name );
-    hsym = HashTab[sym->info.hash];
+    hsym = HashTab[HASH_BUCKET( sym->info.hash, SymHashSize )];
     while( hsym->handle != sym_handle )
         hsym = hsym->next_sym;
     return( hsym->name );
@@ -47,7 +47,7 @@ extern  TAGPTR  TagHash[ID_HASH_SIZE + 1];
 
 #define PH_BUF_SIZE     32768
 #define PCH_SIGNATURE   (('H'<<24)|('C'<<16)|('P'<<8)|'W')     /* 'WPCH' */
-#define PCH_VERSION     0x0128
+#define PCH_VERSION     0x012A
 #if defined(_M_I86)
 #define PCH_VERSION_HOST ( ( 1L << 16 ) | PCH_VERSION )
 #elif defined(_M_IX86)
@@ -136,11 +136,13 @@ typedef struct pheader {
     unsigned        seg_count;
     unsigned        macro_count;
     unsigned        undef_macro_count;
+    unsigned        machash_size;   // MacHashSize
     unsigned        type_count;
     unsigned        tag_count;
     unsigned        pragma_count;
     unsigned        pragma_entry_count;
     unsigned        symhash_count;
+    unsigned        symhash_size;   // SymHashSize
     unsigned        symbol_count;
     unsigned        specialsyms_count;
     unsigned        cwd_len;        // length of current working directory
@@ -301,11 +303,13 @@ static void OutPutHeader( void )
     pch.seg_count         = PH_SegCount;
     pch.macro_count       = PH_MacroCount;
     pch.undef_macro_count = PH_UndefMacroCount;
+    pch.machash_size      = MacHashSize;
     pch.type_count        = PH_TypeCount;
     pch.tag_count         = PH_TagCount;
     pch.pragma_count      = PH_PragmaCount;
     pch.pragma_entry_count = PH_PragmaEntryCount;
     pch.symhash_count     = PH_SymHashCount;
+    pch.symhash_size      = SymHashSize;
     pch.symbol_count      = SymGetNumSyms();
     pch.specialsyms_count = SymGetNumSpecialSyms();
     pch.cwd_len           = PH_cwd_len;
@@ -853,7 +857,7 @@ static void OutPutMacros( void )
 
     PH_MacroCount = 0;
     PH_MacroSize = PH_size;
-    for( hash = 0; hash < MACRO_HASH_SIZE; hash++ ) {
+    for( hash = 0; hash < MacHashSize; hash++ ) {
         for( mentry = MacHash[hash]; mentry != NULL; mentry = mentry_next_macro ) {
             mentry_next_macro = mentry->next_macro;        // save pointer
             mentry->next_macro = PCHSetUInt( hash );
@@ -887,7 +891,7 @@ static void OutPutSymHashTable( void )
     bool            rc;
     size_t          len;
 
-    for( hash = 0; hash < ID_HASH_SIZE; hash++ ) {
+    for( hash = 0; hash < SymHashSize; hash++ ) {
         // reverse the list
         sym_list = NULL;
         for( hsym = HashTab[hash]; hsym != NULL; hsym = hsym_next_sym ) {
@@ -1251,17 +1255,24 @@ static char *FixupUndefMacros( char *p, unsigned undef_macro_count )
     return( p );
 }
 
-static int VerifyMacros( char *p, unsigned macro_count, unsigned undef_count )
+static int VerifyMacros( char *p, unsigned macro_count, unsigned undef_count, unsigned machash_size )
 {
     mac_hash_idx    hash;
     MEPTR           mpch;
     MEPTR           mcur;
     bool            macro_compare;
 
-    PCHMacroHash = (MEPTR *)CMemAlloc( MACRO_HASH_SIZE * sizeof( MEPTR ) );
+    /*
+     * saved macros carry their bucket index, so the table
+     * must have the geometry it had when the header was made
+     */
+    if( MacHashSize != machash_size ) {
+        MacroHashResize( machash_size );
+    }
+    PCHMacroHash = (MEPTR *)CMemAlloc( MacHashSize * sizeof( MEPTR ) );
     p = FixupMacros( p, macro_count );
     p = FixupUndefMacros( p, undef_count );
-    for( hash = 0; hash < MACRO_HASH_SIZE; hash++ ) {
+    for( hash = 0; hash < MacHashSize; hash++ ) {
         MEPTR       prev_mpch;
 
         prev_mpch = NULL;
@@ -1314,7 +1325,7 @@ static int VerifyMacros( char *p, unsigned macro_count, unsigned undef_count )
     // -- endif
     // - endif
     // endloop
-    for( hash = 0; hash < MACRO_HASH_SIZE; hash++ ) {
+    for( hash = 0; hash < MacHashSize; hash++ ) {
         for( mcur = MacHash[hash]; mcur != NULL; mcur = mcur->next_macro ) {
             for( mpch = PCHMacroHash[hash]; mpch != NULL; mpch = mpch->next_macro ) {
                 if( strcmp( mpch->macro_name, mcur->macro_name ) == 0 ) {
@@ -1342,7 +1353,7 @@ static int VerifyMacros( char *p, unsigned macro_count, unsigned undef_count )
         }
     }
 
-    for( hash = 0; hash < MACRO_HASH_SIZE; hash++ ) {
+    for( hash = 0; hash < MacHashSize; hash++ ) {
         MEPTR       next_mcur;
 
         for( mcur = MacHash[hash]; mcur != NULL; mcur = next_mcur ) {
@@ -1358,24 +1369,29 @@ static int VerifyMacros( char *p, unsigned macro_count, unsigned undef_count )
             }
         }
     }
-    memcpy( MacHash, PCHMacroHash, MACRO_HASH_SIZE * sizeof( MEPTR ) );
+    memcpy( MacHash, PCHMacroHash, MacHashSize * sizeof( MEPTR ) );
     CMemFree( PCHMacroHash );
     PCHMacroHash = NULL;
     UndefMacroList = PCHUndefMacroList;
     return( 0 );
 }
 
-static char *FixupSymHashTable( char *p, unsigned symhash_count )
+static char *FixupSymHashTable( char *p, unsigned symhash_count, unsigned symhash_size )
 {
     SYM_HASHPTR hsym;
     int         index;
 
+    if( SymHashSize != symhash_size ) {
+        SymHashResize( symhash_size );
+    }
     for( ; symhash_count != 0; --symhash_count ) {
         hsym = (SYM_HASHPTR)p;
         p += PCHAlign( offsetof( id_hash_entry, name ) + strlen( hsym->name ) + 1 );
         index = PCHGetUInt( hsym->next_sym );
         hsym->next_sym = HashTab[index];
         HashTab[index] = hsym;
+        ++SymHashCount;
+        SymAddLevel( hsym );
         if( PCHGetUInt( hsym->sym_type ) != 0 ) {
             hsym->sym_type = TypeArray + PCHGetUInt( hsym->sym_type );
         }
@@ -1481,8 +1497,7 @@ static char *FixupEnums( char *p, TAGPTR parent )
         ep = (ENUMPTR)p;
         p += PCHGetUInt( ep->parent );
         ep->parent = parent;            // parent is union'ed with enum_len
-        ep->next_enum = EnumTable[ep->hash];
-        EnumTable[ep->hash] = ep;
+        EnumAddHash( ep );
         *lnk = ep;
         lnk = &ep->thread;
     } while( ep->thread != NULL );
@@ -1682,7 +1697,7 @@ static int FixupDataStructures( char *p, pheader *pch )
 #if _INTEL_CPU
     p = FixupPragmaInfo( p, pch->pragma_count, pch->pragma_entry_count );
 #endif
-    p = FixupSymHashTable( p, pch->symhash_count );
+    p = FixupSymHashTable( p, pch->symhash_count, pch->symhash_size );
     p = FixupSymbols( p, pch->symbol_count );
     p = FixupMsgLevels( p, pch->msglevel_len );
 
@@ -1818,7 +1833,7 @@ bool UsePreCompiledHeader( const char *filename )
     }
     p += PCHAlign( len );
     p = FixupIncFileList( p, pch.incfile_count );
-    if( VerifyMacros( PCH_Macros, pch.macro_count, pch.undef_macro_count ) != 0 ) {
+    if( VerifyMacros( PCH_Macros, pch.macro_count, pch.undef_macro_count, pch.machash_size ) != 0 ) {
         PCHNote( PCHDR_MACRO_CHANGED );
         AbortPreCompiledHeader();
         return( false );
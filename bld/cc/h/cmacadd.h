@@ -40,6 +40,7 @@ extern MEPTR        CreateMEntry( const char *, size_t len );
 extern MEPTR        MacroDefine( size_t len, macro_flags mflags );
 extern bool         MacroCompare( MEPTR, MEPTR );
 extern MEPTR        MacroLookup( const char * );
+extern void         MacroHashResize( unsigned size );
 
 void MacroSegmentAddChar(       // MacroSegment: ADD A CHARACTER
     size_t *mlen,               // - data length
@@ -38,14 +38,27 @@
 /* only for long_double */
 #include "xfloat.h"
 
-#define ID_HASH_SIZE            241
-typedef unsigned char   id_hash_idx;
-
-#define MACRO_HASH_SIZE         4093
-typedef unsigned short  mac_hash_idx;
+/*
+ * hash values are full width and all hash table sizes are powers of 2;
+ * the symbol, enum, macro and string literal tables start at the sizes
+ * below and are doubled when they average more than two entries per
+ * bucket, up to the *_MAX sizes; tag and field tables stay at ID_HASH_SIZE
+ * symbols and enum constants are also kept on a list per scope level, so
+ * leaving a block does not have to scan every bucket
+ */
+#define HASH_BUCKET(h,size)     ((h) & ((size) - 1))
+
+#define ID_HASH_SIZE            256
+#define ID_HASH_SIZE_MAX        65536
+typedef unsigned        id_hash_idx;
+
+#define MACRO_HASH_SIZE         4096
+#define MACRO_HASH_SIZE_MAX     65536
+typedef unsigned        mac_hash_idx;
 
 #define STRING_HASH_SIZE        1024
-typedef unsigned short  str_hash_idx;
+#define STRING_HASH_SIZE_MAX    65536
+typedef unsigned        str_hash_idx;
 
 #define MAX_PARM_LIST_HASH_SIZE 15
 typedef unsigned char   parm_hash_idx;
@@ -64,6 +77,7 @@ typedef const char      *SYM_NAMEPTR;
 
 typedef signed int      id_level_stype;
 typedef unsigned char   id_level_type;
+#define ID_LEVEL_COUNT          256     /* # of id_level_type values */
 typedef int             field_level_stype;
 typedef int             expr_level_type;
 
@@ -333,7 +347,9 @@ typedef struct xref_entry {
 typedef struct id_hash_entry {         /* SYMBOL TABLE structure */
     struct id_hash_entry   *next_sym;  /* also used by pre-compiled header */
     TYPEPTR             sym_type;      /* also used by pre-compiled header */
+    struct id_hash_entry   *next_level; /* next symbol of the same level */
     SYM_HANDLE          handle;
+    id_hash_idx         hash;
     id_level_type       level;
     char                name[1];
 } id_hash_entry, *SYM_HASHPTR;
@@ -396,6 +412,7 @@ typedef struct field_entry {
 typedef struct enum_entry {
     struct enum_entry   *next_enum;     /* used in hash table, also used by PCH for length */
     struct enum_entry   *thread;        /* list belonging to same enum */
+    struct enum_entry   *next_level;    /* next constant of the same level */
     XREFPTR             xref;
     struct tag_entry    *parent;        /* also used by pre-compiled header */
     id_hash_idx         hash;
@@ -230,9 +230,13 @@ global segment_id   FunctionProfileSegId;   /* segment for profiling data block
 global int          MacroDepth;
 global char         *MacroPtr;
 global MEPTR        UndefMacroList;
-global MEPTR        *MacHash;           /* [MACRO_HASH_SIZE] */
-global ENUMPTR      EnumTable[ID_HASH_SIZE];
-global SYM_HASHPTR  *HashTab;
+global MEPTR        *MacHash;           /* [MacHashSize] */
+global unsigned     MacHashSize;
+global ENUMPTR      *EnumTable;         /* [EnumHashSize] */
+global unsigned     EnumHashSize;
+global SYM_HASHPTR  *HashTab;           /* [SymHashSize] */
+global unsigned     SymHashSize;
+global unsigned     SymHashCount;       /* # of entries in HashTab */
 global TYPEPTR      BaseTypes[DATA_TYPE_SIZE];
 global unsigned     CTypeCounts[DATA_TYPE_SIZE];
 
@@ -324,7 +328,8 @@ global TYPEPTR      StringArrayType;    /* "unsigned char []" used by literals *
 
 global nested_parm_lists    *NestedParms;
 
-global STR_HANDLE   StringHash[STRING_HASH_SIZE]; /* string literals */
+global STR_HANDLE   *StringHash;        /* [StringHashSize] string literals */
+global unsigned     StringHashSize;
 global char         *TextSegName;       /* name of the text segment */
 global char         *DataSegName;       /* name of the data segment */
 global char         *CodeClassName;     /* name of the code class */
@@ -473,6 +478,7 @@ extern char         *DiagGetTypeName( TYPEPTR typ );
 /* cenum */
 extern TYPEPTR      EnumDecl(type_modifiers);
 extern ENUMPTR      EnumLookup(id_hash_idx,const char *);
+extern void         EnumAddHash(ENUMPTR);
 extern void         EnumInit( void );
 extern void         FreeEnums( void );
 
@@ -706,7 +712,7 @@ extern bool         InitPPScan( void );
 extern void         FiniPPScan( bool );
 extern id_hash_idx  CalcHashID( const char * );
 extern mac_hash_idx CalcHashMacro( const char * );
-extern unsigned     hashpjw( const char * );
+extern unsigned     CalcHash( const char * );
 extern void         SkipAhead( void );
 extern TOKEN        ScanToken( void );
 extern void         ReScanInit( const char * );
@@ -750,6 +756,8 @@ extern SYM_HANDLE   SymAddL0( id_hash_idx, SYMPTR );
 extern SYM_HANDLE   SymLook( id_hash_idx, const char * );
 extern SYM_HANDLE   Sym0Look( id_hash_idx, const char * );
 extern SYM_HANDLE   SymLookTypedef( id_hash_idx, const char *, SYMPTR );
+extern void         SymHashResize( unsigned size );
+extern void         SymAddLevel( SYM_HASHPTR hsym );
 extern void         SymGet( SYMPTR, SYM_HANDLE );
 extern SYMPTR       SymGetPtr( SYM_HANDLE );
 extern void         SymReplace( SYMPTR, SYM_HANDLE );
@@ -183,9 +183,7 @@ void    RemoveBlock( block *blk )
         }
     }
     TellScrapLabel( blk->label );
-    if( blk->dataflow != NULL ) {
-        CGFree( blk->dataflow );
-    }
+    FreeDataFlow( blk );
     FreeABlock( blk );
 }
 
@@ -60,8 +60,9 @@ conflict_node   *AddConflictNode( name *opnd )
     new->name           = opnd;
     new->next_conflict  = ConfList;
     new->next_for_name  = opnd->v.conflict;
-    _GBitInit( new->id.out_of_block, EMPTY );
+    _GBitNew( new->id.out_of_block );
     _LBitInit( new->id.within_block, EMPTY );
+    _GBitNew( new->with.out_of_block );
     new->start_block    = NULL;
     new->ins_range.first= NULL;
     new->ins_range.last = NULL;
@@ -410,6 +411,8 @@ void    FreeAConflict( conflict_node *conf )
         }
     }
     FreePossibleForAlias( conf );
+    _GBitFree( conf->id.out_of_block );
+    _GBitFree( conf->with.out_of_block );
     FrlFreeSize( &ConfFrl, (pointer *)conf, sizeof( conflict_node ) );
 }
 
@@ -170,6 +170,7 @@ static  bool    FindDefnBlocks( block *blk, instruction *cond, opcnt i )
             }
             new_cond = NewIns( 2 );
             Copy( cond, new_cond, INS_SIZE );
+            _GBitCopy( new_cond->head.live.out_of_block, cond->head.live.out_of_block );
             new_cond->head.prev = new_cond;
             new_cond->head.next = new_cond;
             new_cond->operands[i] = prev->operands[0];
@@ -31,7 +31,6 @@
 ****************************************************************************/
 
 
-#define GB_DEFINE_GBITNEXT
 #include "_cgstd.h"
 #include "coderep.h"
 #include "data.h"
@@ -98,9 +97,8 @@ static  bool    AllocBefore( void *n1, void *n2 )
 static  void    RoughSortTemps( void )
 /*************************************
 
-    Do a real rough sort on the templist by savings in case
-    we run out of global bits. This will help the register
-    allocator do the right thing
+    Do a real rough sort on the templist by savings.  This will
+    help the register allocator do the right thing
 */
 {
     name                *actual_name;
@@ -133,22 +131,25 @@ static  void    RoughSortTemps( void )
 }
 
 
-static  global_bit_set AssignGlobalBits( name_class_def class,
-                             global_bit_set *bit, bool first_time )
-/*****************************************************************/
+static  void    AssignGlobalBits( name_class_def class, global_bit_set *bit,
+                                  global_bit_set *all_used, bool first_time )
+/***************************************************************************
+    Give a global bit to each name of "class" which is used in more than
+    one block, starting at "bit".  The bits handed out are returned in
+    "all_used".  The global bit sets grow as needed, so there is no limit
+    on the number of names which can get a bit.
+*/
 {
     conflict_node       *conf;
-    global_bit_set      all_used;
     name                *actual_name;
     name                *opnd;
 
+    _GBitInit( *all_used, EMPTY );
     if( class == N_TEMP ) {
-        _GBitInit( all_used, EMPTY );
         if( !MoreUseInOtherTemps )
-            return( all_used );
+            return;
         MoreUseInOtherTemps = false;
     }
-    _GBitInit( all_used, EMPTY );
     for( opnd = Names[class]; opnd != NULL; opnd = opnd->n.next_name ) {
         if( ( opnd->v.usage & (USE_MEMORY | USE_ADDRESS) ) ) {
             opnd->v.usage |= NEEDS_MEMORY | USE_MEMORY;
@@ -157,26 +158,17 @@ static  global_bit_set AssignGlobalBits( name_class_def class,
             if( class == N_TEMP ) {
                 actual_name = DeAlias( actual_name );
             }
-            if( _GBitEmpty( *bit ) && ( class == N_MEMORY ) ) {
-                actual_name->v.usage |= NEEDS_MEMORY | USE_MEMORY;
-            } else {
-                conf = actual_name->v.conflict;
-                if( conf == NULL && first_time ) {
-                    conf = AddConflictNode( actual_name );
-                }
-                if( conf != NULL && _Isnt( conf, CST_CONFLICT_ON_HOLD ) && _GBitEmpty( conf->id.out_of_block ) ) {
-                    _GBitAssign( conf->id.out_of_block, *bit );
-                    _GBitTurnOn( all_used, *bit );
-                    _GBitNext( bit );
-                    if( _GBitEmpty( conf->id.out_of_block ) ) {
-                        _SetTrue( conf, CST_CONFLICT_ON_HOLD );
-                        MoreUseInOtherTemps = true;
-                    }
-                }
+            conf = actual_name->v.conflict;
+            if( conf == NULL && first_time ) {
+                conf = AddConflictNode( actual_name );
+            }
+            if( conf != NULL && _Isnt( conf, CST_CONFLICT_ON_HOLD ) && _GBitEmpty( conf->id.out_of_block ) ) {
+                _GBitAssign( conf->id.out_of_block, *bit );
+                _GBitTurnOn( *all_used, *bit );
+                _GBitNext( bit );
             }
         }
     }
-    return( all_used );
 }
 
 
@@ -204,15 +196,20 @@ void    MakeConflicts( void )
 /***************************/
 {
     global_bit_set     bit;
+    global_bit_set     all_used;
 
     CheckGlobals();
     MoreUseInOtherTemps = true;
+    _GBitNew( bit );
+    _GBitNew( all_used );
     _GBitFirst( bit );
     if( !BlockByBlock ) {
         RoughSortTemps();
     }
-    AssignGlobalBits( N_TEMP, &bit, true );
-    MemoryBits = AssignGlobalBits( N_MEMORY, &bit, true );
+    AssignGlobalBits( N_TEMP, &bit, &all_used, true );
+    AssignGlobalBits( N_MEMORY, &bit, &MemoryBits, true );
+    _GBitFree( all_used );
+    _GBitFree( bit );
     PropagateConflicts();
 }
 
@@ -221,16 +218,21 @@ bool    MoreConflicts( void )
 /***************************/
 {
     global_bit_set     bit;
+    global_bit_set     all_used;
+    bool               more;
 
+    _GBitNew( bit );
+    _GBitNew( all_used );
     _GBitFirst( bit );
     _GBitInit( MemoryBits, EMPTY );
-    bit = AssignGlobalBits( N_TEMP, &bit, false );
-    if( !_GBitEmpty( bit ) ) {
+    AssignGlobalBits( N_TEMP, &bit, &all_used, false );
+    more = !_GBitEmpty( all_used );
+    _GBitFree( all_used );
+    _GBitFree( bit );
+    if( more ) {
         PropagateConflicts();
-        return( true );
-    } else {
-        return( false );
     }
+    return( more );
 }
 
 
@@ -240,10 +242,6 @@ static  void    PropagateConflicts( void )
 {
     block       *blk;
 
-    /*   Assign global bits to temporaries first in case we run out of*/
-    /*   bits.*/
-    /*   (When we run out of bits, everything } else { is forced to memory)*/
-
     FindReferences();
     if( !BlockByBlock ) {
         LiveAnalysis( HeadBlock, MemoryBits );
@@ -258,7 +256,7 @@ void    SetInOut( block *blk )
 /****************************/
 {
     if( BlockByBlock ) {
-        blk->dataflow->in  = blk->dataflow->use;
+        _GBitAssign( blk->dataflow->in, blk->dataflow->use );
         _GBitTurnOn( blk->dataflow->in, blk->dataflow->def );
         _GBitAssign( blk->dataflow->out, blk->dataflow->in );
     }
@@ -288,6 +286,7 @@ static  void    LiveAnalysis( block *tail, global_bit_set memory_bits )
     while( tail->next_block != NULL ) {
         tail = tail->next_block;
     }
+    _GBitNew( new );
     for( ;; ) {
         change = false;
         for( blk = tail; blk != NULL; blk = blk->prev_block ) {
@@ -297,7 +296,7 @@ static  void    LiveAnalysis( block *tail, global_bit_set memory_bits )
             /*   defined within the procedure*/
 
             if( _IsBlkAttr( blk, BLK_RETURN | BLK_LABEL_RETURN ) ) {
-                new = memory_bits;
+                _GBitAssign( new, memory_bits );
             } else {
                 _GBitInit( new, EMPTY );
             }
@@ -311,7 +310,7 @@ static  void    LiveAnalysis( block *tail, global_bit_set memory_bits )
                 }
             }
             if( !_GBitSame( data->out, new ) ) {
-                data->out = new;
+                _GBitAssign( data->out, new );
                 change = true;
             }
 
@@ -328,4 +327,5 @@ static  void    LiveAnalysis( block *tail, global_bit_set memory_bits )
             break;
         }
     }
+    _GBitFree( new );
 }
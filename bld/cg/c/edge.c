@@ -102,6 +102,7 @@ block   *SplitBlock( block *blk, instruction *ins )
 
     new_blk = MakeBlock( AskForNewLabel(), blk->targets );
     Copy( blk, new_blk, sizeof( block ) + ( sizeof( block_edge ) * ( blk->targets - 1 ) ) );
+    _GBitCopy( new_blk->ins.head.live.out_of_block, blk->ins.head.live.out_of_block );
     new_blk->next_block = blk->next_block;
     new_blk->prev_block = blk;
     blk->next_block = new_blk;
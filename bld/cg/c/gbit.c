@@ -0,0 +1,280 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Global bit set operations.
+*
+****************************************************************************/
+
+
+#include "_cgstd.h"
+#include "coderep.h"
+#include "cgmem.h"
+
+
+#define HIGH_BIT        ( (a_bit_set)1 << ( sizeof( a_bit_set ) * 8 - 1 ) )
+
+#define _Min( a, b )    ( ( (a) < (b) ) ? (a) : (b) )
+#define _Max( a, b )    ( ( (a) > (b) ) ? (a) : (b) )
+
+unsigned        GBitWords = 1;
+
+
+static  gbit_words  *Grow( global_bit_set *set, unsigned len )
+/*************************************************************
+ * Make sure that "set" has at least "len" words.  Once the bits of a
+ * procedure have been handed out every set ends up GBitWords wide, so
+ * allocate that much right away rather than growing a word at a time.
+ */
+{
+    gbit_words  *old;
+    gbit_words  *new;
+    unsigned    i;
+
+    old = *set;
+    if( old != NULL && old->len >= len )
+        return( old );
+    if( len < GBitWords )
+        len = GBitWords;
+    new = CGAlloc( offsetof( gbit_words, w ) + len * sizeof( a_bit_set ) );
+    new->len = len;
+    for( i = 0; i < len; ++i ) {
+        new->w[i] = 0;
+    }
+    if( old != NULL ) {
+        for( i = old->lo; i < old->hi; ++i ) {
+            new->w[i] = old->w[i];
+        }
+        new->lo = old->lo;
+        new->hi = old->hi;
+        CGFree( old );
+    } else {
+        new->lo = 0;
+        new->hi = 0;
+    }
+    *set = new;
+    return( new );
+}
+
+
+static  void    Clear( gbit_words *set )
+/**************************************/
+{
+    unsigned    i;
+
+    for( i = set->lo; i < set->hi; ++i ) {
+        set->w[i] = 0;
+    }
+    set->lo = 0;
+    set->hi = 0;
+}
+
+
+void    GBitFree( global_bit_set *set )
+/*************************************/
+{
+    if( *set != NULL ) {
+        CGFree( *set );
+        *set = NULL;
+    }
+}
+
+
+void    GBitInit( global_bit_set *set, a_bit_set val )
+/****************************************************/
+{
+    gbit_words  *dst;
+    unsigned    i;
+
+    if( val == 0 ) {
+        if( *set != NULL ) {
+            Clear( *set );
+        }
+        return;
+    }
+    dst = Grow( set, GBitWords );
+    for( i = 0; i < dst->len; ++i ) {
+        dst->w[i] = val;
+    }
+    dst->lo = 0;
+    dst->hi = dst->len;
+}
+
+
+void    GBitFirst( global_bit_set *set )
+/**************************************/
+{
+    gbit_words  *dst;
+
+    GBitInit( set, 0 );
+    dst = Grow( set, 1 );
+    dst->w[0] = 1;
+    dst->lo = 0;
+    dst->hi = 1;
+}
+
+
+void    GBitNext( global_bit_set *set )
+/*************************************
+ * Move the single bit in "set" up by one.  This never runs out, the
+ * procedure just gets wider.
+ */
+{
+    gbit_words  *dst;
+    unsigned    i;
+
+    dst = *set;
+    for( i = dst->lo; dst->w[i] == 0; ++i )
+        ;
+    if( dst->w[i] & HIGH_BIT ) {
+        dst->w[i] = 0;
+        ++i;
+        if( GBitWords <= i ) {
+            GBitWords = i + 1;
+        }
+        dst = Grow( set, i + 1 );
+        dst->w[i] = 1;
+        dst->lo = i;
+        dst->hi = i + 1;
+    } else {
+        dst->w[i] <<= 1;
+    }
+}
+
+
+void    GBitAssign( global_bit_set *set, const gbit_words *src )
+/**************************************************************/
+{
+    gbit_words  *dst;
+    unsigned    i;
+
+    if( *set == src )
+        return;
+    if( src == NULL || src->lo >= src->hi ) {
+        GBitInit( set, 0 );
+        return;
+    }
+    dst = Grow( set, src->hi );
+    for( i = dst->lo; i < src->lo; ++i ) {
+        dst->w[i] = 0;
+    }
+    for( i = _Max( src->hi, dst->lo ); i < dst->hi; ++i ) {
+        dst->w[i] = 0;
+    }
+    for( i = src->lo; i < src->hi; ++i ) {
+        dst->w[i] = src->w[i];
+    }
+    dst->lo = src->lo;
+    dst->hi = src->hi;
+}
+
+
+void    GBitTurnOn( global_bit_set *set, const gbit_words *src )
+/**************************************************************/
+{
+    gbit_words  *dst;
+    unsigned    i;
+
+    if( src == NULL || src->lo >= src->hi )
+        return;
+    dst = Grow( set, src->hi );
+    for( i = src->lo; i < src->hi; ++i ) {
+        dst->w[i] |= src->w[i];
+    }
+    if( dst->lo >= dst->hi ) {
+        dst->lo = src->lo;
+        dst->hi = src->hi;
+    } else {
+        dst->lo = _Min( dst->lo, src->lo );
+        dst->hi = _Max( dst->hi, src->hi );
+    }
+}
+
+
+void    GBitTurnOff( global_bit_set dst, const gbit_words *src )
+/**************************************************************/
+{
+    unsigned    hi;
+    unsigned    i;
+
+    if( dst == NULL || src == NULL )
+        return;
+    hi = _Min( dst->hi, src->hi );
+    for( i = _Max( dst->lo, src->lo ); i < hi; ++i ) {
+        dst->w[i] &= ~src->w[i];
+    }
+}
+
+
+bool    GBitEmpty( const gbit_words *set )
+/****************************************/
+{
+    unsigned    i;
+
+    for( i = set->lo; i < set->hi; ++i ) {
+        if( set->w[i] != 0 ) {
+            return( false );
+        }
+    }
+    return( true );
+}
+
+
+bool    GBitOverlap( const gbit_words *a, const gbit_words *b )
+/*************************************************************/
+{
+    unsigned    hi;
+    unsigned    i;
+
+    hi = _Min( a->hi, b->hi );
+    for( i = _Max( a->lo, b->lo ); i < hi; ++i ) {
+        if( a->w[i] & b->w[i] ) {
+            return( true );
+        }
+    }
+    return( false );
+}
+
+
+bool    GBitSame( const gbit_words *a, const gbit_words *b )
+/**********************************************************/
+{
+    unsigned    lo;
+    unsigned    hi;
+    unsigned    i;
+
+    if( a == NULL || a->lo >= a->hi )
+        return( b == NULL || GBitEmpty( b ) );
+    if( b == NULL || b->lo >= b->hi )
+        return( GBitEmpty( a ) );
+    lo = _Min( a->lo, b->lo );
+    hi = _Max( a->hi, b->hi );
+    for( i = lo; i < hi; ++i ) {
+        if( _GBitWord( a, i ) != _GBitWord( b, i ) ) {
+            return( false );
+        }
+    }
+    return( true );
+}
@@ -386,7 +386,7 @@ void    ReplIns( instruction *ins, instruction *new )
          */
         new->head.live.regs         = ins->head.live.regs;
         new->head.live.within_block = ins->head.live.within_block;
-        new->head.live.out_of_block = ins->head.live.out_of_block;
+        _GBitAssign( new->head.live.out_of_block, ins->head.live.out_of_block );
         /*
          * move the first/last pointers of any relevant conflict nodes
          *
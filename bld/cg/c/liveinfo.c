@@ -114,7 +114,7 @@ static  void    ExtendConflicts( block *blk, conflict_node *first_global )
                     SuffixIns( last_ins, new_ins );
                     new_ins->head.live.regs = blk->ins.head.live.regs;
                     new_ins->head.live.within_block = blk->ins.head.live.within_block;
-                    new_ins->head.live.out_of_block = blk->ins.head.live.out_of_block;
+                    _GBitAssign( new_ins->head.live.out_of_block, blk->ins.head.live.out_of_block );
                     HaveLiveInfo = havelive;
                     last_ins = new_ins;
                 }
@@ -139,7 +139,7 @@ static  void    ExtendConflicts( block *blk, conflict_node *first_global )
                     PrefixIns( first_ins, new_ins );
                     new_ins->head.live.regs = blk->ins.head.live.regs;
                     new_ins->head.live.within_block = first_ins->head.live.within_block;
-                    new_ins->head.live.out_of_block = first_ins->head.live.out_of_block;
+                    _GBitAssign( new_ins->head.live.out_of_block, first_ins->head.live.out_of_block );
                     HaveLiveInfo = havelive;
                     first_ins = new_ins;
                 }
@@ -231,7 +231,7 @@ static  void    FlowConflicts( instruction *first, instruction *last, block *blk
     bool                result_forced_alive;
 
     alive.regs          = last->head.live.regs;
-    alive.out_of_block  = last->head.live.out_of_block;
+    _GBitCopy( alive.out_of_block, last->head.live.out_of_block );
     alive.within_block  = last->head.live.within_block;
 #if _TARGET & _TARG_AXP
     if( blk == HeadBlock ) {
@@ -286,7 +286,7 @@ static  void    FlowConflicts( instruction *first, instruction *last, block *blk
         ins->head.live.regs = alive.regs;
         HW_TurnOn( ins->head.live.regs, CurrProc->state.unalterable );
 
-        ins->head.live.out_of_block = alive.out_of_block;
+        _GBitAssign( ins->head.live.out_of_block, alive.out_of_block );
         ins->head.live.within_block = alive.within_block;
 
         ins = ins->head.prev;
@@ -341,6 +341,7 @@ static  void    FlowConflicts( instruction *first, instruction *last, block *blk
             }
         }
     }
+    _GBitFree( alive.out_of_block );
 }
 
 
@@ -222,7 +222,7 @@ static  void    CalculateLoadStore( conflict_node *conf )
     if( blk != NULL ) {
         _MarkBlkAttr( blk, BLK_BIG_LABEL );
     }
-    _GBitAssign( id, conf->id.out_of_block );
+    _GBitCopy( id, conf->id.out_of_block );
     /* turn on bits before the conflict range */
     for( ; blk != NULL; blk = blk->next_block ) {
         if( blk == conf->start_block )
@@ -267,12 +267,13 @@ static  void    CalculateLoadStore( conflict_node *conf )
     PropagateLoadStoreBits( conf->start_block, &id );
     TurnOffLoadStoreBits( &id );
     if( NameIsConstant( conf->name ) ) {
-        id = conf->id.out_of_block;
+        _GBitAssign( id, conf->id.out_of_block );
         for( blk = HeadBlock; blk != NULL; blk = blk->next_block ) {
             flow = blk->dataflow;
             _GBitTurnOff( flow->need_store, id );
         }
     }
+    _GBitFree( id );
     _MarkBlkAllAttrNot( BLK_CONTAINS_CALL | BLK_BLOCK_MARKED | BLK_BLOCK_VISITED );
 }
 
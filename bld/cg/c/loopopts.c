@@ -2308,6 +2308,7 @@ instruction     *DupIns( instruction *blk_end, instruction *ins,
     new = NewIns( ins->num_operands );
     num_operands = ins->num_operands;
     Copy( ins, new, offsetof( instruction, operands ) + num_operands * sizeof( name * ) );
+    _GBitCopy( new->head.live.out_of_block, ins->head.live.out_of_block );
     for( i = 0; i < num_operands; ++i ) {
         AdjustOp( blk_end, &new->operands[i], var, adjust );
     }
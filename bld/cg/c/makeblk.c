@@ -67,7 +67,7 @@ block   *MakeBlock( label_handle label, block_num edges )
     blk->ins.head.opcode = OP_BLOCK;
     HW_CAsgn( blk->ins.head.live.regs, HW_EMPTY );
     _LBitInit( blk->ins.head.live.within_block, EMPTY );
-    _GBitInit( blk->ins.head.live.out_of_block, EMPTY );
+    _GBitNew( blk->ins.head.live.out_of_block );
     blk->ins.blk = blk;
     blk->u.interval = NULL;
     blk->inputs = 0;
@@ -106,6 +106,7 @@ block   *NewBlock( label_handle label, bool label_dies )
 void    FreeABlock( block * blk )
 /*******************************/
 {
+    _GBitFree( blk->ins.head.live.out_of_block );
     if( blk->targets <= 1 ) {
         CGFree( blk );
     } else {
@@ -114,15 +115,33 @@ void    FreeABlock( block * blk )
 }
 
 
+void    FreeDataFlow( block *blk )
+/********************************/
+{
+    data_flow_def   *flow;
+
+    flow = blk->dataflow;
+    if( flow != NULL ) {
+        _GBitFree( flow->in );
+        _GBitFree( flow->out );
+        _GBitFree( flow->def );
+        _GBitFree( flow->use );
+        _GBitFree( flow->call_exempt );
+        _GBitFree( flow->need_load );
+        _GBitFree( flow->need_store );
+        CGFree( flow );
+        blk->dataflow = NULL;
+    }
+}
+
+
 void    FreeBlock( void )
 /***********************/
 {
     while( CurrBlock->ins.head.next != (instruction *)&CurrBlock->ins ) {
         FreeIns( CurrBlock->ins.head.next );
     }
-    if( CurrBlock->dataflow != NULL ) {
-        CGFree( CurrBlock->dataflow );
-    }
+    FreeDataFlow( CurrBlock );
     FreeABlock( CurrBlock );
 }
 
@@ -268,7 +287,8 @@ block   *ReGenBlock( block *blk, label_handle lbl )
     for( edge = new->input_edges; edge != NULL; edge = edge->next_source ) {
         edge->destination.u.blk = new;
     }
-    FreeABlock( blk );
+    /* the live set moved to "new" along with everything else */
+    CGFree( blk );
     return( new );
 }
 
@@ -506,7 +526,10 @@ void    NewProc( level_depth level )
         CurrProc->block_by_block = BlockByBlock;
         CurrProc->ins_id = InsId;
         CurrProc->untrimmed = BlocksUnTrimmed;
+        CurrProc->gbit_words = GBitWords;
     }
+    /* global bits are handed out from the bottom, so start out narrow */
+    GBitWords = 1;
     HaveCurrBlock = true;
     BlocksUnTrimmed = true;
     MaxStack = 0;
@@ -541,6 +564,7 @@ void    FreeProc( void )
         FreeBlock();
     }
     BlockList = NULL;
+    _GBitFree( MemoryBits );
     FreeNames();
     TellBeginExecutions();
     oldproc = CurrProc;
@@ -563,6 +587,7 @@ void    FreeProc( void )
             DummyIndex = CurrProc->dummy_index;
             BlockByBlock = CurrProc->block_by_block;
             BlocksUnTrimmed = CurrProc->untrimmed;
+            GBitWords = CurrProc->gbit_words;
         } else {
             InsId = 0;
             BlockByBlock = false;
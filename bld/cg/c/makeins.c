@@ -85,6 +85,7 @@ void    FreeIns( instruction *ins )
 
     ins->head.prev->head.next = next;
     next->head.prev = ins->head.prev;
+    _GBitFree( ins->head.live.out_of_block );
     FrlFreeSize( &InsFrl, (pointer *)ins, INS_SIZE );
 }
 
@@ -108,6 +109,7 @@ instruction     *NewIns( opcnt num )
     memset( &new->flags, 0, sizeof( new->flags ) );
     new->ins_flags = 0;
     new->head.line_num = 0;
+    _GBitNew( new->head.live.out_of_block );
     new->sequence = 0;
     new->stk_entry = 0;
     new->stk_exit = 0;
@@ -821,6 +821,8 @@ static  void    NeighboursUse( conflict_node *conf )
     _LBitInit( conf->with.within_block, EMPTY );
     _INS_NOT_BLOCK ( last );
     if( ins != last ) {
+        _GBitNew( no_conflict.out_of_block );
+        _GBitNew( gbit );
         _NameSetInit( no_conflict );
         for( ;; ) {
             ins = ins->head.next;
@@ -873,9 +875,13 @@ static  void    NeighboursUse( conflict_node *conf )
                 tmp = ins->head.live.regs;
                 HW_TurnOff( tmp, no_conflict.regs );
                 HW_TurnOn( conf->with.regs, tmp );
-                _GBitAssign( gbit, ins->head.live.out_of_block );
-                _GBitTurnOff( gbit, no_conflict.out_of_block );
-                _GBitTurnOn( conf->with.out_of_block, gbit );
+                if( _GBitEmpty( no_conflict.out_of_block ) ) {
+                    _GBitTurnOn( conf->with.out_of_block, ins->head.live.out_of_block );
+                } else {
+                    _GBitAssign( gbit, ins->head.live.out_of_block );
+                    _GBitTurnOff( gbit, no_conflict.out_of_block );
+                    _GBitTurnOn( conf->with.out_of_block, gbit );
+                }
                 _LBitAssign( lbit, ins->head.live.within_block );
                 _LBitTurnOff( lbit, no_conflict.within_block );
                 _LBitTurnOn( conf->with.within_block, lbit );
@@ -896,6 +902,8 @@ static  void    NeighboursUse( conflict_node *conf )
                 break;
             }
         }
+        _GBitFree( gbit );
+        _GBitFree( no_conflict.out_of_block );
     }
     /*
         Here's the deal with the following: we are assuming that a register
@@ -166,6 +166,7 @@ static  bool    CantChange( instruction **pins, name *frm, name *to )
     num_operands = (*pins)->num_operands;
     new_ins = NewIns( num_operands );
     Copy( *pins, new_ins, offsetof( instruction, operands ) + num_operands * sizeof( name * ) );
+    _GBitCopy( new_ins->head.live.out_of_block, (*pins)->head.live.out_of_block );
     if( CanChange( pins, frm, to, new_ins ) )
         return( false );
     new_ins->head.next = new_ins;
@@ -156,6 +156,7 @@ static  bool    Split1Var( conflict_node *conf )
         ++Instance;
         MarkInstance( unlabeled );
     }
+    _GBitFree( Id );
     op = conf->name;
     change = false;
     while( Instance > 1 ) {
@@ -443,6 +443,13 @@ void    FindReferences( void )
     for( curr = HeadBlock; curr != NULL; curr = curr->next_block ) {
         if( curr->dataflow == NULL ) {
             curr->dataflow = CGAlloc( sizeof( data_flow_def ) );
+            _GBitNew( curr->dataflow->def );
+            _GBitNew( curr->dataflow->use );
+            _GBitNew( curr->dataflow->in );
+            _GBitNew( curr->dataflow->out );
+            _GBitNew( curr->dataflow->call_exempt );
+            _GBitNew( curr->dataflow->need_load );
+            _GBitNew( curr->dataflow->need_store );
         }
         _GBitInit( curr->dataflow->def         , EMPTY );
         _GBitInit( curr->dataflow->use         , EMPTY );
@@ -34,9 +34,5 @@
 #error 16-bit bitsets not supported
 #endif
 
-#ifdef GB_DEFINE_GBITNEXT
-#define _GBit_DEFINE_BITNEXT
-#endif
-
-#include "gbit.gh"
 #include "lbit.gh"
+#include "gbit.h"
@@ -0,0 +1,85 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Global bit sets, sized per procedure (implemented in gbit.c).
+*
+****************************************************************************/
+
+
+/*
+ * A global bit set holds one bit for every name which is live across
+ * blocks.  The number of such names is only known once the bits are
+ * handed out, so the words are allocated on demand and a set grows to
+ * the width the current procedure uses.  A NULL set is empty.  Only the
+ * words from "lo" up to "hi" may be non-zero, which keeps operations on
+ * a set with a single bit (a conflict id) from walking the whole width.
+ */
+typedef struct gbit_words {
+    unsigned            len;        /* words allocated */
+    unsigned            lo;
+    unsigned            hi;
+    a_bit_set           w[1];
+} gbit_words;
+
+typedef gbit_words      *global_bit_set;
+
+/* number of words used by the bits handed out in the current procedure */
+extern unsigned         GBitWords;
+
+extern void             GBitFree( global_bit_set * );
+extern void             GBitInit( global_bit_set *, a_bit_set );
+extern void             GBitFirst( global_bit_set * );
+extern void             GBitNext( global_bit_set * );
+extern void             GBitAssign( global_bit_set *, const gbit_words * );
+extern void             GBitTurnOn( global_bit_set *, const gbit_words * );
+extern void             GBitTurnOff( global_bit_set, const gbit_words * );
+extern bool             GBitEmpty( const gbit_words * );
+extern bool             GBitOverlap( const gbit_words *, const gbit_words * );
+extern bool             GBitSame( const gbit_words *, const gbit_words * );
+
+/* a set which has not been given storage yet */
+#define _GBitNew( set )             ((set) = NULL)
+#define _GBitFree( set )            GBitFree( &(set) )
+/* give "dst" its own copy of "src", whatever "dst" pointed at is not freed */
+#define _GBitCopy( dst, src )       { _GBitNew( dst ); GBitAssign( &(dst), src ); }
+
+#define _GBitInit( set, val )       GBitInit( &(set), (a_bit_set)(val) )
+#define _GBitFirst( set )           GBitFirst( &(set) )
+#define _GBitNext( set )            GBitNext( set )
+#define _GBitAssign( dst, src )     GBitAssign( &(dst), src )
+#define _GBitTurnOn( dst, src )     GBitTurnOn( &(dst), src )
+#define _GBitTurnOff( dst, src )    GBitTurnOff( dst, src )
+#define _GBitEmpty( set )           ( (set) == NULL || GBitEmpty( set ) )
+#define _GBitOverlap( a, b )        ( (a) != NULL && (b) != NULL && GBitOverlap( a, b ) )
+#define _GBitSame( a, b )           GBitSame( a, b )
+
+#define _GBitWord( set, i )         ( ( (set) != NULL && (i) < (set)->len ) ? (set)->w[i] : 0 )
+
+#define _GBitIter( routine, set ) { \
+            unsigned _i; \
+            for( _i = 0; _i < GBitWords; _i++ ) \
+                (routine)( _GBitWord( set, _i ) ); \
+        }
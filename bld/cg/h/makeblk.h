@@ -32,6 +32,7 @@
 extern  block           *MakeBlock( label_handle label, block_num edges );
 extern  block           *NewBlock( label_handle label, bool label_dies );
 extern  void            FreeABlock( block * blk );
+extern  void            FreeDataFlow( block *blk );
 extern  void            FreeBlock( void );
 extern  void            EnLink( label_handle label, bool label_dies );
 extern  void            AddIns( instruction *ins );
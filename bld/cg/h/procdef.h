@@ -89,6 +89,7 @@ typedef struct proc_def {
     pointer             label;
     int                 ins_id;
     bool                block_by_block;
+    unsigned            gbit_words;
     bool                untrimmed;
     bool                contains_call;
     level_depth         lex_level;
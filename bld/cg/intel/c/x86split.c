@@ -874,6 +874,7 @@ instruction     *rTEMP2CONST( instruction *ins )
      */
     new = NewIns( ins->num_operands );
     Copy( ins, new, sizeof( instruction ) );  // without operands
+    _GBitCopy( new->head.live.out_of_block, ins->head.live.out_of_block );
     for( i = ins->num_operands; i-- > 0; ) {
         op = ins->operands[i];
         if( _ConstTemp( op ) ) {
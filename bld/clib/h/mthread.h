@@ -53,6 +53,7 @@
     extern int          __NTThreadInit( void );
     extern int          __NTAddThread( thread_data * );
     extern void         __NTRemoveThread( int );
+    extern thread_data  *__NTPeekThreadData( void );
     extern void         (*_ThreadExitRtn)( void );
   #elif defined( _NETWARE_CLIB )
     extern void         **__ThreadIDs;
@@ -77,6 +78,8 @@
     extern void         __LinuxRemoveThread( void );
     extern void         __LinuxSetThreadData( void *__data );
     extern void         *__LinuxGetThreadData( void );
+    extern void         __LinuxThreadInit( void );
+    extern thread_data  *__LinuxPeekThreadData( void );
   #elif defined( __RDOS__ ) /* || defined( __RDOSDEV__ ) */
     extern int          __RdosThreadInit( void );
     extern int          __RdosAddThread( thread_data * );
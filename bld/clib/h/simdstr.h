@@ -0,0 +1,69 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  SSE2 versions of the hot string and memory functions, selected
+*               at startup on CPUs that support SSE2.
+*
+****************************************************************************/
+
+
+
+#ifndef _SIMDSTR_H_INCLUDED
+#define _SIMDSTR_H_INCLUDED
+
+
+/*
+ * Only flat 386 targets whose operating system saves the SSE state on a
+ * task switch use the SSE2 versions; the wide character versions don't.
+ */
+
+#if defined( _M_IX86 ) && !defined( _M_I86 ) && !defined( __WIDECHAR__ ) \
+  && ( defined( __NT__ ) || defined( __LINUX__ ) )
+    #define __SIMDSTR__
+#endif
+
+#ifdef __SIMDSTR__              /* do nothing if not an SSE2 target */
+
+#include <stddef.h>
+
+/*
+ * Set by the startup code when the CPU supports SSE2.
+ */
+extern unsigned char    __sse2_present;
+
+/*
+ * The SSE2 routines never read from a page that holds no byte of their
+ * operands, so a string that ends just before an unmapped page is safe.
+ */
+extern size_t           __strlen_sse2( const char *__s );
+extern char             *__strchr_sse2( const char *__s, int __c );
+extern int              __strcmp_sse2( const char *__s1, const char *__s2 );
+extern void             *__memchr_sse2( const void *__s, int __c, size_t __n );
+extern int              __memcmp_sse2( const void *__s1, const void *__s2, size_t __n );
+
+#endif
+
+#endif
@@ -332,6 +332,7 @@ typedef unsigned long       syscall_res;
 #define SYS_statfs64            268
 #define SYS_fstatfs64           269
 #define SYS_tgkill              270
+#define SYS_perf_event_open     336
 
 /*
  * internal sub-numbers for SYS_socketcall
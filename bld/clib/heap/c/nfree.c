@@ -35,9 +35,13 @@
 #include <malloc.h>
 #include "heap.h"
 #include "heapacc.h"
-#if defined(__RDOS__)
+#if defined(__NT__)
+#include <windows.h>
+#elif defined(__RDOS__)
 #include <rdos.h>
 #endif
+#include "rtdata.h"
+#include "thread.h"
 
 
 heapblk_nptr    __MiniHeapFreeRover;
@@ -71,6 +75,10 @@ _WCRTLINK void _nfree( void_nptr cstg )
     if( cstg == NULL )
         return;
 
+#ifdef __NHEAP_CACHE
+    if( __NHeapCacheFree( cstg ) )
+        return;
+#endif
     _AccessNHeap();
     do {
         // first try some likely locations
@@ -0,0 +1,203 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Per thread cache of small near heap blocks.
+*
+****************************************************************************/
+
+
+
+
+#include "dll.h"        // needs to be first
+#include "variety.h"
+#include <stddef.h>
+#include <malloc.h>
+#include "roundmac.h"
+#include "heapacc.h"
+#include "heap.h"
+#if defined(__NT__)
+    #include <windows.h>
+#endif
+#include "rtdata.h"
+#include "thread.h"
+#include "mthread.h"
+
+
+#ifdef __NHEAP_CACHE
+
+/*
+ * Freed blocks of up to NHEAP_CACHE_MAX bytes are kept on per thread
+ * lists, one per block size, and handed out again by _nmalloc without
+ * taking the heap lock. To the rest of the heap code a cached block is
+ * still in use, so _heapwalk and _heapchk see a consistent heap; the
+ * blocks go back to the heap when the thread ends or _heapmin is called.
+ *
+ * An empty list is refilled with a batch of blocks taken from the heap
+ * under a single lock, so threads that allocate more than they free
+ * also skip the lock for most of their allocations.
+ *
+ * The first word of a cached block links the list, the second one holds
+ * the owning cache so that a block freed twice is not linked twice.
+ */
+
+#define NHEAP_CACHE_MAX     (FRL_SIZE + (NHEAP_CACHE_CLASSES - 1) * HEAP_ROUND_SIZE)
+#define NHEAP_CACHE_DEPTH   16
+#define NHEAP_CACHE_REFILL  8
+
+#if defined( __LINUX__ )
+    #define PEEK_THREAD_DATA()  __LinuxPeekThreadData()
+#else
+    #define PEEK_THREAD_DATA()  __NTPeekThreadData()
+#endif
+
+#define SIZE2CLASS(s)       (((s) - FRL_SIZE) / HEAP_ROUND_SIZE)
+#define CACHE_NEXT(p)       (((void_nptr *)(p))[0])
+#define CACHE_OWNER(p)      (((void_nptr *)(p))[1])
+
+static nheap_cache *getCache( void )
+/**********************************/
+{
+    thread_data     *tdata;
+
+    tdata = PEEK_THREAD_DATA();
+    if( tdata == NULL )
+        return( NULL );
+    return( &tdata->__nheap_cache );
+}
+
+static void refill( nheap_cache *cache, unsigned size )
+/*****************************************************/
+{
+    void_nptr       cstg;
+    unsigned        i;
+    unsigned        n;
+
+    /*
+     * _nmalloc sees the disabled cache and takes the locked path; the
+     * heap lock is recursive, so holding it here makes it one acquisition
+     */
+    i = SIZE2CLASS( size );
+    cache->disabled = 1;
+    _AccessNHeap();
+    for( n = 0; n < NHEAP_CACHE_REFILL; n++ ) {
+        cstg = _nmalloc( size - TAG_SIZE );
+        if( cstg == NULL )
+            break;
+        CACHE_NEXT( cstg ) = cache->head[i];
+        CACHE_OWNER( cstg ) = cache;
+        cache->head[i] = cstg;
+        cache->count[i]++;
+    }
+    _ReleaseNHeap();
+    cache->disabled = 0;
+}
+
+void *__NHeapCacheAlloc( unsigned size )
+/**************************************/
+{
+    nheap_cache     *cache;
+    void_nptr       cstg;
+    unsigned        i;
+
+    if( size > NHEAP_CACHE_MAX )
+        return( NULL );
+    cache = getCache();
+    if( cache == NULL || cache->disabled )
+        return( NULL );
+    i = SIZE2CLASS( size );
+    if( cache->head[i] == NULL )
+        refill( cache, size );
+    cstg = cache->head[i];
+    if( cstg != NULL ) {
+        cache->head[i] = CACHE_NEXT( cstg );
+        cache->count[i]--;
+        CACHE_OWNER( cstg ) = NULL;
+    }
+    return( cstg );
+}
+
+int __NHeapCacheFree( void *cstg )
+/********************************/
+{
+    freelist_nptr   frl;
+    nheap_cache     *cache;
+    void_nptr       p;
+    unsigned        size;
+    unsigned        i;
+
+    frl = (freelist_nptr)CSTG2BLK( cstg );
+    if( !IS_BLK_INUSE( frl ) )
+        return( 0 );
+    size = GET_BLK_SIZE( frl );
+    if( size < FRL_SIZE || size > NHEAP_CACHE_MAX || (size % HEAP_ROUND_SIZE) != 0 )
+        return( 0 );
+    cache = getCache();
+    if( cache == NULL || cache->disabled )
+        return( 0 );
+    i = SIZE2CLASS( size );
+    if( CACHE_OWNER( cstg ) == cache ) {
+        for( p = cache->head[i]; p != NULL; p = CACHE_NEXT( p ) ) {
+            if( p == cstg ) {
+                return( 1 );
+            }
+        }
+    }
+    if( cache->count[i] >= NHEAP_CACHE_DEPTH )
+        return( 0 );
+    CACHE_NEXT( cstg ) = cache->head[i];
+    CACHE_OWNER( cstg ) = cache;
+    cache->head[i] = cstg;
+    cache->count[i]++;
+    return( 1 );
+}
+
+void __NHeapCacheFlush( thread_data *tdata )
+/******************************************/
+{
+    nheap_cache     *cache;
+    void_nptr       cstg;
+    unsigned        i;
+
+    if( tdata == NULL ) {
+        tdata = PEEK_THREAD_DATA();
+        if( tdata == NULL ) {
+            return;
+        }
+    }
+    cache = &tdata->__nheap_cache;
+    cache->disabled = 1;
+    for( i = 0; i < NHEAP_CACHE_CLASSES; i++ ) {
+        while( (cstg = cache->head[i]) != NULL ) {
+            cache->head[i] = CACHE_NEXT( cstg );
+            CACHE_OWNER( cstg ) = NULL;
+            _nfree( cstg );
+        }
+        cache->count[i] = 0;
+    }
+    cache->disabled = 0;
+}
+
+#endif
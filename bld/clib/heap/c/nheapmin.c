@@ -49,6 +49,8 @@
 #elif defined(__DOS__)
     #include "tinyio.h"
 #endif
+#include "rtdata.h"
+#include "thread.h"
 
 
 #if defined(__DOS_EXT__)
@@ -151,6 +153,9 @@ _WCRTLINK int _nheapshrink( void )
 
     // Shrink by adjusting _curbrk
 
+#ifdef __NHEAP_CACHE
+    __NHeapCacheFlush( NULL );
+#endif
     _AccessNHeap();
 #if defined(__OS2__) && !defined(_M_I86) || defined(__WINDOWS__) || defined(__NT__) || \
     defined(__CALL21__) || defined(__RDOS__)
@@ -39,9 +39,13 @@
 #include "extfunc.h"
 #include "heapacc.h"
 #include "heap.h"
-#if defined(__RDOS__)
+#if defined(__NT__)
+#include <windows.h>
+#elif defined(__RDOS__)
 #include <rdos.h>
 #endif
+#include "rtdata.h"
+#include "thread.h"
 
 #if defined(_M_IX86)
     #pragma aux (__outside_CLIB) __nmemneed;
@@ -158,6 +162,12 @@ _WCRTLINK void_nptr _nmalloc( size_t amt )
         size = FRL_SIZE;
     }
 
+#ifdef __NHEAP_CACHE
+    cstg = __NHeapCacheAlloc( size );
+    if( cstg != NULL ) {
+        return( cstg );
+    }
+#endif
     _AccessNHeap();
     cstg = NULL;
     expanded = 0;
@@ -0,0 +1,81 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Detect SSE2 support for the string and memory functions.
+*
+****************************************************************************/
+
+
+
+#include "variety.h"
+#include "rtinit.h"
+#include "simdstr.h"
+
+
+#ifdef __SIMDSTR__
+
+#define CPUID_EDX_SSE2  0x04000000
+
+extern unsigned cpu_features( void );
+#pragma aux cpu_features = \
+        ".586"              \
+        "pushfd"            /* save flags register */ \
+        "pushfd"            \
+        "pop  eax"          \
+        "mov  ecx,eax"      \
+        "xor  eax,200000h"  /* change ID bit */ \
+        "push eax"          \
+        "popfd"             \
+        "pushfd"            \
+        "pop  eax"          \
+        "xor  eax,ecx"      \
+        "xor  edx,edx"      /* assume no CPUID, no features */ \
+        "test eax,200000h"  /* check if ID bit changed */ \
+        "je short done"     \
+        "mov  eax,1"        /* want feature information */ \
+        "cpuid"             \
+    "done:"                 \
+        "popfd"             \
+    __parm []               \
+    __value [__edx]         \
+    __modify __exact [__eax __ebx __ecx __edx]
+
+unsigned char   __sse2_present = 0;
+
+static void __check_sse2( void )
+{
+    /*
+     * NT and Linux both save the SSE state on a task switch, so the CPUID
+     * feature bit is all that needs checking.
+     */
+    if( cpu_features() & CPUID_EDX_SSE2 ) {
+        __sse2_present = 1;
+    }
+}
+
+AXI( __check_sse2, INIT_PRIORITY_RUNTIME );
+
+#endif
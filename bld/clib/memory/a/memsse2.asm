@@ -0,0 +1,157 @@
+;*****************************************************************************
+;*
+;*                            Open Watcom Project
+;*
+;*    Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+;*
+;*  ========================================================================
+;*
+;*    This file contains Original Code and/or Modifications of Original
+;*    Code as defined in and that are subject to the Sybase Open Watcom
+;*    Public License version 1.0 (the 'License'). You may not use this file
+;*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+;*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+;*    provided with the Original Code and Modifications, and is also
+;*    available at www.sybase.com/developer/opensource.
+;*
+;*    The Original Code and all software distributed under the License are
+;*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+;*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+;*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+;*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+;*    NON-INFRINGEMENT. Please see the License for the specific language
+;*    governing rights and limitations under the License.
+;*
+;*  ========================================================================
+;*
+;* Description:  SSE2 implementation of memchr() and memcmp() for CPUs
+;*               that support it (see simdstr.h).
+;*
+;*****************************************************************************
+
+
+;
+; memchr only reads aligned 16 byte blocks, which never cross a page
+; boundary. memcmp reads unaligned blocks but only within the operands,
+; and finishes the last 0 to 15 bytes one at a time.
+;
+
+include mdef.inc
+include struct.inc
+
+.686
+.xmm2
+
+        modstart memsse2,para
+
+;
+; void *__memchr_sse2( const void *s, int c, size_t n )
+;
+        defp    __memchr_sse2
+        xdefp   "C",__memchr_sse2
+        push    ebx                     ; save registers
+        push    ecx                     ; ...
+    ifdef __STACK__
+        mov     eax,12[esp]             ; get s
+        mov     edx,16[esp]             ; get c
+        mov     ebx,20[esp]             ; get n
+    endif
+        test    ebx,ebx                 ; quit if n is 0
+        je      notfound                ; ...
+        movzx   edx,dl                  ; c is converted to unsigned char
+        movd    xmm2,edx                ; make 16 copies of c
+        punpcklbw xmm2,xmm2             ; ...
+        punpcklwd xmm2,xmm2             ; ...
+        pshufd  xmm2,xmm2,0             ; ...
+        mov     ecx,eax                 ; get offset of s in its block
+        and     ecx,15                  ; ...
+        and     eax,-16                 ; point to aligned block holding s
+        add     ebx,ecx                 ; count bytes from start of block
+        _if     c                       ; if that overflowed
+          mov   ebx,-1                  ; - search to the end of memory
+        _endif                          ; endif
+        movdqa  xmm1,[eax]              ; find c in first block
+        pcmpeqb xmm1,xmm2               ; ...
+        pmovmskb edx,xmm1               ; ...
+        shr     edx,cl                  ; ignore bytes before s
+        shl     edx,cl                  ; ...
+        _loop                           ; loop
+          test  edx,edx                 ; - quit if c found
+          _quif ne                      ; - ...
+          sub   ebx,16                  ; - quit if no bytes left
+          jbe   notfound                ; - ...
+          add   eax,16                  ; - next block
+          movdqa xmm1,[eax]             ; - find c in it
+          pcmpeqb xmm1,xmm2             ; - ...
+          pmovmskb edx,xmm1             ; - ...
+        _endloop                        ; endloop
+        bsf     edx,edx                 ; get offset of c in block
+        cmp     edx,ebx                 ; quit if past the end of s
+        jae     notfound                ; ...
+        add     eax,edx                 ; point to c
+        pop     ecx                     ; restore registers
+        pop     ebx                     ; ...
+        ret                             ; return
+notfound:
+        sub     eax,eax                 ; c was not found
+        pop     ecx                     ; restore registers
+        pop     ebx                     ; ...
+        ret                             ; return
+        endproc __memchr_sse2
+
+;
+; int __memcmp_sse2( const void *s1, const void *s2, size_t n )
+;
+        defp    __memcmp_sse2
+        xdefp   "C",__memcmp_sse2
+        push    ebx                     ; save registers
+        push    ecx                     ; ...
+    ifdef __STACK__
+        mov     eax,12[esp]             ; get s1
+        mov     edx,16[esp]             ; get s2
+        mov     ebx,20[esp]             ; get n
+    endif
+        _loop                           ; loop
+          cmp   ebx,16                  ; - quit if less than 16 bytes left
+          _quif b                       ; - ...
+          movdqu xmm1,[eax]             ; - compare 16 bytes
+          movdqu xmm2,[edx]             ; - ...
+          pcmpeqb xmm1,xmm2             ; - ...
+          pmovmskb ecx,xmm1             ; - ...
+          xor   ecx,0FFFFh              ; - get unequal bytes
+          _if   ne                      ; - if there are any
+            bsf   ecx,ecx               ; - - point to first one
+            add   eax,ecx               ; - - ...
+            add   edx,ecx               ; - - ...
+            mov   cl,[eax]              ; - - and compare it
+            cmp   cl,[edx]              ; - - ...
+            jmp   short unequal         ; - - ...
+          _endif                        ; - endif
+          add   eax,16                  ; - next 16 bytes
+          add   edx,16                  ; - ...
+          sub   ebx,16                  ; - ...
+        _endloop                        ; endloop
+        _loop                           ; loop
+          test  ebx,ebx                 ; - quit if no bytes left
+          _quif e                       ; - ...
+          mov   cl,[eax]                ; - compare a byte
+          cmp   cl,[edx]                ; - ...
+          jne   unequal                 ; - quit if not equal
+          inc   eax                     ; - next byte
+          inc   edx                     ; - ...
+          dec   ebx                     ; - ...
+        _endloop                        ; endloop
+        sub     eax,eax                 ; indicate operands equal
+        pop     ecx                     ; restore registers
+        pop     ebx                     ; ...
+        ret                             ; return
+unequal:
+        sbb     eax,eax                 ; eax = 0 if s1>s2, -1 if s1<s2
+        or      al,1                    ; eax = 1 if s1>s2, -1 if s1<s2
+        pop     ecx                     ; restore registers
+        pop     ebx                     ; ...
+        ret                             ; return
+        endproc __memcmp_sse2
+
+        endmod
+        end
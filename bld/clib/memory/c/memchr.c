@@ -34,6 +34,7 @@
 #include "widechar.h"
 #include "libwchar.h"
 #include "xstring.h"
+#include "simdstr.h"
 
 /* locate the first occurrence of c in the initial n characters of the
    object pointed to by s.
@@ -43,6 +44,10 @@
 _WCRTLINK VOID_WC_TYPE *__F_NAME(memchr,wmemchr)( const VOID_WC_TYPE *s, INT_WC_TYPE c, size_t n )
 {
 #if defined(__INLINE_FUNCTIONS__) && !defined(__WIDECHAR__) && defined(_M_IX86)
+  #ifdef __SIMDSTR__
+    if( __sse2_present )
+        return( __memchr_sse2( s, c, n ) );
+  #endif
     return( _inline_memchr( s, c, n ) );
 #else
     const CHAR_TYPE *cs = s;
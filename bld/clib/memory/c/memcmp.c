@@ -34,11 +34,16 @@
 #include "widechar.h"
 #include "libwchar.h"
 #include "xstring.h"
+#include "simdstr.h"
 
 
 _WCRTLINK int __F_NAME(memcmp,wmemcmp)( const VOID_WC_TYPE *in_s1, const VOID_WC_TYPE *in_s2, size_t len )
 {
 #if defined(__INLINE_FUNCTIONS__) && !defined(__WIDECHAR__) && defined(_M_IX86)
+  #ifdef __SIMDSTR__
+    if( __sse2_present )
+        return( __memcmp_sse2( in_s1, in_s2, len ) );
+  #endif
     return( _inline_memcmp( in_s1, in_s2, len ) );
 #else
     const CHAR_TYPE *s1 = in_s1;
@@ -618,6 +618,30 @@ int __NTAddThread( thread_data *tdata )
 }
 
 
+thread_data *__NTPeekThreadData( void )
+/*************************************/
+{
+    /*
+     * Return the current thread's data if it already exists, without
+     * creating it; the heap calls this on every allocation.
+     */
+    DWORD       old;
+    thread_data *tdata;
+
+    if( __TlsIndex == NO_INDEX )
+        return( NULL );
+    old = GetLastError();
+    tdata = (thread_data *)TlsGetValue( __TlsIndex );
+    SetLastError( old );
+    #if defined( __RUNTIME_CHECKS__ ) && defined( _M_IX86 )
+    if( tdata == (thread_data *)2 )
+        return( NULL );
+    #endif
+    if( tdata != NULL && tdata->__resize )
+        return( NULL );
+    return( tdata );
+}
+
 void __NTRemoveThread( int close_handle )
 /***************************************/
 {
@@ -632,6 +656,9 @@ void __NTRemoveThread( int close_handle )
     #else
         if( tdata == NULL )
             return;
+    #endif
+    #ifdef __NHEAP_CACHE
+        __NHeapCacheFlush( tdata );
     #endif
         thread_handle = tdata->thread_handle;
         __RemoveThreadData( tdata->thread_id );
@@ -743,10 +770,16 @@ void __LinuxRemoveThread( void )
     thread_data *tdata;
 
     tdata = __LinuxGetThreadData();
-    if(tdata != NULL && tdata->__allocated )
-        lib_free( tdata );
-
-    __LinuxSetThreadData( NULL );
+    if( tdata != NULL ) {
+    #ifdef __NHEAP_CACHE
+        __NHeapCacheFlush( tdata );
+    #endif
+        // clear the slot first, lib_free may look at it
+        __LinuxSetThreadData( NULL );
+        if( tdata->__allocated ) {
+            lib_free( tdata );
+        }
+    }
 }
 
   #elif defined( __RDOS__ )
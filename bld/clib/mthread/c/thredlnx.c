@@ -57,13 +57,112 @@ extern sem_t *__tls_sem;
 struct __lnx_thread {
     __thread_fn *start_addr;
     void        *args;
+    void        **tls_slot;
+    thread_data *tdata;
 };
 
+#if defined( _M_IX86 )
+
+/*
+ * Each thread keeps its thread data pointer in a one word slot that a
+ * TLS descriptor in %gs points at, so looking it up is a single load.
+ * The main thread uses a static slot, other threads one at the top of
+ * their stack. If the kernel hands out no descriptor, the gettid() keyed
+ * list below is used instead. %gs floats in the flat model, so it is
+ * reloaded on every access.
+ */
+
+struct lnx_user_desc {
+    unsigned int    entry_number;
+    unsigned long   base_addr;
+    unsigned int    limit;
+    unsigned int    seg_32bit       : 1;
+    unsigned int    contents        : 2;
+    unsigned int    read_exec_only  : 1;
+    unsigned int    limit_in_pages  : 1;
+    unsigned int    seg_not_present : 1;
+    unsigned int    useable         : 1;
+};
+
+static unsigned short   __tls_sel;          /* 0 if the list is used */
+static unsigned int     __tls_entry;
+static void             *__tls_main_slot;
+
+extern void *__get_tls_slot( unsigned short sel );
+#pragma aux __get_tls_slot = \
+        "mov  gs,ax"        \
+        "mov  eax,gs:[0]"   \
+    __parm      [__ax] \
+    __value     [__eax] \
+    __modify __exact [__eax __gs]
+
+extern void __set_tls_slot( unsigned short sel, void *data );
+#pragma aux __set_tls_slot = \
+        "mov  gs,dx"        \
+        "mov  gs:[0],eax"   \
+    __parm      [__dx] [__eax] \
+    __modify __exact [__gs]
+
+static int __set_tls_area( void **slot, unsigned int entry )
+/**********************************************************/
+{
+    struct lnx_user_desc    desc;
+    syscall_res             res;
+
+    memset( &desc, 0, sizeof( desc ) );
+    desc.entry_number = entry;
+    desc.base_addr = (unsigned long)slot;
+    desc.limit = sizeof( *slot ) - 1;
+    desc.seg_32bit = 1;
+    desc.useable = 1;
+    res = sys_call1( SYS_set_thread_area, (u_long)&desc );
+    if( __syscall_iserror( res ) )
+        return( -1 );
+    __tls_entry = desc.entry_number;
+    return( 0 );
+}
+
+void __LinuxThreadInit( void )
+/****************************/
+{
+    __tls_main_slot = NULL;
+    if( __set_tls_area( &__tls_main_slot, (unsigned int)-1 ) == 0 ) {
+        __tls_sel = ( __tls_entry << 3 ) | 3;
+    }
+}
+
+thread_data *__LinuxPeekThreadData( void )
+/****************************************/
+{
+    thread_data *tdata;
+
+    if( __tls_sel == 0 )
+        return( NULL );
+    tdata = __get_tls_slot( __tls_sel );
+    if( tdata != NULL && tdata->__resize )
+        return( NULL );
+    return( tdata );
+}
+
+#else
+
+void __LinuxThreadInit( void )
+/****************************/
+{
+}
+
+#endif
+
 void *__LinuxGetThreadData( void )
 {
     volatile struct __lnx_tls_entry *walker;
     void *ret;
 
+#if defined( _M_IX86 )
+    if( __tls_sel != 0 ) {
+        return( __get_tls_slot( __tls_sel ) );
+    }
+#endif
     ret = NULL;
 
     sem_wait( __tls_sem );
@@ -87,6 +186,12 @@ void __LinuxSetThreadData( void *__data )
     volatile struct __lnx_tls_entry *walker;
     volatile struct __lnx_tls_entry *previous;
 
+#if defined( _M_IX86 )
+    if( __tls_sel != 0 ) {
+        __set_tls_slot( __tls_sel, __data );
+        return;
+    }
+#endif
     sem_wait( __tls_sem );
         walker = __tls;
         previous = NULL;
@@ -99,7 +204,7 @@ void __LinuxSetThreadData( void *__data )
         }
 
         if( walker == NULL && __data != NULL ) {
-            walker = (struct __lnx_tls_entry *)lib_malloc( sizeof( struct __lnx_tls_entry * ) );
+            walker = (struct __lnx_tls_entry *)lib_malloc( sizeof( struct __lnx_tls_entry ) );
             walker->tls = __data;
             walker->id = gettid();
             walker->next = NULL;
@@ -127,12 +232,19 @@ static void __cloned_lnx_start_fn( void *thrvoiddata )
 
     struct __lnx_thread *thrdata;
 
-    __LinuxAddThread(NULL);
-
     thrdata = (struct __lnx_thread *)thrvoiddata;
+#if defined( _M_IX86 )
+    /* the child starts out with its parent's descriptor */
+    if( __tls_sel != 0 ) {
+        __set_tls_area( thrdata->tls_slot, __tls_entry );
+    }
+#endif
+    __LinuxAddThread( thrdata->tdata );
+
     (*thrdata->start_addr)( thrdata->args );
     free( thrvoiddata );
 
+    __LinuxRemoveThread();
     _sys_exit( 0 );
     // never return
 }
@@ -143,6 +255,7 @@ int __CBeginThread( thread_fn *start_addr, void *stack_bottom,
 {
     pid_t               pid;
     struct __lnx_thread *thrdata;
+    void                **stack_top;
     unsigned            flags = CLONE_VM | CLONE_FS | CLONE_FILES | CLONE_SIGHAND
                             | CLONE_THREAD | CLONE_SYSVSEM | CLONE_PTRACE | CLONE_IO
                             | CLONE_PARENT_SETTID | CLONE_CHILD_CLEARTID | CLONE_DETACHED;
@@ -158,6 +271,8 @@ int __CBeginThread( thread_fn *start_addr, void *stack_bottom,
         return( -1 );
     }
 
+    __InitMultipleThread();
+
     thrdata = (struct __lnx_thread *)malloc( sizeof( struct __lnx_thread ) );
     if( thrdata == NULL ) {
         _RWD_errno = ENOMEM;
@@ -166,7 +281,29 @@ int __CBeginThread( thread_fn *start_addr, void *stack_bottom,
     thrdata->start_addr = (__thread_fn *)start_addr;
     thrdata->args = arglist;
 
-    pid = clone( (int(*)(void *))__cloned_lnx_start_fn, (void *)( (int)stack_bottom + stack_size ), flags, thrdata );
+    /*
+     * The child's thread data is allocated here: until the child has it,
+     * a wait on a contended heap lock sets errno, which needs thread data.
+     */
+    thrdata->tdata = lib_calloc( 1, __ThreadDataSize );
+    if( thrdata->tdata == NULL ) {
+        free( thrdata );
+        _RWD_errno = ENOMEM;
+        return( -1 );
+    }
+    thrdata->tdata->__allocated = 1;
+    thrdata->tdata->__data_size = __ThreadDataSize;
+
+    /* the topmost word of the stack is the child's thread data slot */
+    stack_top = (void **)( ( (unsigned)stack_bottom + stack_size ) & ~( sizeof( void * ) - 1 ) ) - 1;
+    *stack_top = NULL;
+    thrdata->tls_slot = stack_top;
+
+    pid = clone( (int(*)(void *))__cloned_lnx_start_fn, (void *)stack_top, flags, thrdata, NULL, NULL, NULL );
+    if( pid == -1 ) {
+        lib_free( thrdata->tdata );
+        free( thrdata );
+    }
 
     return( (int)pid );
 }
@@ -174,7 +311,7 @@ int __CBeginThread( thread_fn *start_addr, void *stack_bottom,
 void __CEndThread( void )
 /***********************/
 {
-    __LinuxSetThreadData(NULL);
+    __LinuxRemoveThread();
     _sys_exit( 0 );
     // never return
 }
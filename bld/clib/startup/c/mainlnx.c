@@ -81,9 +81,11 @@ void __LinuxInit( struct thread_data *ptr )
     __tls_sem = (sem_t *)malloc(sizeof(sem_t));
     if(__tls_sem != NULL)
         sem_init( __tls_sem, 0, 1 );
+    __LinuxThreadInit();
 
     __InitThreadData( ptr );
     __FirstThreadData = ptr;
+    __LinuxSetThreadData( ptr );
 #endif
 
     // following is very tricky _STACKLOW intialization
@@ -118,15 +118,13 @@ static int __filbuf( FILE *fp )
     }
 }
 
-_WCRTLINK int fgetc( FILE *fp )
+int __fgetc_unlocked( FILE *fp )
+/******************************/
 {
     int c;
 
-    _ValidFile( fp, EOF );
-    _AccessFile( fp );
-
     /*** Deal with stream orientation ***/
-    ORIENT_STREAM( fp, EOF );
+    ORIENT_STREAM_UNLOCKED( fp, EOF );
 
     if( (fp->_flag & _READ) == 0 ) {
         _RWD_errno = EBADF;
@@ -162,6 +160,16 @@ _WCRTLINK int fgetc( FILE *fp )
         }
     }
 #endif
+    return( c );
+}
+
+_WCRTLINK int fgetc( FILE *fp )
+{
+    int c;
+
+    _ValidFile( fp, EOF );
+    _AccessFile( fp );
+    c = __fgetc_unlocked( fp );
     _ReleaseFile( fp );
     return( c );
 }
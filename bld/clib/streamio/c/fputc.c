@@ -56,20 +56,17 @@
 
 #ifndef __WIDECHAR__
 
-_WCRTLINK int fputc( int c, FILE *fp )
+int __fputc_unlocked( int c, FILE *fp )
+/*************************************/
 {
     int flags;
 
-    _ValidFile( fp, EOF );
-    _AccessFile( fp );
-
     /*** Deal with stream orientation ***/
-    ORIENT_STREAM( fp, EOF );
+    ORIENT_STREAM_UNLOCKED( fp, EOF );
 
     if( !(fp->_flag & _WRITE) ) {
         _RWD_errno = EBADF;
         fp->_flag |= _SFERR;
-        _ReleaseFile( fp );
         return( EOF );
     }
     if( _FP_BASE( fp ) == NULL ) {
@@ -86,7 +83,6 @@ _WCRTLINK int fputc( int c, FILE *fp )
             fp->_cnt++;
             if( fp->_cnt == fp->_bufsize ) {
                 if( __flush( fp ) ) {
-                    _ReleaseFile( fp );
                     return( EOF );
                 }
             }
@@ -99,14 +95,21 @@ _WCRTLINK int fputc( int c, FILE *fp )
     fp->_cnt++;
     if( (fp->_flag & flags) || (fp->_cnt == fp->_bufsize) ) {
         if( __flush( fp ) ) {
-            _ReleaseFile( fp );
             return( EOF );
         }
     }
-    _ReleaseFile( fp );
     return( (UCHAR_TYPE)c );
 }
 
+_WCRTLINK int fputc( int c, FILE *fp )
+{
+    _ValidFile( fp, EOF );
+    _AccessFile( fp );
+    c = __fputc_unlocked( c, fp );
+    _ReleaseFile( fp );
+    return( c );
+}
+
 
 #else
 
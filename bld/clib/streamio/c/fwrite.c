@@ -50,22 +50,19 @@
 #include "thread.h"
 
 
-_WCRTLINK size_t fwrite( const void *buf, size_t size, size_t n, FILE *fp )
+size_t __fwrite_unlocked( const void *buf, size_t size, size_t n, FILE *fp )
+/**************************************************************************/
 {
     size_t      count;
     unsigned    oflag;
 
-    _ValidFile( fp, 0 );
-    _AccessFile( fp );
     if( (fp->_flag & _WRITE) == 0 ) {
         _RWD_errno = EBADF;
         fp->_flag |= _SFERR;
-        _ReleaseFile( fp );
         return( 0 );        /* POSIX says return 0 */
     }
     n *= size;
     if( n == 0 ) {
-        _ReleaseFile( fp );
         return( n );
     }
     if( _FP_BASE( fp ) == NULL ) {
@@ -133,14 +130,14 @@ _WCRTLINK size_t fwrite( const void *buf, size_t size, size_t n, FILE *fp )
             fp->_flag |= _IOFBF;
         }
 
-        /*** Use fputc, and make it think the stream is byte-oriented ***/
+        /*** Use __fputc_unlocked, and make it think the stream is byte-oriented ***/
     #ifndef __NETWARE__
         old_orientation = _FP_ORIENTATION(fp);
         _FP_ORIENTATION(fp) = _BYTE_ORIENTED;
     #endif
         bufptr = (const char *)buf;
         do {
-            fputc( *(bufptr++), fp );
+            __fputc_unlocked( *(bufptr++), fp );
             if( fp->_flag & (_EOF | _SFERR) ) break;
             ++count;
         } while( count != n );
@@ -164,6 +161,14 @@ _WCRTLINK size_t fwrite( const void *buf, size_t size, size_t n, FILE *fp )
         count = 0;
     }
     fp->_flag |= oflag;                     /* JBS 27-jan-92 */
-    _ReleaseFile( fp );
     return( count / size );
 }
+
+_WCRTLINK size_t fwrite( const void *buf, size_t size, size_t n, FILE *fp )
+{
+    _ValidFile( fp, 0 );
+    _AccessFile( fp );
+    n = __fwrite_unlocked( buf, size, n, fp );
+    _ReleaseFile( fp );
+    return( n );
+}
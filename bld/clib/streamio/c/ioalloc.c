@@ -33,11 +33,38 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <unistd.h>
+#ifdef __LINUX__
+    #include <sys/stat.h>
+#endif
 #include "liballoc.h"
 #include "rtdata.h"
 #include "streamio.h"
 
 
+#ifdef __LINUX__
+
+/* Upper limit for buffers sized from st_blksize */
+#define MAX_BLKSIZE     0x10000
+
+static int __blksize( FILE *fp )
+/******************************/
+{
+    struct stat     st;
+
+    /* Use the preferred I/O block size of the file if it is larger than
+     * BUFSIZ, so that reads and writes on filesystems with big blocks
+     * don't have to be split up.
+     */
+    if( fstat( fileno( fp ), &st ) == 0 && st.st_blksize > BUFSIZ ) {
+        if( st.st_blksize > MAX_BLKSIZE )
+            return( MAX_BLKSIZE );
+        return( st.st_blksize );
+    }
+    return( BUFSIZ );
+}
+
+#endif
+
 void __ioalloc( FILE *fp )
 {
     __chktty( fp );                                 /* JBS 28-aug-90 */
@@ -52,7 +79,11 @@ void __ioalloc( FILE *fp )
              */
             fp->_bufsize = 64;
         } else {
+#ifdef __LINUX__
+            fp->_bufsize = __blksize( fp );
+#else
             fp->_bufsize = BUFSIZ;
+#endif
         }
     }
     _FP_BASE( fp ) = lib_malloc( fp->_bufsize );
@@ -32,6 +32,7 @@
 #ifdef __NETWARE__
     /* One less thing to worry about */
     #define ORIENT_STREAM(stream,error_return)
+    #define ORIENT_STREAM_UNLOCKED(stream,error_return)
 #else
   #ifdef __WIDECHAR__
     #define ORIENT_STREAM(stream,error_return)                  \
@@ -43,6 +44,14 @@
                 return( error_return );                         \
             }                                                   \
         }
+    #define ORIENT_STREAM_UNLOCKED(stream,error_return)         \
+        if( _FP_ORIENTATION(stream) != _WIDE_ORIENTED ) {       \
+            if( _FP_ORIENTATION(stream) == _NOT_ORIENTED ) {    \
+                _FP_ORIENTATION(stream) = _WIDE_ORIENTED;       \
+            } else {                                            \
+                return( error_return );                         \
+            }                                                   \
+        }
   #else
     #define ORIENT_STREAM(stream,error_return)                  \
         if( _FP_ORIENTATION(stream) != _BYTE_ORIENTED ) {       \
@@ -53,5 +62,13 @@
                 return( error_return );                         \
             }                                                   \
     }
+    #define ORIENT_STREAM_UNLOCKED(stream,error_return)         \
+        if( _FP_ORIENTATION(stream) != _BYTE_ORIENTED ) {       \
+            if( _FP_ORIENTATION(stream) == _NOT_ORIENTED ) {    \
+                _FP_ORIENTATION(stream) = _BYTE_ORIENTED;       \
+            } else {                                            \
+                return( error_return );                         \
+            }                                                   \
+        }
   #endif
 #endif
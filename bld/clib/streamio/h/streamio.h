@@ -36,3 +36,6 @@ extern void __chktty( FILE *fp );
 extern void __ioalloc( FILE * );
 extern int  __doclose( FILE *fp, int close_handle );
 extern int  __shutdown_stream( FILE *fp, int close_handle );
+extern int  __fgetc_unlocked( FILE *fp );
+extern int  __fputc_unlocked( int c, FILE *fp );
+extern size_t __fwrite_unlocked( const void *buf, size_t size, size_t n, FILE *fp );
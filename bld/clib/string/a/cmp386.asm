@@ -32,6 +32,18 @@
 include mdef.inc
 include struct.inc
 
+ifdef __NT__
+SIMDSTR = 1
+endif
+ifdef __LINUX__
+SIMDSTR = 1
+endif
+
+ifdef SIMDSTR
+        extrn   "C",__sse2_present : byte
+        xrefp   "C",__strcmp_sse2
+endif
+
 ifdef _PROFILE
 include p5prof.inc
 endif
@@ -55,6 +67,10 @@ cmp4    macro   off
 
         defpe   strcmp
         xdefp   "C",strcmp
+    ifdef SIMDSTR
+        cmp     byte ptr __sse2_present,0 ; use SSE2 version if possible
+        jne     __strcmp_sse2           ; ...
+    endif
     ifdef _PROFILE
         P5Prolog
     endif
@@ -0,0 +1,200 @@
+;*****************************************************************************
+;*
+;*                            Open Watcom Project
+;*
+;*    Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+;*
+;*  ========================================================================
+;*
+;*    This file contains Original Code and/or Modifications of Original
+;*    Code as defined in and that are subject to the Sybase Open Watcom
+;*    Public License version 1.0 (the 'License'). You may not use this file
+;*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+;*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+;*    provided with the Original Code and Modifications, and is also
+;*    available at www.sybase.com/developer/opensource.
+;*
+;*    The Original Code and all software distributed under the License are
+;*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+;*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+;*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+;*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+;*    NON-INFRINGEMENT. Please see the License for the specific language
+;*    governing rights and limitations under the License.
+;*
+;*  ========================================================================
+;*
+;* Description:  SSE2 implementation of strlen(), strchr() and strcmp()
+;*               for CPUs that support it (see simdstr.h).
+;*
+;*****************************************************************************
+
+
+;
+; strlen and strchr only read aligned 16 byte blocks, which never cross a
+; page boundary. strcmp can't align both strings, so it reads unaligned
+; blocks and steps a byte at a time while either string is within 16 bytes
+; of the end of a page.
+;
+
+include mdef.inc
+include struct.inc
+
+.686
+.xmm2
+
+        modstart strsse2,para
+
+;
+; size_t __strlen_sse2( const char *s )
+;
+        defp    __strlen_sse2
+        xdefp   "C",__strlen_sse2
+    ifdef __STACK__
+        mov     eax,4[esp]              ; get s
+    endif
+        push    ebx                     ; save registers
+        push    ecx                     ; ...
+        push    edx                     ; ...
+        mov     edx,eax                 ; remember s
+        mov     ecx,eax                 ; get offset of s in its block
+        and     ecx,15                  ; ...
+        and     eax,-16                 ; point to aligned block holding s
+        pxor    xmm0,xmm0               ; 16 nul bytes
+        movdqa  xmm1,[eax]              ; find nuls in first block
+        pcmpeqb xmm1,xmm0               ; ...
+        pmovmskb ebx,xmm1               ; ...
+        shr     ebx,cl                  ; ignore bytes before s
+        test    ebx,ebx                 ; (shr by 0 leaves the flags alone)
+        _if     ne                      ; if nul in first block
+          bsf   eax,ebx                 ; - length is its offset from s
+        _else                           ; else
+          _loop                         ; - loop
+            add   eax,16                ; - - next block
+            movdqa xmm1,[eax]           ; - - find nuls in it
+            pcmpeqb xmm1,xmm0           ; - - ...
+            pmovmskb ebx,xmm1           ; - - ...
+            test  ebx,ebx               ; - - quit if one found
+          _until  ne                    ; - until nul found
+          bsf   ebx,ebx                 ; - get offset of nul in block
+          add   eax,ebx                 ; - point to nul
+          sub   eax,edx                 ; - length is distance from s
+        _endif                          ; endif
+        pop     edx                     ; restore registers
+        pop     ecx                     ; ...
+        pop     ebx                     ; ...
+        ret                             ; return
+        endproc __strlen_sse2
+
+;
+; char *__strchr_sse2( const char *s, int c )
+;
+        defp    __strchr_sse2
+        xdefp   "C",__strchr_sse2
+        push    ebx                     ; save registers
+        push    ecx                     ; ...
+    ifdef __STACK__
+        mov     eax,12[esp]             ; get s
+        mov     edx,16[esp]             ; get c
+    endif
+        movzx   edx,dl                  ; c is converted to char
+        movd    xmm2,edx                ; make 16 copies of c
+        punpcklbw xmm2,xmm2             ; ...
+        punpcklwd xmm2,xmm2             ; ...
+        pshufd  xmm2,xmm2,0             ; ...
+        pxor    xmm0,xmm0               ; 16 nul bytes
+        mov     ecx,eax                 ; get offset of s in its block
+        and     ecx,15                  ; ...
+        and     eax,-16                 ; point to aligned block holding s
+        movdqa  xmm1,[eax]              ; find c or nul in first block
+        movdqa  xmm3,xmm1               ; ...
+        pcmpeqb xmm1,xmm0               ; ...
+        pcmpeqb xmm3,xmm2               ; ...
+        por     xmm1,xmm3               ; ...
+        pmovmskb ebx,xmm1               ; ...
+        shr     ebx,cl                  ; ignore bytes before s
+        shl     ebx,cl                  ; ...
+        _loop                           ; loop
+          test  ebx,ebx                 ; - quit if c or nul found
+          _quif ne                      ; - ...
+          add   eax,16                  ; - next block
+          movdqa xmm1,[eax]             ; - find c or nul in it
+          movdqa xmm3,xmm1              ; - ...
+          pcmpeqb xmm1,xmm0             ; - ...
+          pcmpeqb xmm3,xmm2             ; - ...
+          por   xmm1,xmm3               ; - ...
+          pmovmskb ebx,xmm1             ; - ...
+        _endloop                        ; endloop
+        bsf     ebx,ebx                 ; get offset of first match in block
+        add     eax,ebx                 ; point to it
+        cmp     dl,[eax]                ; if it is the nul (and c isn't)
+        _if     ne                      ; then
+          sub   eax,eax                 ; - c was not found
+        _endif                          ; endif
+        pop     ecx                     ; restore registers
+        pop     ebx                     ; ...
+        ret                             ; return
+        endproc __strchr_sse2
+
+;
+; int __strcmp_sse2( const char *s1, const char *s2 )
+;
+        defp    __strcmp_sse2
+        xdefp   "C",__strcmp_sse2
+        push    ebx                     ; save registers
+        push    ecx                     ; ...
+    ifdef __STACK__
+        mov     eax,12[esp]             ; get s1
+        mov     edx,16[esp]             ; get s2
+    endif
+        pxor    xmm0,xmm0               ; 16 nul bytes
+restart:
+        mov     ecx,eax                 ; if s1 is within 16 bytes of the
+        and     ecx,0FFFh               ; ... end of a page
+        cmp     ecx,0FF0h               ; ...
+        ja      bytecmp                 ; then compare a byte
+        mov     ecx,edx                 ; if s2 is within 16 bytes of the
+        and     ecx,0FFFh               ; ... end of a page
+        cmp     ecx,0FF0h               ; ...
+        ja      bytecmp                 ; then compare a byte
+        movdqu  xmm1,[eax]              ; get 16 bytes of s1
+        movdqu  xmm2,[edx]              ; get 16 bytes of s2
+        movdqa  xmm3,xmm1               ; find nuls in s1
+        pcmpeqb xmm3,xmm0               ; ...
+        pcmpeqb xmm1,xmm2               ; find equal bytes
+        pmovmskb ebx,xmm3               ; ...
+        pmovmskb ecx,xmm1               ; ...
+        xor     ecx,0FFFFh              ; get unequal bytes
+        or      ecx,ebx                 ; add end of string
+        _if     e                       ; if neither found
+          add   eax,16                  ; - next 16 bytes
+          add   edx,16                  ; - ...
+          jmp   short restart           ; - and go on
+        _endif                          ; endif
+        bsf     ecx,ecx                 ; get offset of first difference or nul
+        add     eax,ecx                 ; point to it
+        add     edx,ecx                 ; ...
+bytecmp:
+        mov     cl,[eax]                ; get byte from s1
+        cmp     cl,[edx]                ; compare with byte from s2
+        jne     unequal                 ; quit if not equal
+        test    cl,cl                   ; quit if end of string
+        je      equal                   ; ...
+        inc     eax                     ; next byte
+        inc     edx                     ; ...
+        jmp     restart                 ; and start over
+equal:
+        sub     eax,eax                 ; indicate strings equal
+        pop     ecx                     ; restore registers
+        pop     ebx                     ; ...
+        ret                             ; return
+unequal:
+        sbb     eax,eax                 ; eax = 0 if s1>s2, -1 if s1<s2
+        or      al,1                    ; eax = 1 if s1>s2, -1 if s1<s2
+        pop     ecx                     ; restore registers
+        pop     ebx                     ; ...
+        ret                             ; return
+        endproc __strcmp_sse2
+
+        endmod
+        end
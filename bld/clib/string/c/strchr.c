@@ -34,6 +34,7 @@
 #include <stddef.h>
 #include <string.h>
 #include "riscstr.h"
+#include "simdstr.h"
 
 #if defined( _M_I86 ) && !defined(__WIDECHAR__)
 
@@ -120,6 +121,11 @@ extern  char * _scan1();
 #endif
 {
     CHAR_TYPE   cc = c;
+
+#ifdef __SIMDSTR__
+    if( __sse2_present )
+        return( __strchr_sse2( s, c ) );
+#endif
     do {
         if( *s == cc )
             return( (CHAR_TYPE *)s );
@@ -33,6 +33,7 @@
 #include "widechar.h"
 #include <stdio.h>
 #include "riscstr.h"
+#include "simdstr.h"
 #include "xstring.h"
 #undef  strlen
 
@@ -45,6 +46,10 @@
 {
 
 #if defined(__INLINE_FUNCTIONS__) && !defined(__WIDECHAR__) && defined(_M_IX86)
+  #ifdef __SIMDSTR__
+    if( __sse2_present )
+        return( __strlen_sse2( s ) );
+  #endif
     return( _inline_strlen( s ) );
 #else
     const CHAR_TYPE *p;
@@ -0,0 +1,149 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Multi-threaded heap and thread data test for Linux.
+*
+****************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include <process.h>
+#include <unistd.h>
+
+
+#define NUM_THREADS     8
+#define NUM_BLOCKS      64
+#define MAX_ITER        2000
+#define MAX_SIZE        300
+
+static volatile int     done[NUM_THREADS];
+static volatile int     failed[NUM_THREADS];
+static void             *left[NUM_THREADS][NUM_BLOCKS];
+static char             text[NUM_THREADS][2 * MAX_ITER];
+
+static void threadfunc( void *arg )
+{
+    int             id;
+    unsigned        seed;
+    unsigned        iter;
+    unsigned        i;
+    unsigned        j;
+    size_t          size[NUM_BLOCKS];
+    unsigned char   *p[NUM_BLOCKS];
+    char            *tok;
+
+    id = (int)arg;
+    seed = id * 7919 + 1;
+    /* the strtok position lives in the thread data, one token per round */
+    memset( text[id], ' ', sizeof( text[id] ) - 1 );
+    for( i = 0; i < MAX_ITER; ++i ) {
+        text[id][2 * i] = 'a' + id;
+    }
+    tok = strtok( text[id], " " );
+    for( iter = 0; iter < MAX_ITER; ++iter ) {
+        for( i = 0; i < NUM_BLOCKS; ++i ) {
+            seed = seed * 1103515245 + 12345;
+            size[i] = 1 + ( seed >> 16 ) % MAX_SIZE;
+            p[i] = malloc( size[i] );
+            if( p[i] == NULL ) {
+                failed[id] = __LINE__;
+                break;
+            }
+            memset( p[i], id, size[i] );
+        }
+        if( failed[id] )
+            break;
+        /* free in a different order than allocated */
+        for( i = 0; i < NUM_BLOCKS; ++i ) {
+            j = ( i * 5 + iter ) % NUM_BLOCKS;
+            if( p[j][0] != id || p[j][size[j] - 1] != id ) {
+                failed[id] = __LINE__;
+                break;
+            }
+            if( iter == MAX_ITER - 1 ) {
+                /* leave the last round for the main thread to free */
+                left[id][j] = p[j];
+            } else {
+                free( p[j] );
+            }
+        }
+        if( failed[id] )
+            break;
+        if( tok != &text[id][2 * iter] ) {
+            failed[id] = __LINE__;
+            break;
+        }
+        tok = strtok( NULL, " " );
+    }
+    done[id] = 1;
+}
+
+int main( int argc, char **argv )
+{
+    int         i;
+    int         j;
+    int         heap_status;
+
+    /* unused parameters */ (void)argc;
+
+    for( i = 0; i < NUM_THREADS; ++i ) {
+        if( _beginthread( &threadfunc, NULL, 0, (void *)i ) == -1 ) {
+            printf( "FAIL: line %d thread=%d\n", __LINE__, i );
+            return( EXIT_FAILURE );
+        }
+    }
+    for( i = 0; i < NUM_THREADS; ++i ) {
+        while( !done[i] ) {
+            sleep( 1 );
+        }
+        if( failed[i] ) {
+            printf( "FAIL: line %d thread=%d\n", failed[i], i );
+            return( EXIT_FAILURE );
+        }
+    }
+    /* blocks freed by a thread other than the one that allocated them */
+    for( i = 0; i < NUM_THREADS; ++i ) {
+        for( j = 0; j < NUM_BLOCKS; ++j ) {
+            free( left[i][j] );
+        }
+    }
+    heap_status = _heapchk();
+    if( heap_status != _HEAPOK ) {
+        printf( "FAIL: line %d heap_status=%d\n", __LINE__, heap_status );
+        return( EXIT_FAILURE );
+    }
+    _heapmin();
+    heap_status = _heapchk();
+    if( heap_status != _HEAPOK && heap_status != _HEAPEMPTY ) {
+        printf( "FAIL: line %d heap_status=%d\n", __LINE__, heap_status );
+        return( EXIT_FAILURE );
+    }
+    printf( "Tests completed (%s).\n", argv[0] );
+    return( EXIT_SUCCESS );
+}
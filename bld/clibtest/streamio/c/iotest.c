@@ -38,6 +38,9 @@
 #include <malloc.h>
 #include <unistd.h>
 #include <errno.h>
+#ifdef __LINUX__
+    #include <sys/stat.h>
+#endif
 
 #ifdef __SW_BW
     #include <wdefwin.h>
@@ -684,6 +687,96 @@ int Test_ungetc( void )
     return( 1 );
 }
 
+int Test_unlocked( void )
+/***********************/
+{
+    FILE        *fp;
+    FILE        *fpr;
+    char        *buff;
+    size_t      size;
+    size_t      i;
+    char        filename[ L_tmpnam ];
+    char        cur_mode[10] = "unlocked";
+#ifdef __LINUX__
+    struct stat st;
+#endif
+
+    VERIFY( tmpnam( filename ) != NULL );
+
+    /* Both forms of each function, and reads from a write stream */
+    VERIFY( (fp = fopen( filename, "w" )) != NULL );
+    VERIFY( getc_unlocked( fp ) == EOF );
+    VERIFY( ferror( fp ) );
+    clearerr( fp );
+    VERIFY( putc_unlocked( 'a', fp ) == 'a' );
+    VERIFY( (putc_unlocked)( 'b', fp ) == 'b' );
+    VERIFY( putc_unlocked( '\n', fp ) == '\n' );
+    VERIFY( (putc_unlocked)( '\n', fp ) == '\n' );
+    VERIFY( fwrite_unlocked( "cd\nef", 1, 5, fp ) == 5 );
+    VERIFY( (getc_unlocked)( fp ) == EOF );
+    VERIFY( ferror( fp ) );
+    VERIFY( fclose( fp ) == 0 );
+
+    /* Read back, end of file, and writes to a read stream */
+    VERIFY( (fp = fopen( filename, "r" )) != NULL );
+    VERIFY( getc_unlocked( fp ) == 'a' );
+    VERIFY( (getc_unlocked)( fp ) == 'b' );
+    VERIFY( getc_unlocked( fp ) == '\n' );
+    VERIFY( (getc_unlocked)( fp ) == '\n' );
+    VERIFY( getc_unlocked( fp ) == 'c' );
+    VERIFY( getc_unlocked( fp ) == 'd' );
+    VERIFY( getc_unlocked( fp ) == '\n' );
+    VERIFY( getc_unlocked( fp ) == 'e' );
+    VERIFY( getc_unlocked( fp ) == 'f' );
+    VERIFY( getc_unlocked( fp ) == EOF );
+    VERIFY( feof( fp ) && !ferror( fp ) );
+    VERIFY( (getc_unlocked)( fp ) == EOF );
+    VERIFY( feof( fp ) && !ferror( fp ) );
+    VERIFY( (putc_unlocked)( 'x', fp ) == EOF );
+    VERIFY( ferror( fp ) );
+    clearerr( fp );
+    VERIFY( fwrite_unlocked( "x", 1, 1, fp ) == 0 );
+    VERIFY( ferror( fp ) );
+    VERIFY( fclose( fp ) == 0 );
+
+    /* A full buffer goes out with the byte that fills it */
+    VERIFY( (fp = fopen( filename, "wb" )) != NULL );
+    VERIFY( (fpr = fopen( filename, "rb" )) != NULL );
+#ifdef __LINUX__
+    /* the buffer of a file is st_blksize sized, at most 64K */
+    VERIFY( fstat( fileno( fp ), &st ) == 0 );
+    size = st.st_blksize;
+    if( size < BUFSIZ )
+        size = BUFSIZ;
+    if( size > 0x10000 )
+        size = 0x10000;
+#else
+    size = BUFSIZ;
+#endif
+    VERIFY( (buff = malloc( 2 * size + 1 )) != NULL );
+    for( i = 0; i < size - 1; i++ ) {
+        VERIFY( putc_unlocked( 'x', fp ) == 'x' );
+    }
+    VERIFY( fread( buff, 1, 2 * size + 1, fpr ) == 0 );
+    VERIFY( putc_unlocked( 'y', fp ) == 'y' );
+    rewind( fpr );
+    VERIFY( fread( buff, 1, 2 * size + 1, fpr ) == size );
+    VERIFY( buff[size - 2] == 'x' && buff[size - 1] == 'y' );
+    VERIFY( fwrite_unlocked( buff, 1, size - 1, fp ) == size - 1 );
+    rewind( fpr );
+    VERIFY( fread( buff, 1, 2 * size + 1, fpr ) == size );
+    VERIFY( fwrite_unlocked( "y", 1, 1, fp ) == 1 );
+    rewind( fpr );
+    VERIFY( fread( buff, 1, 2 * size + 1, fpr ) == 2 * size );
+    free( buff );
+
+    fclose( fpr );
+    fclose( fp );
+    EXPECT( remove( filename ) == 0 );
+
+    return( 1 );
+}
+
 
 int main( int argc, char *argv[] )
 /********************************/
@@ -749,6 +842,7 @@ int main( int argc, char *argv[] )
     Test_setbuf( );
     Test_setvbuf( );
     Test_ungetc( );
+    Test_unlocked( );
 
     fprintf( old_stdout, "Tests completed (%s).\n", strlwr( argv[0] ) );
     fclose( old_stdout );
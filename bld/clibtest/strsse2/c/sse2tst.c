@@ -0,0 +1,423 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Check the block string and memory functions against
+*               byte-at-a-time results for every alignment.
+*
+****************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined( __NT__ )
+    #include <windows.h>
+#elif defined( __LINUX__ )
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+#ifdef __SW_BW
+    #include <wdefwin.h>
+#endif
+
+/* call the library functions, not their inline forms */
+#pragma function( strlen, strchr, strcmp, memchr, memcmp )
+
+#define VERIFY( exp ) \
+    if( !(exp) ) {                                          \
+        printf( "%s: ***FAILURE*** at line %d of %s.\n",    \
+                ProgramName, __LINE__,                      \
+                strlwr(__FILE__) );                         \
+        NumErrors++;                                        \
+        exit( EXIT_FAILURE );                               \
+    }
+
+/*
+ * The SSE2 versions are only used by the flat 386 NT and Linux libraries.
+ * There the test runs once with them and once with the byte loops, and
+ * also checks operands that end right before an inaccessible page.
+ */
+#if defined( __386__ ) && ( defined( __NT__ ) || defined( __LINUX__ ) )
+    #define SSE2_SWITCH
+    #define PAGE_END_TEST
+#endif
+
+/*
+ * Strings are built from the bytes 0x01 to 0x7f, so that none repeats
+ * within MAX_LEN bytes, flipping the top bit always gives a different
+ * non-nul byte and NOT_THERE is never part of a string.
+ */
+#define MAX_LEN         80
+#define BUF_SIZE        ( 16 + MAX_LEN + 1 + 16 )
+#define NOT_THERE       0xff
+
+#define SIGN( x )       ( ( (x) > 0 ) - ( (x) < 0 ) )
+
+#ifdef SSE2_SWITCH
+extern unsigned char    __sse2_present;
+#endif
+
+char ProgramName[128];                          /* executable filename */
+int NumErrors = 0;                              /* number of errors */
+
+static char             bufA[BUF_SIZE];
+static char             bufB[BUF_SIZE];
+
+/* lengths on both sides of the 16 byte steps */
+static const unsigned   lengths[] = {
+    0, 1, 2, 15, 16, 17, 31, 32, 33, 47, 48, 49, 63, 64, 65, 79, MAX_LEN
+};
+
+#define NUM_LENGTHS     ( sizeof( lengths ) / sizeof( lengths[0] ) )
+
+
+static void Fill( char *p, unsigned len, unsigned seed )
+{
+    unsigned    i;
+
+    for( i = 0; i < len; ++i ) {
+        p[i] = (char)( 1 + ( i + seed ) % 0x7f );
+    }
+}
+
+/*
+ * Put a string of len bytes at offset align of buf. The bytes before it
+ * and after its nul are NOT_THERE, so nothing may be found in them.
+ */
+static char *MakeString( char *buf, unsigned align, unsigned len, unsigned seed )
+{
+    char        *s;
+    unsigned    i;
+
+    for( i = 0; i < BUF_SIZE; ++i ) {
+        buf[i] = (char)NOT_THERE;
+    }
+    s = buf + align;
+    Fill( s, len, seed );
+    s[len] = '\0';
+    return( s );
+}
+
+static size_t RefStrlen( const char *s )
+{
+    size_t      len;
+
+    for( len = 0; s[len] != '\0'; ++len )
+        ;
+    return( len );
+}
+
+static int RefStrcmp( const char *s1, const char *s2 )
+{
+    const unsigned char *p1 = (const unsigned char *)s1;
+    const unsigned char *p2 = (const unsigned char *)s2;
+
+    while( *p1 == *p2 && *p1 != '\0' ) {
+        ++p1;
+        ++p2;
+    }
+    return( SIGN( *p1 - *p2 ) );
+}
+
+static int RefMemcmp( const void *s1, const void *s2, size_t n )
+{
+    const unsigned char *p1 = s1;
+    const unsigned char *p2 = s2;
+
+    for( ; n > 0; --n ) {
+        if( *p1 != *p2 )
+            return( SIGN( *p1 - *p2 ) );
+        ++p1;
+        ++p2;
+    }
+    return( 0 );
+}
+
+
+/****
+***** Test strlen() and strchr() for every start alignment and length.
+****/
+
+void TestScan( void )
+{
+    unsigned    align;
+    unsigned    len;
+    unsigned    pos;
+    char        *s;
+
+    for( align = 0; align < 16; ++align ) {
+        for( len = 0; len <= MAX_LEN; ++len ) {
+            s = MakeString( bufA, align, len, align + len );
+            /* a nul just before s must be ignored */
+            if( align > 0 ) {
+                s[-1] = '\0';
+            }
+            VERIFY( strlen( s ) == len );
+            VERIFY( strlen( s ) == RefStrlen( s ) );
+            VERIFY( strchr( s, NOT_THERE ) == NULL );
+            VERIFY( strchr( s, '\0' ) == s + len );
+            for( pos = 0; pos < len; ++pos ) {
+                VERIFY( strchr( s, s[pos] ) == s + pos );
+                /* c is converted to char */
+                VERIFY( strchr( s, 0x100 | (unsigned char)s[pos] ) == s + pos );
+            }
+        }
+    }
+}
+
+
+/****
+***** Test memchr() for every start alignment and length.
+****/
+
+void TestMemchr( void )
+{
+    unsigned    align;
+    unsigned    len;
+    unsigned    pos;
+    char        *s;
+
+    for( align = 0; align < 16; ++align ) {
+        for( len = 0; len <= MAX_LEN; ++len ) {
+            s = MakeString( bufA, align, len, align * 3 + len );
+            /* NOT_THERE lies on both sides of s, and the nul follows it */
+            VERIFY( memchr( s, NOT_THERE, len ) == NULL );
+            VERIFY( memchr( s, '\0', len ) == NULL );
+            VERIFY( memchr( s, '\0', len + 1 ) == s + len );
+            for( pos = 0; pos < len; ++pos ) {
+                VERIFY( memchr( s, s[pos], len ) == s + pos );
+                VERIFY( memchr( s, s[pos], pos ) == NULL );
+#ifdef _M_IX86
+                /* c is converted to unsigned char */
+                VERIFY( memchr( s, 0x100 | (unsigned char)s[pos], len ) == s + pos );
+#endif
+            }
+        }
+    }
+}
+
+
+/****
+***** Test strcmp() and memcmp() for every pair of alignments.
+****/
+
+void TestCompare( void )
+{
+    unsigned    align1;
+    unsigned    align2;
+    unsigned    i;
+    unsigned    len;
+    unsigned    pos;
+    char        *s1;
+    char        *s2;
+    char        save;
+
+    for( align1 = 0; align1 < 16; ++align1 ) {
+        for( align2 = 0; align2 < 16; ++align2 ) {
+            for( i = 0; i < NUM_LENGTHS; ++i ) {
+                len = lengths[i];
+                s1 = MakeString( bufA, align1, len, len );
+                s2 = MakeString( bufB, align2, len, len );
+                VERIFY( strcmp( s1, s2 ) == 0 );
+                VERIFY( memcmp( s1, s2, len ) == 0 );
+                VERIFY( memcmp( s1, s2, len + 1 ) == 0 );
+                for( pos = 0; pos < len; ++pos ) {
+                    save = s2[pos];
+                    /* a difference in the top bit must compare unsigned */
+                    s2[pos] ^= 0x80;
+                    VERIFY( SIGN( strcmp( s1, s2 ) ) == -1 );
+                    VERIFY( SIGN( strcmp( s2, s1 ) ) == 1 );
+                    VERIFY( SIGN( strcmp( s1, s2 ) ) == RefStrcmp( s1, s2 ) );
+                    VERIFY( SIGN( memcmp( s1, s2, len ) ) == -1 );
+                    VERIFY( SIGN( memcmp( s2, s1, len ) ) == 1 );
+                    VERIFY( SIGN( memcmp( s1, s2, len ) ) == RefMemcmp( s1, s2, len ) );
+                    VERIFY( memcmp( s1, s2, pos ) == 0 );
+                    /* s2 ends early */
+                    s2[pos] = '\0';
+                    VERIFY( SIGN( strcmp( s1, s2 ) ) == 1 );
+                    VERIFY( SIGN( strcmp( s2, s1 ) ) == -1 );
+                    s2[pos] = save;
+                }
+            }
+        }
+    }
+}
+
+
+#ifdef PAGE_END_TEST
+
+/****
+***** Test operands that end just before an inaccessible page.
+****/
+
+/*
+ * Return the end of a readable page that is followed by one that can't be
+ * touched.
+ */
+static char *GuardedPageEnd( void )
+{
+    char            *p;
+    size_t          page;
+#ifdef __NT__
+    SYSTEM_INFO     si;
+    DWORD           old;
+
+    GetSystemInfo( &si );
+    page = si.dwPageSize;
+    p = VirtualAlloc( NULL, 2 * page, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+    if( p == NULL )
+        return( NULL );
+    if( !VirtualProtect( p + page, page, PAGE_NOACCESS, &old ) )
+        return( NULL );
+#else
+    page = sysconf( _SC_PAGESIZE );
+    p = mmap( NULL, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if( p == MAP_FAILED )
+        return( NULL );
+    if( mprotect( p + page, page, PROT_NONE ) != 0 )
+        return( NULL );
+#endif
+    return( p + page );
+}
+
+void TestPageEnd( void )
+{
+    static char *endA = NULL;
+    static char *endB = NULL;
+    unsigned    len;
+    char        *s1;
+    char        *s2;
+
+    if( endA == NULL ) {
+        endA = GuardedPageEnd();
+        endB = GuardedPageEnd();
+        VERIFY( endA != NULL && endB != NULL );
+    }
+    for( len = 0; len <= MAX_LEN; ++len ) {
+        /* the nul is the last readable byte */
+        s1 = endA - len - 1;
+        s2 = endB - len - 1;
+        Fill( s1, len, len );
+        Fill( s2, len, len );
+        s1[len] = '\0';
+        s2[len] = '\0';
+        VERIFY( strlen( s1 ) == len );
+        VERIFY( strchr( s1, NOT_THERE ) == NULL );
+        VERIFY( strchr( s1, '\0' ) == s1 + len );
+        VERIFY( strcmp( s1, s2 ) == 0 );
+        if( len > 0 ) {
+            s2[len - 1] ^= 0x80;
+            VERIFY( SIGN( strcmp( s1, s2 ) ) == -1 );
+            VERIFY( SIGN( strcmp( s2, s1 ) ) == 1 );
+            s2[len - 1] ^= 0x80;
+        }
+        /* a block of len bytes with no nul that ends at the page end */
+        s1 = endA - len;
+        s2 = endB - len;
+        Fill( s1, len, len );
+        Fill( s2, len, len );
+        VERIFY( memchr( s1, NOT_THERE, len ) == NULL );
+        VERIFY( memcmp( s1, s2, len ) == 0 );
+        if( len > 0 ) {
+            VERIFY( memchr( s1, s1[len - 1], len ) == s1 + len - 1 );
+            s2[len - 1] ^= 0x80;
+            VERIFY( SIGN( memcmp( s1, s2, len ) ) == -1 );
+            s2[len - 1] ^= 0x80;
+        }
+    }
+}
+
+#endif
+
+
+void TestAll( void )
+{
+    TestScan();
+    TestMemchr();
+    TestCompare();
+#ifdef PAGE_END_TEST
+    TestPageEnd();
+#endif
+}
+
+
+/****
+***** Program entry point.
+****/
+
+int main( int argc, char *argv[] )
+{
+#ifdef SSE2_SWITCH
+    unsigned char   sse2;
+#endif
+#ifdef __SW_BW
+    FILE            *my_stdout;
+
+    my_stdout = freopen( "tmp.log", "a", stdout );
+    if( my_stdout == NULL ) {
+        fprintf( stderr, "Unable to redirect stdout\n" );
+        return( EXIT_FAILURE );
+    }
+#endif
+
+    /* unused parameters */ (void)argc;
+
+    /*** Initialize ***/
+    strcpy( ProgramName, strlwr( argv[0] ) );   /* store filename */
+
+    /*** Test the functions ***/
+    TestAll();
+#ifdef SSE2_SWITCH
+    /* the pass above used SSE2 if the CPU has it, so check the byte loops */
+    sse2 = __sse2_present;
+    if( sse2 ) {
+        __sse2_present = 0;
+        TestAll();
+        __sse2_present = sse2;
+    }
+#endif
+
+    /*** Print a pass/fail message and quit ***/
+    if( NumErrors != 0 ) {
+        printf( "%s: FAILURE (%d errors).\n", ProgramName, NumErrors );
+    } else {
+        printf( "Tests completed (%s).\n", ProgramName );
+    }
+#ifdef __SW_BW
+    if( NumErrors != 0 ) {
+        fprintf( stderr, "%s: FAILURE (%d errors).\n", ProgramName, NumErrors );
+    } else {
+        fprintf( stderr, "Tests completed (%s).\n", ProgramName );
+    }
+    fclose( my_stdout );
+    _dwShutDown();
+#endif
+
+    if( NumErrors != 0 )
+        return( EXIT_FAILURE );
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,40 @@
+#include "fail.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Variadic arguments and ## placemarkers in macro replacement lists */
+
+int x = 1;
+int v( int a ) { return( a * 3 ); }
+int sum( int a, int b ) { return( a + b ); }
+
+#define x           x + 1
+#define v(...)      __VA_ARGS__
+#define str(...)    #__VA_ARGS__
+#define xstr(...)   str(__VA_ARGS__)
+#define LP          (
+
+/* tokens after an empty ## operand used to be lost */
+#define m(a,b)      a##b + 3
+int k = 1 m(,);
+
+int main( void ) {
+    /* a self-referential macro in a variadic argument expands once */
+    if( sum( v( x, x ) ) != 4 )
+        fail(__LINE__);
+    if( v( x ) != 2 )
+        fail(__LINE__);
+    if( strcmp( xstr( v( x ) ), "x + 1" ) != 0 )
+        fail(__LINE__);
+    if( strcmp( xstr( v( x, x ) ), "x + 1, x + 1" ) != 0 )
+        fail(__LINE__);
+    if( strcmp( xstr( m(,) ), "+ 3" ) != 0 )
+        fail(__LINE__);
+    if( k != 4 )
+        fail(__LINE__);
+    /* the inner v is not followed by ( until LP expands */
+    if( v( v LP 2 ) ) != 6 )
+        fail(__LINE__);
+
+    _PASS;
+}
@@ -0,0 +1,6 @@
+#define X 1
+int a = X;
+#warning first
+int b;
+#error second
+int c;
@@ -0,0 +1,9 @@
+char buf[32];
+
+void f2( const char *s )
+{
+    char    *d;
+
+    for( d = buf; (*d++ = *s++) != '\0'; )
+        ;
+}
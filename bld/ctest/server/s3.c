@@ -0,0 +1,16 @@
+struct pt {
+    int x;
+    int y;
+};
+
+int f3( struct pt *p, int n )
+{
+    int i;
+    int sum;
+
+    sum = 0;
+    for( i = 0; i < n; i++ ) {
+        sum += p[i].x * p[i].y;
+    }
+    return( sum );
+}
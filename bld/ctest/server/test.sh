@@ -0,0 +1,107 @@
+#!/bin/sh
+
+OWVERBOSE=0
+ERRORS=0
+
+usage() {
+    echo usage: $0 compiler errorfile
+    exit
+}
+
+print_header() {
+    echo \# -------------------------------
+    echo \#   Compile Server Test $TEST
+    echo \# -------------------------------
+}
+
+same_objects() {
+    for f in s1 s2 s3; do
+        cmp -s $f.o local/$f.o || return 1
+    done
+}
+
+do_check() {
+    if [ "$?" -eq "0" ]; then
+        echo \#      Test $1 successful
+    else
+        echo \#\# SERVER $TEST \#\# >> $LOGFILE
+        echo Error: Test $1 unsuccessful!!! | tee -a $LOGFILE
+        ERRORS=1
+    fi
+}
+
+if [ -z "$2" ]; then
+    usage
+fi
+
+CC=$1
+LOGFILE=$2
+SOCKDIR=`pwd`/sock
+
+echo \# ===========================
+echo \# Compile Server Tests
+echo \# ===========================
+
+rm -rf $SOCKDIR local
+mkdir $SOCKDIR local
+$CC --server=$SOCKDIR &
+SERVER=$!
+sleep 1
+
+TEST=01
+print_header
+# one worker runs several compiles in a row
+for f in s1 s2 s3 s1 s2 s3; do
+    OWSERVER=$SOCKDIR $CC -zq $f.c
+done
+(cd local; for f in s1 s2 s3; do $CC -zq ../$f.c; done)
+same_objects
+do_check a
+
+TEST=02
+print_header
+rm -f s1.o s2.o s3.o
+PIDS=
+for f in s1 s2 s3; do
+    OWSERVER=$SOCKDIR $CC -zq $f.c &
+    PIDS="$PIDS $!"
+done
+wait $PIDS
+same_objects
+do_check a
+
+TEST=03
+print_header
+# messages come back between the lines written to standard output,
+# a second listing from the same worker still reaches standard output
+OWSERVER=$SOCKDIR $CC -zq -pl order.c > order.lst 2>&1
+test "$?" -ne "0"
+do_check a
+diff -b order.chk order.lst
+do_check b
+OWSERVER=$SOCKDIR $CC -zq -pl order.c 2> order.lst > order.out
+grep -c "order.c(" order.lst | grep -q "^2$"
+do_check c
+grep -q "^int c;" order.out
+do_check d
+
+TEST=04
+print_header
+# the socket is accessible to its owner only
+ls -l $SOCKDIR | grep "\.sock$" | grep -q "^srwx------"
+do_check a
+
+TEST=05
+print_header
+kill $SERVER
+wait $SERVER
+do_check a
+test -z "`ls $SOCKDIR`"
+do_check b
+
+rm -rf $SOCKDIR local
+rm -f s1.o s2.o s3.o order.lst order.out order.err
+
+if [ "$ERRORS" -eq "0" ]; then
+    echo \# Compile Server tests successful
+fi
@@ -168,7 +168,9 @@ static dip_client_routines DIPClientInterface = {
     DIGCli( Close ),
     DIGCli( Remove ),
     DIPCli( Status ),
-    DIPCli( CurrArch )
+    DIPCli( CurrArch ),
+    DIPCli( MapView ),
+    DIPCli( UnmapView )
 };
 
 
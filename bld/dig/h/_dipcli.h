@@ -38,3 +38,5 @@ pick( dip_status,       SameAddrSpace,  ( address, address ) )
 pick( void,             AddrSection,    ( address * ) )
 pick( void,             Status,         ( dip_status ) )
 pick( dig_arch,         CurrArch,       ( void ) )
+pick( void *,           MapView,        ( FILE *, unsigned long, unsigned long ) )
+pick( void,             UnmapView,      ( void *, unsigned long ) )
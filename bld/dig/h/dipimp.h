@@ -172,6 +172,8 @@ typedef struct dip_client_routines {
 
     _DIPCli( Status );
     _DIPCli( CurrArch );
+    _DIPCli( MapView );
+    _DIPCli( UnmapView );
 
 } dip_client_routines;
 
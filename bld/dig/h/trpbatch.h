@@ -0,0 +1,89 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Batched trap requests supplementary service.
+*
+****************************************************************************/
+
+
+#ifndef TRPBATCH_H
+#define TRPBATCH_H
+
+#include "trptypes.h"
+
+#define BATCH_SUPP_NAME     Batch
+#define TRAP_BATCH(s)       TRAP_SYM( BATCH_SUPP_NAME, s )
+
+/*
+ * The service is provided by the remote server itself, not by the trap
+ * file, so its handle can not clash with the trap file handles.
+ * A server which doesn't know it passes the query to the trap file
+ * and the debugger gets no handle back.
+ */
+#define BATCH_SUPP_ID       ((trap_shandle)-1)
+
+//#define REQ_BATCH_DEF(sym,func)
+#define REQ_BATCH_DEFS() \
+    REQ_BATCH_DEF( ACCESS, access )
+
+enum {
+    #define REQ_BATCH_DEF(sym,func)     REQ_BATCH_ ## sym,
+    REQ_BATCH_DEFS()
+    #undef REQ_BATCH_DEF
+};
+
+#include "pushpck1.h"
+
+/*=================== REQ_BATCH_ACCESS ===================*/
+/*
+ *  Perform several independent requests with one packet exchange.
+ *  The server performs the requests in order and stops at the first one
+ *  it can't perform, the debugger must do the rest one by one.
+ */
+typedef struct {
+    supp_prefix         supp;
+    trap_req            req;
+    unsigned_8          count;      /* number of requests */
+    /* followed by 'count' batch_access_entry, each followed by the request */
+} batch_access_req;
+
+typedef struct {
+    unsigned_16         in_len;     /* request size */
+    unsigned_16         out_len;    /* maximum reply size, 0 if no reply */
+} batch_access_entry;
+
+typedef struct {
+    unsigned_8          count;      /* number of requests performed */
+    /* followed by 'count' batch_access_result, each followed by the reply */
+} batch_access_ret;
+
+typedef struct {
+    unsigned_16         len;        /* reply size */
+} batch_access_result;
+
+#include "poppck.h"
+
+#endif
@@ -263,6 +263,23 @@ dig_arch DCCurrArch( void )
     return( DIPClient->CurrArch() );
 }
 
+void *DCMapView( FILE *fp, unsigned long offset, unsigned long size )
+{
+    /*
+     * check for old client
+     */
+    if( DIPClient->sizeof_struct <= offsetof(dip_client_routines,MapView) )
+        return( NULL );
+    return( DIPClient->MapView( fp, offset, size ) );
+}
+
+void DCUnmapView( void *view, unsigned long size )
+{
+    if( DIPClient->sizeof_struct <= offsetof(dip_client_routines,UnmapView) )
+        return;
+    DIPClient->UnmapView( view, size );
+}
+
 dip_status DIPIMPENTRY( OldTypeBase )(imp_image_handle *iih, imp_type_handle *ith, imp_type_handle *base_ith )
 {
     return( ImpInterface.TypeBase( iih, ith, base_ith, NULL, NULL ) );
@@ -155,3 +155,18 @@ dig_arch DIPCLIENTRY( CurrArch )( void )
     //dprintf(( "DIPCliCurrArch\n" ));
     return( DIG_ARCH_X86 ); ///@todo option!
 }
+
+void *DIPCLIENTRY( MapView )( FILE *fp, unsigned long offset, unsigned long size )
+{
+    /* unused parameters */ (void)fp; (void)offset; (void)size;
+
+    //dprintf(( "DIPCliMapView\n" ));
+    return( NULL );
+}
+
+void DIPCLIENTRY( UnmapView )( void *view, unsigned long size )
+{
+    /* unused parameters */ (void)view; (void)size;
+
+    //dprintf(( "DIPCliUnmapView\n" ));
+}
@@ -0,0 +1,398 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Global name hash cache file.
+*
+****************************************************************************/
+
+
+#include "dfdip.h"
+#include "dfld.h"
+#include "dfhash.h"
+#include "dfcache.h"
+#include "exeelf.h"
+
+
+/*
+ * The global name hash can be kept in a cache file in the directory
+ * named by WD_DWARF_CACHE. The file name is a hash of the image key, the
+ * whole key is kept in the file header and the symbols are kept as
+ * .debug_info offsets.
+ */
+
+#define INDEX_CACHE_ENV         "WD_DWARF_CACHE"
+#define INDEX_CACHE_SIGNATURE   0x49574457UL    /* "WDWI" */
+#define INDEX_CACHE_VERSION     3
+#define INDEX_CACHE_BUFSIZE     (4 * 1024)
+#define INDEX_CACHE_HASHBUF     (64 * 1024)     /* read size for the image hash */
+#define INDEX_CACHE_CHECKS      8               /* names checked on load */
+
+#define INDEX_CACHE_ID_BUILD    1               /* id is the ELF build-id */
+#define INDEX_CACHE_ID_HASH     2               /* id is a hash of the image */
+
+#define NT_GNU_BUILD_ID         3
+#define BUILD_ID_OWNER          "GNU"
+
+#define FNV_OFFSET_BASIS        2166136261UL
+#define FNV_PRIME               16777619UL
+#define FNV64_OFFSET_BASIS      0xcbf29ce484222325ULL
+#define FNV64_PRIME             0x100000001b3ULL
+
+#include "pushpck1.h"
+typedef struct {
+    uint_32             signature;
+    uint_32             version;
+    index_cache_key     key;
+    uint_32             count;
+} index_cache_header;
+
+typedef struct {
+    uint_32             offset;         /* .debug_info offset of symbol */
+    uint_16             len;            /* name length including '\0' */
+} index_cache_entry;
+#include "poppck.h"
+
+typedef struct {
+    imp_image_handle    *iih;
+    FILE                *fp;
+    char                *buff;
+    size_t              used;
+    bool                ok;
+} index_cache_wlk;
+
+static uint_32 FNVUpdate( uint_32 h, const void *data, size_t len )
+/*****************************************************************/
+{
+    const unsigned char *p = data;
+
+    while( len-- > 0 ) {
+        h ^= *p++;
+        h *= FNV_PRIME;
+    }
+    return( h );
+}
+
+
+static bool BuildIdKey( imp_image_handle *iih, index_cache_key *key )
+/********************************************************************
+ * Use the GNU build-id note of the image if it has one
+ */
+{
+    dwarf_info      *dwarf;
+    unsigned char   *buff;
+    Elf_Note        note;
+    unsigned long   size;
+    bool            ok;
+
+    dwarf = iih->dwarf;
+    size = dwarf->build_id_size;
+    if( size < sizeof( note ) + sizeof( BUILD_ID_OWNER ) || size > INDEX_CACHE_BUFSIZE )
+        return( false );
+    buff = DCAlloc( size );
+    if( buff == NULL )
+        return( false );
+    ok = false;
+    if( DCReadAt( iih->sym_fp, buff, size, dwarf->build_id_offset ) == DS_OK ) {
+        memcpy( &note, buff, sizeof( note ) );
+        if( iih->is_byteswapped ) {
+            SWAP_32( note.n_namesz );
+            SWAP_32( note.n_descsz );
+            SWAP_32( note.n_type );
+        }
+        if( note.n_type == NT_GNU_BUILD_ID
+          && note.n_namesz == sizeof( BUILD_ID_OWNER )
+          && memcmp( buff + sizeof( note ), BUILD_ID_OWNER, sizeof( BUILD_ID_OWNER ) ) == 0
+          && note.n_descsz > 0
+          && note.n_descsz <= INDEX_CACHE_ID_MAX
+          && note.n_descsz <= size - sizeof( note ) - sizeof( BUILD_ID_OWNER ) ) {
+            key->id_kind = INDEX_CACHE_ID_BUILD;
+            key->id_len = note.n_descsz;
+            memcpy( key->id, buff + sizeof( note ) + sizeof( BUILD_ID_OWNER ), note.n_descsz );
+            ok = true;
+        }
+    }
+    DCFree( buff );
+    return( ok );
+}
+
+
+static bool ImageHashKey( imp_image_handle *iih, index_cache_key *key )
+/**********************************************************************
+ * 64-bit FNV-1a hash of the whole image, any rebuild changes it
+ */
+{
+    unsigned char   *buff;
+    unsigned long   left;
+    unsigned long   pos;
+    size_t          len;
+    size_t          i;
+    uint_64         h;
+
+    buff = DCAlloc( INDEX_CACHE_HASHBUF );
+    if( buff == NULL )
+        return( false );
+    h = FNV64_OFFSET_BASIS;
+    pos = 0;
+    for( left = key->image_size; left > 0; left -= len ) {
+        len = INDEX_CACHE_HASHBUF;
+        if( len > left )
+            len = left;
+        if( DCReadAt( iih->sym_fp, buff, len, pos ) != DS_OK ) {
+            DCFree( buff );
+            return( false );
+        }
+        for( i = 0; i < len; ++i ) {
+            h ^= buff[i];
+            h *= FNV64_PRIME;
+        }
+        pos += len;
+    }
+    DCFree( buff );
+    key->id_kind = INDEX_CACHE_ID_HASH;
+    key->id_len = sizeof( h );
+    memcpy( key->id, &h, sizeof( h ) );
+    return( true );
+}
+
+
+static bool IndexCacheKey( imp_image_handle *iih, index_cache_key *key )
+/***********************************************************************
+ * Image size, DWARF section table and the build-id or the image hash
+ */
+{
+    dwarf_info      *dwarf;
+    unsigned        i;
+
+    if( DCSeek( iih->sym_fp, 0, DIG_SEEK_END ) )
+        return( false );
+    memset( key, 0, sizeof( *key ) );
+    key->image_size = DCTell( iih->sym_fp );
+    dwarf = iih->dwarf;
+    for( i = 0; i < DR_DEBUG_NUM_SECTS; ++i ) {
+        key->sect_offsets[i] = dwarf->sect_offsets[i];
+        key->sect_sizes[i] = dwarf->sect_sizes[i];
+    }
+    return( BuildIdKey( iih, key ) || ImageHashKey( iih, key ) );
+}
+
+
+char *IndexCacheName( imp_image_handle *iih, index_cache_key *key )
+/******************************************************************
+ * Name of the cache file of the image, NULL if no cache is used
+ */
+{
+    const char  *dir;
+    char        *name;
+    uint_32     h;
+
+    dir = getenv( INDEX_CACHE_ENV );
+    if( dir == NULL || *dir == '\0' )
+        return( NULL );
+    if( !IndexCacheKey( iih, key ) )
+        return( NULL );
+    h = FNVUpdate( FNV_OFFSET_BASIS, key, sizeof( *key ) );
+    name = DCAlloc( strlen( dir ) + 1 + 8 + 4 + 1 );
+    if( name != NULL ) {
+        sprintf( name, "%s/%8.8lx.dwi", dir, (unsigned long)h );
+    }
+    return( name );
+}
+
+
+static bool CheckName( drmem_hdl sym, const char *name )
+/*******************************************************
+ * Check a cached name against the DWARF entry it points to. Names from
+ * .debug_pubnames may be qualified, the entry only has the last part.
+ */
+{
+    char        *die_name;
+    size_t      len;
+    size_t      die_len;
+    bool        ok;
+
+    die_name = DRGetName( sym );
+    if( die_name == NULL )
+        return( false );
+    len = strlen( name );
+    die_len = strlen( die_name );
+    ok = false;
+    if( die_len <= len && strcmp( name + len - die_len, die_name ) == 0 ) {
+        if( die_len == len ) {
+            ok = true;
+        } else if( die_len + 2 <= len && memcmp( name + len - die_len - 2, "::", 2 ) == 0 ) {
+            ok = true;
+        }
+    }
+    DCFree( die_name );
+    return( ok );
+}
+
+
+bool LoadIndexCache( imp_image_handle *iih, const char *name, const index_cache_key *key )
+/*****************************************************************************************
+ * Fill the name hash from the cache file, the whole file is read at once.
+ * A few of the names are checked against the DWARF before the file is
+ * trusted.
+ */
+{
+    FILE                *fp;
+    index_cache_header  head;
+    index_cache_entry   entry;
+    unsigned long       size;
+    unsigned long       info_size;
+    char                *buff;
+    char                *pos;
+    char                *end;
+    drmem_hdl           sym;
+    uint_32             i;
+    uint_32             step;
+
+    fp = DCOpen( name, DIG_OPEN_READ | DIG_OPEN_LOCAL );
+    if( fp == NULL )
+        return( false );
+    buff = NULL;
+    if( DCRead( fp, &head, sizeof( head ) ) == sizeof( head )
+      && head.signature == INDEX_CACHE_SIGNATURE
+      && head.version == INDEX_CACHE_VERSION
+      && memcmp( &head.key, key, sizeof( *key ) ) == 0
+      && DCSeek( fp, 0, DIG_SEEK_END ) == 0 ) {
+        size = DCTell( fp ) - sizeof( head );
+        buff = DCAlloc( size );
+        if( buff != NULL ) {
+            DCSeek( fp, sizeof( head ), DIG_SEEK_ORG );
+            if( DCRead( fp, buff, size ) != size ) {
+                DCFree( buff );
+                buff = NULL;
+            }
+        }
+    }
+    DCClose( fp );
+    if( buff == NULL )
+        return( false );
+    info_size = iih->dwarf->sect_sizes[DR_DEBUG_INFO];
+    step = head.count / INDEX_CACHE_CHECKS + 1;
+    pos = buff;
+    end = buff + size;
+    for( i = 0; i < head.count; ++i ) {
+        if( (size_t)( end - pos ) < sizeof( entry ) )
+            break;
+        memcpy( &entry, pos, sizeof( entry ) );
+        pos += sizeof( entry );
+        if( entry.offset >= info_size || entry.len == 0 || (size_t)( end - pos ) < entry.len || pos[entry.len - 1] != '\0' )
+            break;
+        sym = DRGetInfoHandle( entry.offset );
+        if( i % step == 0 && !CheckName( sym, pos ) )
+            break;
+        AddHashName( iih->name_map, pos, sym );
+        pos += entry.len;
+    }
+    DCFree( buff );
+    if( i < head.count || pos != end ) {
+        /* damaged or stale cache file, throw away whatever got loaded */
+        FiniHashName( iih->name_map );
+        iih->name_map = InitHashName();
+        return( false );
+    }
+    return( true );
+}
+
+
+static bool IndexCacheFlush( index_cache_wlk *wlk )
+/*************************************************/
+{
+    if( wlk->ok && wlk->used > 0 ) {
+        if( DCWrite( wlk->fp, wlk->buff, wlk->used ) != wlk->used ) {
+            wlk->ok = false;
+        }
+    }
+    wlk->used = 0;
+    return( wlk->ok );
+}
+
+
+static bool AIndexCacheEntry( void *_wlk, drmem_hdl sym, const char *name )
+/*************************************************************************/
+{
+    index_cache_wlk     *wlk = _wlk;
+    index_cache_entry   entry;
+    size_t              len;
+
+    len = strlen( name ) + 1;
+    if( len > INDEX_CACHE_BUFSIZE - sizeof( entry ) ) {
+        /* silly long name, just drop the cache */
+        wlk->ok = false;
+        return( false );
+    }
+    if( wlk->used + sizeof( entry ) + len > INDEX_CACHE_BUFSIZE ) {
+        if( !IndexCacheFlush( wlk ) ) {
+            return( false );
+        }
+    }
+    entry.offset = DRGetInfoOffset( sym );
+    entry.len = (uint_16)len;
+    memcpy( wlk->buff + wlk->used, &entry, sizeof( entry ) );
+    wlk->used += sizeof( entry );
+    memcpy( wlk->buff + wlk->used, name, len );
+    wlk->used += len;
+    return( true );
+}
+
+
+void SaveIndexCache( imp_image_handle *iih, const char *name, const index_cache_key *key )
+/*****************************************************************************************
+ * Write the name hash out to the cache file
+ */
+{
+    index_cache_header  head;
+    index_cache_wlk     data;
+    name_wlk            wlk;
+
+    data.buff = DCAlloc( INDEX_CACHE_BUFSIZE );
+    if( data.buff == NULL )
+        return;
+    data.fp = DCOpen( name, DIG_OPEN_WRITE | DIG_OPEN_CREATE | DIG_OPEN_TRUNC | DIG_OPEN_LOCAL );
+    if( data.fp != NULL ) {
+        head.signature = INDEX_CACHE_SIGNATURE;
+        head.version = INDEX_CACHE_VERSION;
+        head.key = *key;
+        head.count = HashNameCount( iih->name_map );
+        data.iih = iih;
+        data.used = 0;
+        data.ok = ( DCWrite( data.fp, &head, sizeof( head ) ) == sizeof( head ) );
+        if( data.ok ) {
+            wlk.fn = AIndexCacheEntry;
+            wlk.name = NULL;
+            wlk.d = &data;
+            WalkHashNames( iih->name_map, &wlk );
+            IndexCacheFlush( &data );
+        }
+        DCClose( data.fp );
+        if( !data.ok ) {
+            DCRemove( name, DIG_OPEN_LOCAL );
+        }
+    }
+    DCFree( data.buff );
+}
@@ -270,3 +270,51 @@ bool FindHashWalk( name_ctl *ctl, name_wlk *wlk )
     }
     return( true );
 }
+
+
+static bool WalkNameBlk( name_blk *blk, uint_16 count, name_wlk *wlk )
+/*********************************************************************
+ * Walk a bucket chain oldest block first so entries come out in the
+ * order they were added
+ */
+{
+    name_entry  *curr;
+
+    if( blk->next != NULL ) {
+        if( !WalkNameBlk( blk->next, NAME_BLKSIZE, wlk ) ) {
+            return( false );
+        }
+    }
+    for( curr = &blk->entry[0]; count > 0; --count ) {
+        if( !wlk->fn( wlk->d, curr->sym, curr->name ) ) {
+            return( false );
+        }
+        ++curr;
+    }
+    return( true );
+}
+
+
+bool WalkHashNames( name_ctl *ctl, name_wlk *wlk )
+/*************************************************
+ * Walk all entries of the hash
+ */
+{
+    int         bnum;
+
+    for( bnum = 0; bnum < NAME_BUCKETS; ++bnum ) {
+        if( ctl->bucket[bnum].head != NULL ) {
+            if( !WalkNameBlk( ctl->bucket[bnum].head, NAME_BLKSIZE - ctl->bucket[bnum].rem, wlk ) ) {
+                return( false );
+            }
+        }
+    }
+    return( true );
+}
+
+
+unsigned HashNameCount( name_ctl *ctl )
+/*************************************/
+{
+    return( ctl->count );
+}
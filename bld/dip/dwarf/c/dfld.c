@@ -40,6 +40,9 @@
 #include "dfscope.h"
 #include "dfmisc.h"
 #include "dfhash.h"
+#ifdef USE_INDEX_CACHE
+#include "dfcache.h"
+#endif
 #include "exeelf.h"
 #include "tistrail.h"
 
@@ -60,6 +63,8 @@ static char const * const SectionNames[DR_DEBUG_NUM_SECTS] = {
     ".WATCOM_references"
 };
 
+#define BUILD_ID_SECTION    ".note.gnu.build-id"
+
 static uint Lookup_section_name( const char *name )
 /******************************************/
 {
@@ -92,9 +97,10 @@ static void ByteSwapShdr( Elf32_Shdr *elf_sec, bool byteswap )
 }
 
 
-static dip_status GetSectInfo( FILE *fp, unsigned long *sizes, unsigned long *bases, bool *byteswap )
-/****************************************************************************************************
- * Fill in the starting offset & length of the dwarf sections
+static dip_status GetSectInfo( FILE *fp, dwarf_info *dwarf, bool *byteswap )
+/****************************************************************************
+ * Fill in the starting offset & length of the dwarf sections and of the
+ * build-id note
  */
 {
     TISTrailer          dbg_head;
@@ -105,7 +111,11 @@ static dip_status GetSectInfo( FILE *fp, unsigned long *sizes, unsigned long *ba
     char                *string_table;
     int                 i;
     uint                sect;
+    unsigned long       *sizes;
+    unsigned long       *bases;
 
+    sizes = dwarf->sect_sizes;
+    bases = dwarf->sect_offsets;
     // Find TIS header seek to elf header
     if( DCSeek( fp, DIG_SEEK_POSBACK( sizeof( dbg_head ) ), DIG_SEEK_END ) )
         return( DS_FAIL );
@@ -171,6 +181,8 @@ static dip_status GetSectInfo( FILE *fp, unsigned long *sizes, unsigned long *ba
     }
     memset( bases, 0, DR_DEBUG_NUM_SECTS * sizeof( unsigned long ) );
     memset( sizes, 0, DR_DEBUG_NUM_SECTS * sizeof( unsigned long ) );
+    dwarf->build_id_offset = 0;
+    dwarf->build_id_size = 0;
     offset = elf_head.e_shoff + elf_head.e_shstrndx * elf_head.e_shentsize + start;
     DCSeek( fp, offset, DIG_SEEK_ORG );
     DCRead( fp, &elf_sec, sizeof( Elf32_Shdr ) );
@@ -186,6 +198,10 @@ static dip_status GetSectInfo( FILE *fp, unsigned long *sizes, unsigned long *ba
         if( sect < DR_DEBUG_NUM_SECTS ) {
             bases[sect] = elf_sec.sh_offset + start;
             sizes[sect] = elf_sec.sh_size;
+        } else if( elf_sec.sh_type == SHT_NOTE
+          && strcmp( &string_table[elf_sec.sh_name], BUILD_ID_SECTION ) == 0 ) {
+            dwarf->build_id_offset = elf_sec.sh_offset + start;
+            dwarf->build_id_size = elf_sec.sh_size;
         }
     }
     DCFree( string_table );
@@ -276,10 +292,69 @@ static void DWRErr( dr_except code )
 
 DWRSetRtns( DWRRead, DWRSeek, DWRAlloc, DWRRealloc, DWRFree, DWRErr );
 
+#if !defined( USE_VIRTMEM )
+
+static void UnmapSections( dwarf_info *dwarf )
+/********************************************/
+{
+    int             i;
+
+    for( i = 0; i < DR_DEBUG_NUM_SECTS; i++ ) {
+        if( dwarf->sect_views[i] != DRMEM_HDL_NULL ) {
+            DCUnmapView( dwarf->sect_views[i], dwarf->sect_sizes[i] );
+            dwarf->sect_views[i] = DRMEM_HDL_NULL;
+        }
+    }
+    dwarf->mapped = false;
+}
+
+
+static bool MapSections( FILE *fp, dwarf_info *dwarf )
+/*****************************************************
+ * map all the sections in place if the client can do it,
+ * it is all or nothing
+ */
+{
+    int             i;
+
+    dwarf->mapped = true;
+    for( i = 0; i < DR_DEBUG_NUM_SECTS; i++ ) {
+        dwarf->sect_views[i] = DRMEM_HDL_NULL;
+    }
+    for( i = 0; i < DR_DEBUG_NUM_SECTS; i++ ) {
+        if( dwarf->sect_sizes[i] != 0 ) {
+            dwarf->sect_views[i] = DCMapView( fp, dwarf->sect_offsets[i], dwarf->sect_sizes[i] );
+            if( dwarf->sect_views[i] == DRMEM_HDL_NULL ) {
+                UnmapSections( dwarf );
+                break;
+            }
+        }
+    }
+    return( dwarf->mapped );
+}
+
+#endif
+
+
+static dr_dbg_handle InitDrHandle( imp_image_handle *iih, dwarf_info *dwarf )
+/***************************************************************************/
+{
+#if !defined( USE_VIRTMEM )
+    dr_dbg_handle   handle;
+
+    if( MapSections( iih->sym_fp, dwarf ) ) {
+        handle = DRDbgInitMapNFT( iih, dwarf->sect_sizes, dwarf->sect_views, iih->is_byteswapped );
+        if( handle == NULL )
+            UnmapSections( dwarf );
+        return( handle );
+    }
+#endif
+    return( DRDbgInitNFT( iih, dwarf->sect_sizes, iih->is_byteswapped ) );
+}
+
 static dip_status InitDwarf( imp_image_handle *iih )
 /**************************************************/
 {
-    unsigned long   sect_sizes[DR_DEBUG_NUM_SECTS];
     dwarf_info      *dwarf;
     dip_status      ds;
 
@@ -287,11 +362,11 @@ static dip_status InitDwarf( imp_image_handle *iih )
     dwarf = DCAlloc( sizeof( *dwarf ) );
     if( dwarf != NULL ) {
         iih->dwarf = dwarf;
-        ds = GetSectInfo( iih->sym_fp, sect_sizes, dwarf->sect_offsets, &iih->is_byteswapped );
+        ds = GetSectInfo( iih->sym_fp, dwarf, &iih->is_byteswapped );
         if( ds == DS_OK ) {
-            dwarf->handle = DRDbgInitNFT( iih, sect_sizes, iih->is_byteswapped );
+            dwarf->handle = InitDrHandle( iih, dwarf );
             if( dwarf->handle != NULL ) {
-                iih->has_pubnames = ( sect_sizes[DR_DEBUG_PUBNAMES] > 0 );
+                iih->has_pubnames = ( dwarf->sect_sizes[DR_DEBUG_PUBNAMES] > 0 );
                 return( ds );
             }
             ds = DS_ERR | DS_NO_MEM;
@@ -315,6 +390,11 @@ static void FiniDwarf( imp_image_handle *iih )
     if( dwarf != NULL ) {
         DRDbgDone( dwarf->handle ); /* free the sections */
         DRDbgFini( dwarf->handle );
+#if !defined( USE_VIRTMEM )
+        if( dwarf->mapped ) {
+            UnmapSections( dwarf );
+        }
+#endif
         DCFree( dwarf );
         iih->dwarf = NULL;
 //      DRFini();
@@ -372,12 +452,9 @@ static walk_result ModGlbSymHash( imp_image_handle *iih, imp_mod_handle imh, voi
 }
 
 
-static void LoadGlbHash( imp_image_handle *iih )
-/***********************************************
- * Load a name hash of all the gobal symbols
- */
+static void BuildGlbHash( imp_image_handle *iih )
+/***********************************************/
 {
-    DRSetDebug( iih->dwarf->handle );    /* must do at each interface */
     if( iih->has_pubnames ) {
         DRWalkPubName( APubName, iih );
         DFWalkModListSrc( iih, false, ModGlbSymHash, NULL );
@@ -387,6 +464,36 @@ static void LoadGlbHash( imp_image_handle *iih )
 }
 
 
+void LoadGlbHash( imp_image_handle *iih )
+/****************************************
+ * Load a name hash of all the gobal symbols, it is done on the first
+ * global lookup rather than at image load
+ */
+{
+#ifdef USE_INDEX_CACHE
+    index_cache_key key;
+    char            *name;
+#endif
+
+    if( iih->name_map_loaded )
+        return;
+    iih->name_map_loaded = true;
+    DRSetDebug( iih->dwarf->handle );    /* must do at each interface */
+#ifdef USE_INDEX_CACHE
+    name = IndexCacheName( iih, &key );
+    if( name != NULL ) {
+        if( !LoadIndexCache( iih, name, &key ) ) {
+            BuildGlbHash( iih );
+            SaveIndexCache( iih, name, &key );
+        }
+        DCFree( name );
+        return;
+    }
+#endif
+    BuildGlbHash( iih );
+}
+
+
 dip_status DIPIMPENTRY( LoadInfo )( FILE *fp, imp_image_handle *iih )
 /*******************************************************************/
 {
@@ -399,7 +506,7 @@ dip_status DIPIMPENTRY( LoadInfo )( FILE *fp, imp_image_handle *iih )
         if( ds == DS_OK ) {
             InitImpCueInfo( iih );
             iih->name_map = InitHashName();
-            LoadGlbHash( iih );
+            iih->name_map_loaded = false;
             iih->dcmap = NULL;
             InitScope( &iih->scope );
             DFAddImage( iih );
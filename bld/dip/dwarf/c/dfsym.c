@@ -1671,6 +1671,7 @@ static search_result HashSearchGbl( imp_image_handle *iih,
     wlk.fn = AHashItem;
     wlk.name = data.name;
     wlk.d = &data;
+    LoadGlbHash( iih );
     DRSetDebug( iih->dwarf->handle );    /* must do at each call into DWARF */
     FindHashWalk( iih->name_map, &wlk );
     if( data.sym != DRMEM_HDL_NULL ) {
@@ -0,0 +1,52 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Global name hash cache file prototypes.
+*
+****************************************************************************/
+
+
+#define INDEX_CACHE_ID_MAX      32      /* longest image id kept */
+
+/*
+ * What a cache file must match to be used for an image: its size, where
+ * the DWARF sections are and either the ELF build-id or a hash of the
+ * whole image.
+ */
+#include "pushpck1.h"
+typedef struct {
+    uint_32             image_size;
+    uint_32             id_kind;
+    uint_32             id_len;
+    unsigned char       id[INDEX_CACHE_ID_MAX];
+    uint_32             sect_offsets[DR_DEBUG_NUM_SECTS];
+    uint_32             sect_sizes[DR_DEBUG_NUM_SECTS];
+} index_cache_key;
+#include "poppck.h"
+
+extern char *IndexCacheName( imp_image_handle *iih, index_cache_key *key );
+extern bool LoadIndexCache( imp_image_handle *iih, const char *name, const index_cache_key *key );
+extern void SaveIndexCache( imp_image_handle *iih, const char *name, const index_cache_key *key );
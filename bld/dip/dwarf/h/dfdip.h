@@ -170,6 +170,7 @@ struct imp_image_handle {
     scope_ctl           scope;
     addrmod             last;
     bool                has_pubnames;
+    bool                name_map_loaded;
     bool                is_byteswapped;
 };
 
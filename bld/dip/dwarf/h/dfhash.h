@@ -42,3 +42,5 @@ extern name_ctl *InitHashName( void );
 extern void     FiniHashName( name_ctl *ctl );
 extern void     AddHashName( name_ctl *ctl, const char *name, drmem_hdl sym );
 extern bool     FindHashWalk( name_ctl *ctl, name_wlk *wlk );
+extern bool     WalkHashNames( name_ctl *ctl, name_wlk *wlk );
+extern unsigned HashNameCount( name_ctl *ctl );
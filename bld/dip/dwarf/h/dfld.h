@@ -32,4 +32,13 @@
 struct dwarf_info {
     dr_dbg_handle   handle;
     unsigned long   sect_offsets[DR_DEBUG_NUM_SECTS];
+    unsigned long   sect_sizes[DR_DEBUG_NUM_SECTS];
+    unsigned long   build_id_offset;    /* .note.gnu.build-id section, */
+    unsigned long   build_id_size;      /* size 0 if there is none */
+#if !defined( USE_VIRTMEM )
+    drmem_hdl       sect_views[DR_DEBUG_NUM_SECTS];
+    bool            mapped;
+#endif
 };
+
+extern void     LoadGlbHash( imp_image_handle *iih );
@@ -0,0 +1,502 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Test of the DWARF global name hash cache file.
+*
+****************************************************************************/
+
+
+#include "dfdip.h"
+#include "dfld.h"
+#include "dfhash.h"
+#include "dfcache.h"
+#include "exeelf.h"
+
+
+#define IMAGE_NAME      "cachetst.img"
+#define NUM_NAMES       1000
+#define INFO_OFFSET     0x40
+#define INFO_SIZE       0x10000
+#define ABBREV_SIZE     0x800
+#define STR_SIZE        0x3000
+#define BUILD_ID_LEN    20
+/* signature, version, key and count come before the first entry */
+#define HEADER_SIZE     ( 3 * sizeof( uint_32 ) + sizeof( index_cache_key ) )
+
+#define VERIFY( exp ) \
+    if( !(exp) ) {                                          \
+        printf( "%s: ***FAILURE*** at line %d of %s.\n",    \
+                ProgramName, __LINE__, __FILE__ );          \
+        NumErrors++;                                        \
+        exit( EXIT_FAILURE );                               \
+    }
+
+static imp_image_handle iih;
+static dwarf_info       dwarf;
+
+char                    ProgramName[128];   /* executable filename */
+int                     NumErrors = 0;      /* number of errors */
+
+/*
+ * The client routines and DWARF library functions the cache code uses
+ */
+void *DCAlloc( size_t amount )
+{
+    return( malloc( amount ) );
+}
+
+void DCFree( void *p )
+{
+    free( p );
+}
+
+FILE *DCOpen( const char *path, dig_open mode )
+{
+    return( fopen( path, ( mode & DIG_OPEN_WRITE ) ? "wb" : "rb" ) );
+}
+
+int DCSeek( FILE *fp, unsigned long p, dig_seek where )
+{
+    return( fseek( fp, p, ( where == DIG_SEEK_END ) ? SEEK_END : SEEK_SET ) );
+}
+
+unsigned long DCTell( FILE *fp )
+{
+    return( ftell( fp ) );
+}
+
+size_t DCRead( FILE *fp, void *b, size_t s )
+{
+    return( fread( b, 1, s, fp ) );
+}
+
+dip_status DCReadAt( FILE *fp, void *b, size_t s, unsigned long p )
+{
+    if( DCSeek( fp, p, DIG_SEEK_ORG ) ) {
+        return( DS_ERR | DS_FSEEK_FAILED );
+    }
+    if( DCRead( fp, b, s ) != s ) {
+        return( DS_ERR | DS_FREAD_FAILED );
+    }
+    return( DS_OK );
+}
+
+size_t DCWrite( FILE *fp, const void *b, size_t s )
+{
+    return( fwrite( b, 1, s, fp ) );
+}
+
+void DCClose( FILE *fp )
+{
+    fclose( fp );
+}
+
+void DCRemove( const char *path, dig_open mode )
+{
+    /* unused parameters */ (void)mode;
+
+    remove( path );
+}
+
+drmem_hdl DRENTRY DRGetInfoHandle( unsigned long offset )
+{
+    return( (drmem_hdl)( dwarf.sect_offsets[DR_DEBUG_INFO] + offset ) );
+}
+
+unsigned long DRENTRY DRGetInfoOffset( drmem_hdl entry )
+{
+    return( (unsigned long)entry - dwarf.sect_offsets[DR_DEBUG_INFO] );
+}
+
+/* the entry at .debug_info offset i * 16 is named "sym<i>" */
+char * DRENTRY DRGetName( drmem_hdl entry )
+{
+    char    *name;
+
+    name = DCAlloc( 24 );
+    sprintf( name, "sym%lu", DRGetInfoOffset( entry ) / 16 );
+    return( name );
+}
+
+/*
+ * A fake image with the sections the cache key is made of, the
+ * section contents are just a pattern
+ */
+static void WriteImage( void )
+{
+    FILE            *fp;
+    unsigned long   i;
+    unsigned long   end;
+
+    dwarf.sect_offsets[DR_DEBUG_INFO] = INFO_OFFSET;
+    dwarf.sect_sizes[DR_DEBUG_INFO] = INFO_SIZE;
+    dwarf.sect_offsets[DR_DEBUG_ABBREV] = INFO_OFFSET + INFO_SIZE;
+    dwarf.sect_sizes[DR_DEBUG_ABBREV] = ABBREV_SIZE;
+    dwarf.sect_offsets[DR_DEBUG_STR] = INFO_OFFSET + INFO_SIZE + ABBREV_SIZE;
+    dwarf.sect_sizes[DR_DEBUG_STR] = STR_SIZE;
+    end = dwarf.sect_offsets[DR_DEBUG_STR] + STR_SIZE;
+    fp = fopen( IMAGE_NAME, "wb" );
+    for( i = 0; i < end; ++i ) {
+        fputc( (int)( i * 7 + i / 251 ), fp );
+    }
+    fclose( fp );
+    dwarf.build_id_offset = 0;
+    dwarf.build_id_size = 0;
+}
+
+/* Put a GNU build-id note at the start of the image */
+static void WriteBuildId( void )
+{
+    FILE            *fp;
+    Elf_Note        note;
+    unsigned        i;
+
+    note.n_namesz = 4;
+    note.n_descsz = BUILD_ID_LEN;
+    note.n_type = 3;
+    fp = fopen( IMAGE_NAME, "r+b" );
+    fwrite( &note, sizeof( note ), 1, fp );
+    fwrite( "GNU", 4, 1, fp );
+    for( i = 0; i < BUILD_ID_LEN; ++i ) {
+        fputc( 0xb0 + i, fp );
+    }
+    fclose( fp );
+    dwarf.build_id_offset = 0;
+    dwarf.build_id_size = sizeof( note ) + 4 + BUILD_ID_LEN;
+}
+
+static void PatchImage( unsigned long offset )
+{
+    FILE    *fp;
+    int     c;
+
+    fp = fopen( IMAGE_NAME, "r+b" );
+    fseek( fp, offset, SEEK_SET );
+    c = fgetc( fp );
+    fseek( fp, offset, SEEK_SET );
+    fputc( c ^ 0xff, fp );
+    fclose( fp );
+}
+
+static void OpenImage( void )
+{
+    iih.sym_fp = fopen( IMAGE_NAME, "rb" );
+    iih.dwarf = &dwarf;
+    iih.name_map = InitHashName();
+}
+
+static void CloseImage( void )
+{
+    FiniHashName( iih.name_map );
+    fclose( iih.sym_fp );
+}
+
+/* every third name is qualified, as C++ names in .debug_pubnames are */
+static void BuildNames( void )
+{
+    char        name[16];
+    unsigned    i;
+
+    for( i = 0; i < NUM_NAMES; ++i ) {
+        sprintf( name, ( i % 3 ) ? "sym%u" : "ns::sym%u", i );
+        AddHashName( iih.name_map, name, DRGetInfoHandle( i * 16 ) );
+    }
+}
+
+static bool ACheckName( void *d, drmem_hdl sym, const char *name )
+{
+    unsigned char   *seen = d;
+    unsigned        i;
+    char            expect[16];
+
+    i = DRGetInfoOffset( sym ) / 16;
+    if( i >= NUM_NAMES || seen[i] || DRGetInfoOffset( sym ) != i * 16 )
+        return( false );
+    sprintf( expect, ( i % 3 ) ? "sym%u" : "ns::sym%u", i );
+    if( strcmp( name, expect ) != 0 )
+        return( false );
+    seen[i] = 1;
+    return( true );
+}
+
+static bool CheckNames( void )
+{
+    unsigned char   seen[NUM_NAMES];
+    name_wlk        wlk;
+
+    memset( seen, 0, sizeof( seen ) );
+    wlk.fn = ACheckName;
+    wlk.name = NULL;
+    wlk.d = seen;
+    return( HashNameCount( iih.name_map ) == NUM_NAMES && WalkHashNames( iih.name_map, &wlk ) );
+}
+
+/* Load the cache of the current image, build and save it on a miss */
+static bool LoadNames( char **name )
+{
+    index_cache_key key;
+
+    *name = IndexCacheName( &iih, &key );
+    if( *name == NULL )
+        return( false );
+    if( LoadIndexCache( &iih, *name, &key ) )
+        return( true );
+    VERIFY( HashNameCount( iih.name_map ) == 0 );
+    BuildNames();
+    SaveIndexCache( &iih, *name, &key );
+    return( false );
+}
+
+static void CopyFile( const char *src, const char *dst, long len )
+{
+    FILE    *in;
+    FILE    *out;
+    int     c;
+
+    in = fopen( src, "rb" );
+    out = fopen( dst, "wb" );
+    while( len-- != 0 && (c = fgetc( in )) != EOF ) {
+        fputc( c, out );
+    }
+    fclose( out );
+    fclose( in );
+}
+
+static void PatchFile( const char *name, long offset, int c )
+{
+    FILE    *fp;
+
+    fp = fopen( name, "r+b" );
+    fseek( fp, offset, SEEK_SET );
+    fputc( c, fp );
+    fclose( fp );
+}
+
+static int ReadByte( const char *name, long offset )
+{
+    FILE    *fp;
+    int     c;
+
+    fp = fopen( name, "rb" );
+    fseek( fp, offset, SEEK_SET );
+    c = fgetc( fp );
+    fclose( fp );
+    return( c );
+}
+
+static long FileSize( const char *name )
+{
+    FILE    *fp;
+    long    size;
+
+    fp = fopen( name, "rb" );
+    if( fp == NULL )
+        return( -1 );
+    fseek( fp, 0, SEEK_END );
+    size = ftell( fp );
+    fclose( fp );
+    return( size );
+}
+
+/* Open the image and get its names, returns true on a cache hit */
+static bool TryCache( void )
+{
+    char    *name;
+    bool    hit;
+
+    OpenImage();
+    hit = LoadNames( &name );
+    VERIFY( CheckNames() );
+    CloseImage();
+    DCFree( name );
+    return( hit );
+}
+
+static char *CacheName( void )
+{
+    index_cache_key key;
+    char            *name;
+
+    OpenImage();
+    name = IndexCacheName( &iih, &key );
+    CloseImage();
+    return( name );
+}
+
+static void TestHit( void )
+{
+    char    *name;
+
+    name = CacheName();
+    VERIFY( name != NULL );
+    VERIFY( !TryCache() );
+    VERIFY( FileSize( name ) > 0 );
+    VERIFY( TryCache() );
+    remove( name );
+    DCFree( name );
+}
+
+static void TestStale( void )
+{
+    char    *name;
+    char    *name2;
+    char    *name3;
+
+    name = CacheName();
+    TryCache();
+
+    /* rebuilt image, different .debug_info contents */
+    PatchImage( INFO_OFFSET + 1 );
+    name2 = CacheName();
+    VERIFY( strcmp( name, name2 ) != 0 );
+    VERIFY( !TryCache() );
+    remove( name2 );
+
+    /* rebuilt image, different .debug_str size */
+    dwarf.sect_sizes[DR_DEBUG_STR] -= 16;
+    VERIFY( !TryCache() );
+    name3 = CacheName();
+    remove( name3 );
+    DCFree( name3 );
+    dwarf.sect_sizes[DR_DEBUG_STR] += 16;
+
+    /* cache file of another image under this image's name */
+    CopyFile( name, name2, -1 );
+    VERIFY( !TryCache() );
+    VERIFY( TryCache() );
+
+    remove( name2 );
+    remove( name );
+    DCFree( name2 );
+    DCFree( name );
+
+    /* a change in a block the old sampled key never read */
+    name = CacheName();
+    TryCache();
+    PatchImage( INFO_OFFSET + INFO_SIZE / 4 + 3 );
+    name2 = CacheName();
+    VERIFY( strcmp( name, name2 ) != 0 );
+    VERIFY( !TryCache() );
+
+    remove( name2 );
+    remove( name );
+    DCFree( name2 );
+    DCFree( name );
+    WriteImage();
+}
+
+static void TestDamaged( void )
+{
+    static const char   good[] = "cachetst.dwi";
+    char                *name;
+    long                size;
+    long                len;
+
+    name = CacheName();
+    TryCache();
+    CopyFile( name, good, -1 );
+    size = FileSize( good );
+    /* length of the first name, the entry follows the header */
+    len = ReadByte( good, HEADER_SIZE + 4 ) + 256 * ReadByte( good, HEADER_SIZE + 5 );
+
+    CopyFile( good, name, size - 3 );
+    VERIFY( !TryCache() );
+
+    CopyFile( good, name, -1 );
+    PatchFile( name, HEADER_SIZE + 6 + len - 1, 'x' );
+    VERIFY( !TryCache() );
+
+    CopyFile( good, name, -1 );
+    PatchFile( name, HEADER_SIZE + 3, 0x7f );
+    VERIFY( !TryCache() );
+
+    /* the first name is always checked against the DWARF */
+    CopyFile( good, name, -1 );
+    PatchFile( name, HEADER_SIZE + 6 + len - 2, '#' );
+    VERIFY( !TryCache() );
+
+    CopyFile( good, name, -1 );
+    PatchFile( name, size, 0 );
+    VERIFY( !TryCache() );
+
+    VERIFY( TryCache() );
+
+    remove( good );
+    remove( name );
+    DCFree( name );
+}
+
+static void TestBuildId( void )
+{
+    char    *name;
+    char    *name2;
+
+    WriteBuildId();
+    name = CacheName();
+    VERIFY( !TryCache() );
+    VERIFY( TryCache() );
+
+    /* the build-id names the build, the rest of the image isn't read */
+    PatchImage( INFO_OFFSET + INFO_SIZE / 2 );
+    name2 = CacheName();
+    VERIFY( strcmp( name, name2 ) == 0 );
+    VERIFY( TryCache() );
+    DCFree( name2 );
+
+    PatchImage( sizeof( Elf_Note ) + 4 + BUILD_ID_LEN - 1 );
+    name2 = CacheName();
+    VERIFY( strcmp( name, name2 ) != 0 );
+    VERIFY( !TryCache() );
+
+    remove( name2 );
+    remove( name );
+    DCFree( name2 );
+    DCFree( name );
+    WriteImage();
+}
+
+int main( int argc, char *argv[] )
+{
+    static char env[] = "WD_DWARF_CACHE=.";
+
+    /* unused parameters */ (void)argc;
+
+    strcpy( ProgramName, argv[0] );             /* store filename */
+
+    putenv( env );
+    WriteImage();
+    TestHit();
+    TestStale();
+    TestDamaged();
+    TestBuildId();
+    remove( IMAGE_NAME );
+    if( NumErrors != 0 ) {
+        printf( "%s: FAILURE (%d errors).\n", ProgramName, NumErrors );
+        return( EXIT_FAILURE );
+    }
+    printf( "Tests completed (%s).\n", ProgramName );
+    return( EXIT_SUCCESS );
+}
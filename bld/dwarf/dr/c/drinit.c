@@ -107,8 +107,11 @@ static void ReadCUAbbrevTable( struct dr_dbg_info *dbg, compunit_info *compunit
     *compunit->abbrev_refs = 1;
 }
 
-static dr_dbg_handle  InitDbgHandle( void *file, unsigned long *sizes, bool byteswap )
-/************************************************************************************/
+static dr_dbg_handle  InitDbgHandle( void *file, unsigned long *sizes, drmem_hdl *bases, bool byteswap )
+/******************************************************************************************************
+ * if bases is not NULL the client already has the sections in memory
+ * and they are used in place, otherwise they are read in
+ */
 {
     dr_dbg_handle       dbg;
     int                 i;
@@ -128,7 +131,11 @@ static dr_dbg_handle  InitDbgHandle( void *file, unsigned long *sizes, bool byte
         size = sizes[i];
         dbg->sections[i].size = size;
         if( size != 0 ) {
-            dbg->sections[i].base = DWRVMAlloc( size, i );
+            if( bases != NULL ) {
+                dbg->sections[i].base = bases[i];
+            } else {
+                dbg->sections[i].base = DWRVMAlloc( size, i );
+            }
             if( dbg->sections[i].base == DRMEM_HDL_NULL ) {
                 DWRFREE( dbg );
                 return( NULL );
@@ -223,7 +230,7 @@ dr_dbg_handle DRENTRY DRDbgInitNFT( void * file, unsigned long * sizes, bool byt
 {
     dr_dbg_handle       dbg;
 
-    dbg = InitDbgHandle( file, sizes, byteswap );
+    dbg = InitDbgHandle( file, sizes, NULL, byteswap );
     if( dbg != NULL ) {
         ReadCompUnits( dbg, false );
     }
@@ -235,13 +242,31 @@ dr_dbg_handle DRENTRY DRDbgInit( void * file, unsigned long * sizes, bool bytesw
 {
     dr_dbg_handle       dbg;
 
-    dbg = InitDbgHandle( file, sizes, byteswap );
+    dbg = InitDbgHandle( file, sizes, NULL, byteswap );
     if( dbg != NULL ) {
         ReadCompUnits( dbg, true );
     }
     return( dbg );
 }
 
+#if !defined( USE_VIRTMEM )
+
+dr_dbg_handle DRENTRY DRDbgInitMapNFT( void * file, unsigned long * sizes, drmem_hdl * bases, bool byteswap )
+/***********************************************************************************************************
+ * sections are mapped by the client, they must stay mapped until DRDbgFini
+ */
+{
+    dr_dbg_handle       dbg;
+
+    dbg = InitDbgHandle( file, sizes, bases, byteswap );
+    if( dbg != NULL ) {
+        ReadCompUnits( dbg, false );
+    }
+    return( dbg );
+}
+
+#endif
+
 void DRENTRY DRDbgFini( dr_dbg_handle dbg )
 /******************************************
  * don't have a way of deallocating virtual memory space.  Assume that any
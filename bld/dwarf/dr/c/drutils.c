@@ -690,6 +690,22 @@ drmem_hdl DRENTRY DRGetCompileUnitTag( drmem_hdl comp_unit )
     return( comp_unit );
 }
 
+unsigned long DRENTRY DRGetInfoOffset( drmem_hdl entry )
+/*******************************************************
+ * return offset of entry in the .debug_info section
+ */
+{
+    return( entry - DWRCurrNode->sections[DR_DEBUG_INFO].base );
+}
+
+drmem_hdl DRENTRY DRGetInfoHandle( unsigned long offset )
+/********************************************************
+ * return handle of entry at given .debug_info offset
+ */
+{
+    return( DWRCurrNode->sections[DR_DEBUG_INFO].base + offset );
+}
+
 #define DEMANGLE_BUF_SIZE 256
 
 char * DWRGetName( drmem_hdl abbrev, drmem_hdl entry )
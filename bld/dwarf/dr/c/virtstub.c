@@ -79,7 +79,10 @@ drmem_hdl DWRVMAlloc( unsigned long len, int sect )
 }
 
 bool DWRVMSectDone( drmem_hdl base, unsigned_32 size )
-/****************************************************/
+/*****************************************************
+ * sections mapped by the client (DRDbgInitMapNFT) are not on the list
+ * and are left alone
+ */
 {
     alloc_struct    *walk;
     alloc_struct    **lnk;
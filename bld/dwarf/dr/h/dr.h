@@ -409,6 +409,9 @@ typedef void    (*DRDECORCB)( void *, char *, int, drmem_hdl, dr_sym_type );
 /* drinit.c */
 extern dr_dbg_handle    DRENTRY DRDbgInit( void *, unsigned long *, bool );
 extern dr_dbg_handle    DRENTRY DRDbgInitNFT( void *, unsigned long *, bool ); /* no file table */
+#if !defined( USE_VIRTMEM )
+extern dr_dbg_handle    DRENTRY DRDbgInitMapNFT( void *, unsigned long *, drmem_hdl *, bool ); /* no file table */
+#endif
 extern void             DRENTRY DRDbgFini( dr_dbg_handle );
 extern dr_dbg_handle    DRENTRY DRSetDebug( dr_dbg_handle );
 extern dr_dbg_handle    DRENTRY DRGetDebug( void );
@@ -476,6 +479,8 @@ extern void             DRENTRY DRWalkARange( DRARNGWLK, void * );
 /* drutils.c */
 extern drmem_hdl        DRENTRY DRGetCompileUnitTag( drmem_hdl comp_unit );
 extern void             DRENTRY DRIterateCompileUnits( void *, DRITERCUCB );
+extern unsigned long    DRENTRY DRGetInfoOffset( drmem_hdl entry );
+extern drmem_hdl        DRENTRY DRGetInfoHandle( unsigned long offset );
 
 /* drline.c */
 extern drmem_hdl        DRENTRY DRGetStmtList( drmem_hdl ccu );
@@ -87,6 +87,20 @@ struct wcpp_thread_ctl {
 };
 #endif
 
+#if defined( __SW_BM ) && ( defined( __NT__ ) || defined( __LINUX__ ) ) && defined( _M_IX86 )
+/*
+ * per thread cache of freed near heap blocks (see clib/heap/c/nheapcch.c)
+ */
+#define __NHEAP_CACHE
+#define NHEAP_CACHE_CLASSES     31
+
+typedef struct nheap_cache {
+    void                        *head[NHEAP_CACHE_CLASSES];
+    unsigned char               count[NHEAP_CACHE_CLASSES];
+    unsigned char               disabled;       // flush in progress
+} nheap_cache;
+#endif
+
 /* stack checking routine (assembly code) assumes "__stklowP" is first field */
 typedef struct thread_data {
     unsigned                    __stklowP;
@@ -133,6 +147,9 @@ typedef struct thread_data {
 #endif
 #if defined( __NT__ ) || defined( __OS2__ ) || defined( __LINUX__ )
     wchar_t                     *__nextwtokP;
+#endif
+#ifdef __NHEAP_CACHE
+    nheap_cache                 __nheap_cache;
 #endif
     unsigned                    __data_size;
 } thread_data;
@@ -155,6 +172,12 @@ _WCRTDATA extern thread_data    *(*__GetThreadPtr)( void );
     extern thread_data_vector   *__ThreadData;
 #endif
 
+#ifdef __NHEAP_CACHE
+    extern void                 *__NHeapCacheAlloc( unsigned size );
+    extern int                  __NHeapCacheFree( void *cstg );
+    extern void                 __NHeapCacheFlush( thread_data *tdata );
+#endif
+
 #if !defined( _M_I86 )
     // prototype for thread data init function
     int __initthread( void *p );
@@ -364,6 +364,12 @@ static const char *ParseOption( const char *c, char *token_buff )
             Options.libtype = WL_LTYPE_OMF;
             Options.omf_found = true;
             break;
+        case 'h':
+            if( Options.ar_hash ) {
+                DuplicateOption( start );
+            }
+            Options.ar_hash = true;
+            break;
         default:
             c = start;
             break;
@@ -91,6 +91,8 @@ void LibWalk( libfile io, const char *name, void (*rtn)( arch_header *, libfile
             AllocFNameTab( name, io, &arch );
         } else if( ar.name[0] == '/' && ar.name[1] == '/' && ar.name[2] == '/' ) {
             AllocFFNameTab( name, io, &arch );
+        } else if( memcmp( ar.name, AR_HASH_NAME, AR_HASH_NAME_LEN ) == 0 ) {
+            // Ignore hashed symbol index, it is rebuilt on output.
         } else {
             arch.name = GetARName( io, &ar, &arch );
             arch.ffname = GetFFName( &arch );
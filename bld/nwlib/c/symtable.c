@@ -449,6 +449,67 @@ static void WriteOmfFileTable( void )
     WriteOmfLibHeader( dict_offset, num_blocks );
 }
 
+static file_offset ArHashBuckets( void )
+/**************************************/
+{
+    file_offset     buckets;
+
+    buckets = 16;
+    while( buckets < 2 * NumSymbols ) {
+        buckets <<= 1;
+    }
+    return( buckets );
+}
+
+static file_offset ArHashSize( void )
+/***********************************/
+{
+    return( AR_HASH_HEADER_SIZE + ArHashBuckets() * AR_HASH_BUCKET_SIZE + TotalSymbolLength );
+}
+
+static void WriteArHashIndex( void )
+/**********************************/
+{
+    unsigned_32     *table;
+    unsigned_32     *bucket;
+    unsigned_32     buckets;
+    unsigned_32     hash;
+    unsigned_32     name_offset;
+    size_t          i;
+    unsigned_32     j;
+    const char      *p;
+    sym_entry       *sym;
+
+    buckets = ArHashBuckets();
+    table = MemAlloc( buckets * AR_HASH_BUCKET_SIZE );
+    memset( table, 0, buckets * AR_HASH_BUCKET_SIZE );
+    name_offset = 0;
+    for( i = 0; i < NumSymbols; ++i ) {
+        sym = SortedSymbols[i];
+        hash = AR_HASH_INIT;
+        for( p = sym->name; *p != '\0'; ++p ) {
+            hash = AR_HASH_STEP( hash, *p );
+        }
+        for( j = hash & ( buckets - 1 ); table[j * 3 + 2] != 0; j = ( j + 1 ) & ( buckets - 1 ) )
+            ;
+        bucket = table + j * 3;
+        bucket[0] = hash;
+        bucket[1] = name_offset;
+        bucket[2] = sym->file->u.new_offset;
+        name_offset += sym->len + 1;
+    }
+    WriteNew( AR_HASH_SIGNATURE, AR_HASH_SIGNATURE_LEN );
+    WriteLittleEndian32( buckets );
+    for( j = 0; j < buckets * 3; ++j ) {
+        WriteLittleEndian32( table[j] );
+    }
+    MemFree( table );
+    for( i = 0; i < NumSymbols; ++i ) {
+        WriteNew( SortedSymbols[i]->name, SortedSymbols[i]->len + 1 );
+    }
+    WritePadding( TotalSymbolLength );
+}
+
 static void WriteArMlibFileTable( void )
 /**************************************/
 {
@@ -507,6 +568,9 @@ static void WriteArMlibFileTable( void )
             padding_string_len = AR_FILE_PADDING_STRING_LEN;
             break;
         }
+        if( Options.ar_hash ) {
+            header_size += AR_HEADER_SIZE + __ROUND_UP_SIZE_EVEN( ArHashSize() );
+        }
         break;
     case WL_LTYPE_MLIB:
         dict1_size = 0;
@@ -653,6 +717,15 @@ static void WriteArMlibFileTable( void )
         WritePadding( TotalNameLength );
     }
 
+    // write the hashed symbol index
+
+    if( Options.libtype == WL_LTYPE_AR && Options.ar_hash ) {
+        arch.size = ArHashSize();
+        arch.name = AR_HASH_NAME;
+        WriteFileHeader( &arch );
+        WriteArHashIndex();
+    }
+
     // write the full filename table
 
     if( Options.libtype == WL_LTYPE_MLIB ) {
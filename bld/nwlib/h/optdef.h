@@ -94,6 +94,7 @@ typedef struct {
     boolbit         no_c_warn        :1; //no create lib warning
     boolbit         ar               :1;
     boolbit         coff_import_long :1; // generate old long format of coff import library
+    boolbit         ar_hash          :1; // write hashed symbol index into AR library
     // flags
     boolbit         modified         :1;
     boolbit         omf_found        :1; // if omf objects found
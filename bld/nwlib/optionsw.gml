@@ -322,6 +322,11 @@
 :usage.  output OMF format library
 :jusage. OMF形式ライブラリを出力します
 
+:option. fh
+:target. any
+:usage.  add hashed symbol index to AR library
+:jusage. ARﾗｲﾌﾞﾗﾘにﾊｯｼｭ化したｼﾝﾎﾞﾙ索引を追加します
+
 
 :option. iro
 :target. any
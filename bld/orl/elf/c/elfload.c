@@ -456,6 +456,7 @@ static orl_return load_elf_sec_handles( elf_file_handle elf_file_hnd, elf_index
             break;
         }
         elf_sec_hnd->contents = NULL;
+        elf_sec_hnd->is_group = ( sh_type == SHT_GROUP );
         memset( &(elf_sec_hnd->assoc), '\0', sizeof( elf_sec_hnd->assoc ) );
         determine_section_specs( elf_sec_hnd, sh_type, sh_flags, is64bit );
         switch( elf_sec_hnd->type ) {
@@ -525,6 +526,46 @@ static orl_return load_elf_sec_handles( elf_file_handle elf_file_hnd, elf_index
 }
 
 
+// Flag the members of each COMDAT section group as COMDAT, so that
+// clients treat them like COFF COMDAT sections and keep only one copy.
+static void mark_comdat_groups( elf_file_handle elf_file_hnd )
+{
+    elf_sec_handle      elf_sec_hnd;
+    elf_quantity        i;
+    elf_quantity        j;
+    elf_quantity        count;
+    elf_word            word;
+
+    for( i = 0; i < elf_file_hnd->num_sections; ++i ) {
+        elf_sec_hnd = elf_file_hnd->orig_sec_handles[i];
+        if( !elf_sec_hnd->is_group || elf_sec_hnd->contents == NULL )
+            continue;
+        count = elf_sec_hnd->size.u._32[I64LO32] / sizeof( elf_word );
+        if( count == 0 )
+            continue;
+        memcpy( &word, elf_sec_hnd->contents, sizeof( word ) );
+        if( elf_file_hnd->flags & ORL_FILE_FLAG_BIG_ENDIAN ) {
+            CONV_BE_32( word );
+        } else {
+            CONV_LE_32( word );
+        }
+        if( (word & GRP_COMDAT) == 0 )
+            continue;
+        for( j = 1; j < count; ++j ) {
+            memcpy( &word, elf_sec_hnd->contents + j * sizeof( word ), sizeof( word ) );
+            if( elf_file_hnd->flags & ORL_FILE_FLAG_BIG_ENDIAN ) {
+                CONV_BE_32( word );
+            } else {
+                CONV_LE_32( word );
+            }
+            if( word == 0 || word > elf_file_hnd->num_sections )
+                continue;
+            elf_file_hnd->orig_sec_handles[word - 1]->flags |= ORL_SEC_FLAG_COMDAT;
+        }
+    }
+}
+
+
 static int section_compare( const void *sec1, const void *sec2 )
 {
     if( (*(const elf_sec_handle *)sec1)->file_offset.u._32[I64HI32] > (*(const elf_sec_handle *)sec2)->file_offset.u._32[I64HI32] )
@@ -646,5 +687,6 @@ orl_return ElfLoadFileStructure( elf_file_handle elf_file_hnd )
         elf_file_hnd->orig_sec_handles[i]->name = string_table + name_index[i];
     }
     _ClientFree( elf_file_hnd, name_index );
+    mark_comdat_groups( elf_file_hnd );
     return( ORL_OKAY );
 }
@@ -133,6 +133,7 @@ ORL_STRUCT( elf_sec_handle ) {
     orl_table_index     index;
 //    elf_quantity        index;
     elf_sec_size        entsize;
+    bool                is_group;       // SHT_GROUP section
     // assoc - things associated with the section
     union {
         struct elf_normal_assoc_struct  normal;
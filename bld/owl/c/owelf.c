@@ -38,16 +38,16 @@
 #define ELF_UNDEF_INDEX         0
 #define ELF_STRING_INDEX        1       /* index of string table section */
 #define ELF_SYMBOL_INDEX        2       /* index of symbol table section */
-#define FIRST_USER_SECTION      3
+#define FIRST_GROUP_SECTION     3       /* COMDAT groups precede their members */
 
-#define _OWLIndexToELFIndex( x )        ( (x) + FIRST_USER_SECTION )
+#define _OWLIndexToELFIndex( f, i )     ( (i) + FIRST_GROUP_SECTION + (f)->x.elf.num_groups )
 
 static bool useRela;                    // Use .rela or .rel
 
 static unsigned numSections( owl_file_handle file ) {
 //***************************************************
 
-    return( _OWLIndexToELFIndex( file->next_index ) );
+    return( _OWLIndexToELFIndex( file, file->next_index ) );
 }
 
 static unsigned numSymbols( owl_file_handle file ) {
@@ -118,14 +118,28 @@ static void emitElfSymbol( owl_symbol_info *symbol, Elf32_Sym *elf_sym ) {
     elf_sym->st_name = OWLStringOffset( symbol->name );
     elf_sym->st_value = symbol->offset;
     elf_sym->st_size = 0;
-    elf_sym->st_info = ELF32_ST_INFO( elfBinding[ symbol->linkage ], elfType[ symbol->type ] );
+    if( _OwlMetaSymbol( symbol->type ) ) {
+        elf_sym->st_info = ELF32_ST_INFO( STB_LOCAL, elfType[ symbol->type ] );
+    } else {
+        elf_sym->st_info = ELF32_ST_INFO( elfBinding[ symbol->linkage ], elfType[ symbol->type ] );
+    }
     elf_sym->st_other = 0;
     elf_sym->st_shndx = SHN_UNDEF;
-    if( symbol->section != NULL ) {
-        elf_sym->st_shndx = _OWLIndexToELFIndex( symbol->section->index );
+    if( symbol->type == OWL_TYPE_FILE ) {
+        elf_sym->st_shndx = SHN_ABS;
+    } else if( symbol->section != NULL ) {
+        elf_sym->st_shndx = _OWLIndexToELFIndex( symbol->section->file, symbol->section->index );
     }
 }
 
+static bool isLocalSymbol( owl_symbol_info *symbol ) {
+//****************************************************
+// Section and file symbols are always local in ELF, whatever their
+// linkage says (COFF wants them external).
+
+    return( !_OwlLinkageGlobal( symbol->linkage ) || _OwlMetaSymbol( symbol->type ) );
+}
+
 static void emitBogusSymbol( Elf32_Sym *elf_sym ) {
 //*************************************************
 
@@ -153,10 +167,10 @@ static void prepareSymbolTable( owl_file_handle file, elf_special_section *sym_s
     elf_syms = (Elf32_Sym *)sym_sect->buffer;
     emitBogusSymbol( elf_syms );
     next_local_index = 1;
-    next_global_index = file->symbol_table->num_global_symbols + file->symbol_table->num_local_symbols;
+    next_global_index = numSymbols( file );
     for( sym = file->symbol_table->head; sym != NULL; sym = sym->next ) {
         if( sym->flags & OWL_SYM_DEAD ) continue;
-        if( !(_OwlLinkageGlobal(sym->linkage)) ) {
+        if( isLocalSymbol( sym ) ) {
             sym->index = next_local_index++;
         } else {
             sym->index = next_global_index--;
@@ -164,7 +178,7 @@ static void prepareSymbolTable( owl_file_handle file, elf_special_section *sym_s
         emitElfSymbol( sym, &elf_syms[ sym->index ] );
     }
     assert( ( next_global_index + 1 ) == next_local_index );
-    assert( next_local_index == ( file->symbol_table->num_local_symbols + 1 ) );
+    file->x.elf.num_local_symbols = next_local_index - 1;
 }
 
 static void initSectionHeader( Elf32_Shdr *header, Elf32_Word type, Elf32_Word flags ) {
@@ -209,7 +223,7 @@ static void formatSymbolTableHeader( owl_file_handle file, Elf32_Shdr *header )
     initSectionHeader( header, SHT_SYMTAB, 0 );
     header->sh_name = OWLStringOffset( sym_tab->name );
     header->sh_link = ELF_STRING_INDEX;
-    header->sh_info = file->symbol_table->num_local_symbols + 1;
+    header->sh_info = file->x.elf.num_local_symbols + 1;
     header->sh_entsize = sizeof( Elf32_Sym );
     header->sh_offset = file->x.elf.next_section;
     header->sh_size = sym_tab->length;
@@ -279,10 +293,30 @@ static owl_offset sectionPadding( owl_section_handle section, owl_offset offset
     return( padding );
 }
 
+static owl_section_handle groupOwner( owl_section_handle section ) {
+//******************************************************************
+// Return the section whose COMDAT group this section belongs to, if any.
+// Associated sections (such as .pdata) go in the group of their comdat_dep.
+
+    if( section->x.elf.group_index != 0 ) {
+        return( section );
+    }
+    if( section->comdat_dep != NULL && section->comdat_dep->x.elf.group_index != 0 ) {
+        return( section->comdat_dep );
+    }
+    return( NULL );
+}
+
+static Elf32_Word groupFlag( owl_section_handle section ) {
+//*********************************************************
+
+    return( ( groupOwner( section ) != NULL ) ? SHF_GROUP : 0 );
+}
+
 static void doSectionHeader( owl_section_handle section, Elf32_Shdr *header )
 //***************************************************************************
 {
-    initSectionHeader( header, sectionTypes( section->type ), sectionFlags( section->type ) );
+    initSectionHeader( header, sectionTypes( section->type ), sectionFlags( section->type ) | groupFlag( section ) );
     header->sh_name = OWLStringOffset( section->name );
     header->sh_addralign = sectionAlignment( section );
     header->sh_size = section->size + sectionPadding( section, section->size );
@@ -298,25 +332,73 @@ static void doSectionRelocsHeader( owl_section_handle section, Elf32_Shdr *heade
     size_t      reloc_entry_size;
 
     reloc_entry_size = useRela ? sizeof( Elf32_Rela ) : sizeof( Elf32_Rel );
-    initSectionHeader( header, (useRela ? SHT_RELA : SHT_REL), sectionFlags( section->type ) & SHF_ALLOC );
+    initSectionHeader( header, (useRela ? SHT_RELA : SHT_REL), ( sectionFlags( section->type ) & SHF_ALLOC ) | groupFlag( section ) );
     header->sh_name = OWLStringOffset( section->x.elf.relocs_name );
     header->sh_link = ELF_SYMBOL_INDEX;
-    header->sh_info = _OWLIndexToELFIndex( section->index );
+    header->sh_info = _OWLIndexToELFIndex( section->file, section->index );
     header->sh_size = reloc_entry_size * section->num_relocs;
     header->sh_entsize = reloc_entry_size;
     header->sh_offset = section->file->x.elf.next_section;
     section->file->x.elf.next_section += header->sh_size;
 }
 
+static unsigned groupMembers( owl_section_handle owner, Elf32_Word *members ) {
+//****************************************************************************
+// Count the ELF section indices in the group of owner, storing them in
+// members if that is not NULL.
+
+    owl_file_handle     file;
+    owl_section_handle  curr;
+    unsigned            count;
+
+    file = owner->file;
+    count = 0;
+    for( curr = file->sections; curr != NULL; curr = curr->next ) {
+        if( groupOwner( curr ) != owner )
+            continue;
+        if( members != NULL )
+            members[ count ] = _OWLIndexToELFIndex( file, curr->index );
+        count++;
+        if( curr->first_reloc != NULL ) {
+            if( members != NULL )
+                members[ count ] = _OWLIndexToELFIndex( file, curr->x.elf.relocs_index );
+            count++;
+        }
+    }
+    return( count );
+}
+
+static void formatGroupSectionHeaders( owl_file_handle file, Elf32_Shdr *headers ) {
+//**********************************************************************************
+
+    owl_section_handle  curr;
+    Elf32_Shdr          *header;
+
+    for( curr = file->sections; curr != NULL; curr = curr->next ) {
+        if( curr->x.elf.group_index == 0 )
+            continue;
+        header = &headers[ curr->x.elf.group_index ];
+        initSectionHeader( header, SHT_GROUP, 0 );
+        header->sh_name = OWLStringOffset( file->x.elf.group_name );
+        header->sh_link = ELF_SYMBOL_INDEX;
+        header->sh_info = curr->comdat_sym->index;
+        header->sh_addralign = sizeof( Elf32_Word );
+        header->sh_entsize = sizeof( Elf32_Word );
+        header->sh_size = ( 1 + groupMembers( curr, NULL ) ) * sizeof( Elf32_Word );
+        header->sh_offset = file->x.elf.next_section;
+        file->x.elf.next_section += header->sh_size;
+    }
+}
+
 static void formatUserSectionHeaders( owl_file_handle file, Elf32_Shdr *headers ) {
 //*********************************************************************************
 
     owl_section_handle  curr;
 
     for( curr = file->sections; curr != NULL; curr = curr->next ) {
-        doSectionHeader( curr, &headers[ _OWLIndexToELFIndex( curr->index ) ] );
+        doSectionHeader( curr, &headers[ _OWLIndexToELFIndex( file, curr->index ) ] );
         if( curr->first_reloc != NULL ) {
-            doSectionRelocsHeader( curr, &headers[ _OWLIndexToELFIndex( curr->x.elf.relocs_index ) ] );
+            doSectionRelocsHeader( curr, &headers[ _OWLIndexToELFIndex( file, curr->x.elf.relocs_index ) ] );
         }
     }
 }
@@ -333,6 +415,7 @@ static void emitSectionHeaders( owl_file_handle file ) {
     formatBogusUndefHeader( file, &headers[ ELF_UNDEF_INDEX ] );
     formatStringTableHeader( file, &headers[ ELF_STRING_INDEX ] );
     formatSymbolTableHeader( file, &headers[ ELF_SYMBOL_INDEX ] );
+    formatGroupSectionHeaders( file, headers );
     formatUserSectionHeaders( file, headers );
     _ClientWrite( file, (const char *)headers, section_header_table_size );
     _ClientFree( file, headers );
@@ -345,6 +428,25 @@ static void emitSpecialSection( owl_file_handle file, elf_special_section *secti
     _ClientFree( file, section->buffer );
 }
 
+static void emitGroupSections( owl_file_handle file ) {
+//*****************************************************
+
+    owl_section_handle  curr;
+    Elf32_Word          *group;
+    size_t              size;
+
+    for( curr = file->sections; curr != NULL; curr = curr->next ) {
+        if( curr->x.elf.group_index == 0 )
+            continue;
+        size = ( 1 + groupMembers( curr, NULL ) ) * sizeof( Elf32_Word );
+        group = _ClientAlloc( file, size );
+        group[ 0 ] = GRP_COMDAT;
+        groupMembers( curr, &group[ 1 ] );
+        _ClientWrite( file, (const char *)group, size );
+        _ClientFree( file, group );
+    }
+}
+
 static void emitReloc( owl_section_handle sec, owl_reloc_info *reloc, Elf32_Rela *elf_reloc ) {
 //*********************************************************************************************
 
@@ -466,6 +568,27 @@ static void prepareRelocSections( owl_file_handle file ) {
     }
 }
 
+static void prepareGroupSections( owl_file_handle file ) {
+//********************************************************
+// Each COMDAT section which has its symbol gets an SHT_GROUP section so
+// that the linker keeps only one copy of it (and of its relocs and any
+// associated sections). The group sections are placed right after the
+// symbol table, ahead of their members as the ELF spec requires.
+
+    owl_section_handle  curr;
+
+    file->x.elf.num_groups = 0;
+    for( curr = file->sections; curr != NULL; curr = curr->next ) {
+        curr->x.elf.group_index = 0;
+        if( _OwlSectionComdat( curr ) && curr->comdat_sym != NULL ) {
+            curr->x.elf.group_index = FIRST_GROUP_SECTION + file->x.elf.num_groups++;
+        }
+    }
+    if( file->x.elf.num_groups != 0 ) {
+        file->x.elf.group_name = OWLStringAdd( file->string_table, ".group" );
+    }
+}
+
 static void addSpecialStrings( owl_file_handle file ) {
 //*****************************************************
 
@@ -477,6 +600,7 @@ void ELFFileEmit( owl_file_handle file ) {
 //****************************************
 
     prepareRelocSections( file );
+    prepareGroupSections( file );
     writeFileHeader( file );
     addSpecialStrings( file );
     prepareStringTable( file, &file->x.elf.string_table );
@@ -484,5 +608,6 @@ void ELFFileEmit( owl_file_handle file ) {
     emitSectionHeaders( file );
     emitSpecialSection( file, &file->x.elf.string_table );
     emitSpecialSection( file, &file->x.elf.symbol_table );
+    emitGroupSections( file );
     emitSectionData( file );
 }
@@ -39,12 +39,16 @@ typedef struct elf_file_info {
     elf_special_section string_table;
     elf_special_section symbol_table;
     owl_offset          next_section;           // starting offset of next section to be placed
+    unsigned            num_local_symbols;      // number of STB_LOCAL symbols
+    unsigned            num_groups;             // number of COMDAT section groups
+    owl_string_handle   group_name;             // name of section group sections
 } elf_file_info;
 
 typedef struct elf_section_info {
     owl_offset          relocs_index;           // index of section for relocs
     owl_string_handle   relocs_name;            // name of relocs section for this section
     owl_offset          pad_amount;             // number of bytes of padding (if any)
+    owl_offset          group_index;            // index of COMDAT group section (0 if none)
 } elf_section_info;
 
 extern  void    ELFFileEmit( owl_file_handle );
@@ -0,0 +1,245 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Round trip of ELF COMDAT section groups through OWL and ORL.
+*
+****************************************************************************/
+
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "owl.h"
+#include "orl.h"
+#include "exeelf.h"
+
+
+#define MAX_SECTS       32
+
+#define VERIFY( exp ) \
+    if( !(exp) ) {                                          \
+        printf( "%s: ***FAILURE*** at line %d of %s.\n",    \
+                ProgramName, __LINE__, __FILE__ );          \
+        NumErrors++;                                        \
+        exit( EXIT_FAILURE );                               \
+    }
+
+static const char       retData[] = { 0xc3, 0, 0, 0, 0 };
+static const char       callData[] = { 0xe8, 0xfc, 0xff, 0xff, 0xff, 0xc3 };
+
+static unsigned         comdatSecs = 0;
+
+char                    ProgramName[128];   /* executable filename */
+int                     NumErrors = 0;      /* number of errors */
+
+static int owl_write( owl_client_file f, const char *buff, size_t size )
+{
+    return( fwrite( buff, 1, size, f ) != size );
+}
+
+static long owl_tell( owl_client_file f )
+{
+    return( ftell( f ) );
+}
+
+static int owl_seek( owl_client_file f, long offset, int where )
+{
+    return( fseek( f, offset, where ) );
+}
+
+static void *orl_read( FILE *fp, size_t len )
+{
+    char        *buff;
+
+    // leaked on purpose, ORL keeps pointers into what it read
+    buff = malloc( len );
+    if( buff != NULL && fread( buff, 1, len, fp ) != len ) {
+        free( buff );
+        buff = NULL;
+    }
+    return( buff );
+}
+
+static int orl_seek( FILE *fp, long pos, int where )
+{
+    return( fseek( fp, pos, where ) );
+}
+
+static void writeObject( FILE *fp )
+/**********************************
+ * a COMDAT function with an associated .pdata entry, called from .text
+ */
+{
+    owl_client_funcs    funcs = { owl_write, owl_tell, owl_seek, malloc, free };
+    owl_handle          owl;
+    owl_file_handle     file;
+    owl_section_handle  text;
+    owl_section_handle  code;
+    owl_section_handle  pdata;
+    owl_symbol_handle   inl;
+    owl_symbol_handle   caller;
+
+    owl = OWLInit( &funcs, OWL_CPU_X86 );
+    file = OWLFileInit( owl, "grouptst", fp, OWL_FORMAT_ELF, OWL_FILE_OBJECT );
+    text = OWLSectionInit( file, ".text", OWL_SECTION_CODE, 16 );
+    code = OWLSectionInit( file, ".text.inl", OWL_SECTION_COMDAT_CODE, 16 );
+    pdata = OWLSectionInit( file, ".pdata", OWL_SECTION_COMDAT_PDATA, 4 );
+    inl = OWLSymbolInit( file, "inl" );
+    caller = OWLSymbolInit( file, "caller" );
+    OWLComdatDep( pdata, code );
+    OWLEmitLabel( code, inl, OWL_TYPE_FUNCTION, OWL_SYM_GLOBAL );
+    OWLEmitData( code, retData, 1 );
+    OWLEmitReloc( pdata, 0, inl, OWL_RELOC_WORD );
+    OWLEmitData( pdata, retData + 1, 4 );
+    OWLEmitLabel( text, caller, OWL_TYPE_FUNCTION, OWL_SYM_GLOBAL );
+    OWLEmitReloc( text, 1, inl, OWL_RELOC_BRANCH_REL );
+    OWLEmitData( text, callData, sizeof( callData ) );
+    OWLFileFini( file );
+    OWLFini( owl );
+}
+
+static void checkGroups( FILE *fp )
+/**********************************
+ * the raw section headers: one GRP_COMDAT group, named after "inl", which
+ * comes ahead of its members and lists exactly the SHF_GROUP sections
+ */
+{
+    Elf32_Ehdr          ehdr;
+    Elf32_Shdr          shdr[MAX_SECTS];
+    char                *shstr;
+    Elf32_Word          grp[MAX_SECTS + 1];
+    Elf32_Sym           sym;
+    char                name[8];
+    int                 member[MAX_SECTS];
+    unsigned            groups;
+    unsigned            i;
+    unsigned            j;
+    unsigned            n;
+
+    rewind( fp );
+    VERIFY( fread( &ehdr, sizeof( ehdr ), 1, fp ) == 1 && ehdr.e_shnum <= MAX_SECTS );
+    fseek( fp, ehdr.e_shoff, SEEK_SET );
+    fread( shdr, sizeof( shdr[0] ), ehdr.e_shnum, fp );
+    shstr = malloc( shdr[ehdr.e_shstrndx].sh_size );
+    fseek( fp, shdr[ehdr.e_shstrndx].sh_offset, SEEK_SET );
+    fread( shstr, 1, shdr[ehdr.e_shstrndx].sh_size, fp );
+    memset( member, 0, sizeof( member ) );
+    groups = 0;
+    n = 0;
+    for( i = 0; i < ehdr.e_shnum; i++ ) {
+        if( shdr[i].sh_type != SHT_GROUP )
+            continue;
+        groups++;
+        n = shdr[i].sh_size / sizeof( Elf32_Word );
+        VERIFY( n > 1 && n <= MAX_SECTS + 1 );
+        fseek( fp, shdr[i].sh_offset, SEEK_SET );
+        fread( grp, sizeof( grp[0] ), n, fp );
+        VERIFY( grp[0] == GRP_COMDAT );
+        for( j = 1; j < n; j++ ) {
+            VERIFY( grp[j] > i && grp[j] < ehdr.e_shnum );     /* ahead of its members */
+            member[grp[j]] = 1;
+        }
+        // the signature is the symbol of the COMDAT section
+        fseek( fp, shdr[shdr[i].sh_link].sh_offset + shdr[i].sh_info * sizeof( sym ), SEEK_SET );
+        fread( &sym, sizeof( sym ), 1, fp );
+        fseek( fp, shdr[shdr[shdr[i].sh_link].sh_link].sh_offset + sym.st_name, SEEK_SET );
+        fread( name, 1, sizeof( name ), fp );
+        VERIFY( memcmp( name, "inl", 4 ) == 0 );
+    }
+    VERIFY( groups == 1 );
+    for( i = 0; i < ehdr.e_shnum; i++ ) {
+        VERIFY( ( (shdr[i].sh_flags & SHF_GROUP) != 0 ) == member[i] );
+        if( member[i] ) {
+            VERIFY( strcmp( shstr + shdr[i].sh_name, ".text.inl" ) == 0
+                || strcmp( shstr + shdr[i].sh_name, ".pdata" ) == 0
+                || strcmp( shstr + shdr[i].sh_name, ".rel.pdata" ) == 0 );
+        }
+    }
+    VERIFY( n == 4 );
+    free( shstr );
+}
+
+static orl_return checkSection( orl_sec_handle section )
+/******************************************************
+ * relocation sections are group members as well
+ */
+{
+    const char          *name;
+    int                 comdat;
+
+    name = ORLSecGetName( section );
+    comdat = ( ORLSecGetFlags( section ) & ORL_SEC_FLAG_COMDAT ) != 0;
+    if( strcmp( name, ".text.inl" ) == 0 || strcmp( name, ".pdata" ) == 0
+      || strcmp( name, ".rel.pdata" ) == 0 ) {
+        VERIFY( comdat );
+        comdatSecs++;
+    } else {
+        VERIFY( !comdat );
+    }
+    return( ORL_OKAY );
+}
+
+static void checkORL( FILE *fp )
+/*******************************
+ * ORL must hand the group members to its clients as COMDAT sections
+ */
+{
+    ORLSetFuncs( orl_funcs, orl_read, orl_seek, malloc, free );
+    orl_handle          orl;
+    orl_file_handle     file;
+
+    rewind( fp );
+    orl = ORLInit( &orl_funcs );
+    VERIFY( ORLFileIdentify( orl, fp ) == ORL_ELF );
+    file = ORLFileInit( orl, fp, ORL_ELF );
+    VERIFY( file != NULL );
+    ORLFileScan( file, NULL, checkSection );
+    ORLFileFini( file );
+    ORLFini( orl );
+    VERIFY( comdatSecs == 3 );
+}
+
+int main( int argc, char *argv[] )
+{
+    FILE        *fp;
+
+    /* unused parameters */ (void)argc;
+
+    strcpy( ProgramName, argv[0] );             /* store filename */
+
+    fp = tmpfile();
+    VERIFY( fp != NULL );
+    writeObject( fp );
+    checkGroups( fp );
+    checkORL( fp );
+    fclose( fp );
+    if( NumErrors != 0 ) {
+        printf( "%s: FAILURE (%d errors).\n", ProgramName, NumErrors );
+        return( EXIT_FAILURE );
+    }
+    printf( "Tests completed (%s).\n", ProgramName );
+    return( EXIT_SUCCESS );
+}
@@ -47,6 +47,7 @@
 #include "cgdata.h"
 #include "pcheader.h"
 #include "hfile.h"
+#include "hcache.h"
 #include "codegen.h"
 #include "cgback.h"
 #include "pragdefn.h"
@@ -830,6 +831,9 @@ static void analyseAnyTargetOptions( OPT_STORAGE *data )
     } else {
         ErrLimit = 20;
     }
+    if( data->fhc ) {
+        SetStringOption( HCacheDirPtr(), &(data->fhc_value) );
+    }
     if( data->fhd ) {
         CompFlags.use_pcheaders = true;
     }
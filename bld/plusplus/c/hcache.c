@@ -0,0 +1,627 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Persistent include file cache (-fhc option).
+*
+****************************************************************************/
+
+
+#include "plusplus.h"
+#include <errno.h>
+#include <fcntl.h>
+#if defined(__UNIX__)
+ #include <unistd.h>
+#else
+ #include <process.h>
+ #include <direct.h>
+ #if defined(__WATCOMC__)
+  #include <dos.h>
+ #endif
+#endif
+#include "wio.h"
+#include "memmgr.h"
+#include "iosupp.h"
+#include "preproc.h"
+#include "srcfile.h"
+#include "hfile.h"
+#include "hcache.h"
+#include "initdefs.h"
+#include "iopath.h"
+#include "sysdep.h"
+
+#include "clibext.h"
+
+
+#define HC_FILE_NAME    "wpphc.dat"
+#define HC_SIGNATURE    "WPPHC1"
+#define HC_HASH_SIZE    256
+#define HC_LOCK_EXT     ".lck"
+#define HC_LOCK_TRIES   10      // seconds to wait for the lock
+#define HC_LOCK_STALE   60      // age (seconds) of a lock left by a dead compile
+
+#define HC_HASH_INIT    0x811c9dc5U
+#define HC_HASH_STEP(h,c) (((h) ^ (unsigned char)(c)) * 0x01000193U)
+
+typedef enum {                  // HC_KIND -- kind of cache entry
+    HC_RESOLVE,                 // - resolution of an #include
+    HC_GUARD                    // - guard of a header file
+} HC_KIND;
+
+typedef struct hc_probe HC_PROBE;
+struct hc_probe {               // HC_PROBE -- directory probed without success
+    HC_PROBE    *next;          // - next probe
+    time_t      mtime;          // - time stamp of directory, 0 ==> missing
+    char        name[1];        // - directory name
+};
+
+typedef struct hc_entry HC_ENTRY;
+struct hc_entry {               // HC_ENTRY -- cache entry
+    HC_ENTRY    *next;          // - next in hash chain
+    unsigned    key;            // - hash key
+    HC_KIND     kind;           // - kind of entry
+    bool        dirty;          // - true ==> changed by this compile
+    time_t      mtime;          // - HC_GUARD: time stamp of file
+    char        *value;         // - resolved file name, guard macro or NULL
+    HC_PROBE    *probes;        // - HC_RESOLVE: unsuccessful probes
+    char        name[1];        // - #include name or file name
+};
+
+static char     *hcacheDir;             // cache directory (-fhc)
+static HC_ENTRY *hcacheTable[HC_HASH_SIZE]; // cache entries
+static bool     hcacheLoaded;           // true ==> cache file has been read
+static bool     hcacheModified;         // true ==> cache must be written
+static bool     recording;              // true ==> recording an #include search
+static HC_PROBE *recordProbes;          // - probes recorded so far
+static char     *recordResolved;        // - file opened
+
+
+static unsigned hashString(     // HASH A STRING
+    unsigned h,                 // - initial value
+    const char *str )           // - string
+{
+    if( str != NULL ) {
+        for( ; *str != '\0'; ++str ) {
+            h = HC_HASH_STEP( h, *str );
+        }
+    }
+    return( HC_HASH_STEP( h, '\0' ) );
+}
+
+
+static void dirOfFile(          // GET DIRECTORY OF A FILE
+    char *dir,                  // - directory (_MAX_PATH)
+    const char *name )          // - file name
+{
+    const char *p;
+    const char *sep;
+    size_t len;
+
+    sep = NULL;
+    for( p = name; *p != '\0'; ++p ) {
+        if( IS_PATH_SEP( *p ) ) {
+            sep = p;
+        }
+    }
+    if( sep == NULL ) {
+        strcpy( dir, "." );
+        return;
+    }
+    len = sep - name;
+    if( len == 0 || !IS_DIR_SEP( *sep ) || !IS_PATH_SEP_END( sep ) ) {
+        // keep the separator of a root directory or a drive
+        ++len;
+    }
+    if( len >= _MAX_PATH - 1 ) {
+        len = _MAX_PATH - 2;
+    }
+    memcpy( dir, name, len );
+    dir[len] = '\0';
+#if !defined(__UNIX__)
+    if( dir[len - 1] == DRIVE_SEP ) {
+        dir[len++] = '.';
+        dir[len] = '\0';
+    }
+#endif
+}
+
+
+static void freeProbes(         // FREE A LIST OF PROBES
+    HC_PROBE *probe )           // - list
+{
+    HC_PROBE *next;
+
+    for( ; probe != NULL; probe = next ) {
+        next = probe->next;
+        CMemFree( probe );
+    }
+}
+
+
+static HC_PROBE *addProbe(      // ADD A PROBE TO THE END OF A LIST
+    HC_PROBE **list,            // - list
+    const char *dir,            // - directory name
+    time_t mtime )              // - time stamp
+{
+    HC_PROBE *probe;
+    size_t len;
+
+    for( ; *list != NULL; list = &(*list)->next ) {
+        if( strcmp( (*list)->name, dir ) == 0 ) {
+            return( *list );
+        }
+    }
+    len = strlen( dir );
+    probe = CMemAlloc( sizeof( *probe ) + len );
+    probe->next = NULL;
+    probe->mtime = mtime;
+    memcpy( probe->name, dir, len + 1 );
+    *list = probe;
+    return( probe );
+}
+
+
+static HC_ENTRY *findEntry(     // FIND A CACHE ENTRY
+    HC_KIND kind,               // - kind of entry
+    unsigned key,               // - hash key
+    const char *name )          // - name
+{
+    HC_ENTRY *entry;
+
+    for( entry = hcacheTable[key % HC_HASH_SIZE]; entry != NULL; entry = entry->next ) {
+        if( entry->key == key && entry->kind == kind && strcmp( entry->name, name ) == 0 ) {
+            break;
+        }
+    }
+    return( entry );
+}
+
+
+static HC_ENTRY *addEntry(      // ADD OR RESET A CACHE ENTRY
+    HC_KIND kind,               // - kind of entry
+    unsigned key,               // - hash key
+    const char *name )          // - name
+{
+    HC_ENTRY *entry;
+    HC_ENTRY **head;
+    size_t len;
+
+    entry = findEntry( kind, key, name );
+    if( entry != NULL ) {
+        CMemFreePtr( &entry->value );
+        freeProbes( entry->probes );
+        entry->probes = NULL;
+        entry->mtime = 0;
+        entry->dirty = false;
+        return( entry );
+    }
+    len = strlen( name );
+    entry = CMemAlloc( sizeof( *entry ) + len );
+    entry->key = key;
+    entry->kind = kind;
+    entry->dirty = false;
+    entry->mtime = 0;
+    entry->value = NULL;
+    entry->probes = NULL;
+    memcpy( entry->name, name, len + 1 );
+    head = &hcacheTable[key % HC_HASH_SIZE];
+    entry->next = *head;
+    *head = entry;
+    return( entry );
+}
+
+
+static void makeCacheFileName(  // MAKE NAME OF THE CACHE FILE
+    char *buff )                // - buffer (_MAX_PATH)
+{
+    char *p;
+
+    p = stxpcpy( buff, hcacheDir );
+    if( p > buff && !IS_PATH_SEP( p[-1] ) ) {
+        *p++ = DIR_SEP;
+    }
+    strcpy( p, HC_FILE_NAME );
+}
+
+
+static char *readLine(          // READ A LINE OF THE CACHE FILE
+    char *buff,                 // - buffer
+    int size,                   // - buffer size
+    FILE *fp )                  // - cache file
+{
+    char *p;
+
+    if( fgets( buff, size, fp ) == NULL ) {
+        return( NULL );
+    }
+    p = strchr( buff, '\n' );
+    if( p == NULL ) {
+        return( NULL );
+    }
+    *p = '\0';
+    return( buff );
+}
+
+
+static void readCacheFile(      // READ THE CACHE FILE
+    bool merge )                // - true ==> keep entries changed by this compile
+{
+    FILE *fp;
+    HC_ENTRY *entry;
+    HC_KIND kind;
+    unsigned key;
+    unsigned long mtime;
+    int pos;
+    bool skip;
+    char buff[_MAX_PATH * 2];
+
+    makeCacheFileName( buff );
+    fp = fopen( buff, "r" );
+    if( fp == NULL )
+        return;
+    if( readLine( buff, sizeof( buff ), fp ) != NULL && strcmp( buff, HC_SIGNATURE ) == 0 ) {
+        entry = NULL;
+        skip = false;
+        while( readLine( buff, sizeof( buff ), fp ) != NULL ) {
+            pos = 0;
+            mtime = 0;
+            if( sscanf( buff, "R %x %n", &key, &pos ) == 1 && pos > 0 ) {
+                kind = HC_RESOLVE;
+            } else if( sscanf( buff, "G %lu %n", &mtime, &pos ) == 1 && pos > 0 ) {
+                kind = HC_GUARD;
+                key = hashString( HC_HASH_INIT, buff + pos );
+            } else if( buff[0] == 'V' && buff[1] == ' ' ) {
+                if( entry != NULL )
+                    entry->value = CMemStrDup( buff + 2 );
+                if( entry != NULL || skip )
+                    continue;
+                break;
+            } else if( sscanf( buff, "P %lu %n", &mtime, &pos ) == 1 && pos > 0 ) {
+                if( entry != NULL )
+                    addProbe( &entry->probes, buff + pos, (time_t)mtime );
+                if( entry != NULL || skip )
+                    continue;
+                break;
+            } else {
+                break;
+            }
+            // what this compile found is newer than what is on disk
+            entry = findEntry( kind, key, buff + pos );
+            skip = ( merge && entry != NULL && entry->dirty );
+            if( skip ) {
+                entry = NULL;
+            } else {
+                entry = addEntry( kind, key, buff + pos );
+                entry->mtime = (time_t)mtime;
+            }
+        }
+    }
+    fclose( fp );
+}
+
+
+static void loadCache(          // READ THE CACHE FILE, IF NOT YET DONE
+    void )
+{
+    if( hcacheLoaded )
+        return;
+    hcacheLoaded = true;
+    readCacheFile( false );
+}
+
+
+static bool lockCache(          // LOCK THE CACHE FILE
+    const char *lock )          // - name of the lock file
+{
+    int fh;
+    unsigned tries;
+    time_t ltime;
+
+    for( tries = 0; ; ++tries ) {
+        fh = open( lock, O_WRONLY | O_CREAT | O_EXCL | O_BINARY, PMODE_RW );
+        if( fh != -1 ) {
+            close( fh );
+            return( true );
+        }
+        if( errno != EEXIST || tries == HC_LOCK_TRIES )
+            return( false );
+        ltime = SysFileTime( lock );
+        if( ltime != 0 && time( NULL ) - ltime > HC_LOCK_STALE ) {
+            remove( lock );
+        } else {
+            sleep( 1 );
+        }
+    }
+}
+
+
+static void saveCache(          // WRITE THE CACHE FILE
+    void )
+{
+    FILE *fp;
+    HC_ENTRY *entry;
+    HC_PROBE *probe;
+    unsigned i;
+    bool ok;
+    char name[_MAX_PATH];
+    char temp[_MAX_PATH + 16];
+    char lock[_MAX_PATH + 16];
+
+    makeCacheFileName( name );
+    // concurrent compiles serialize on the lock and each one merges what
+    // the others saved meanwhile, so no update is lost; the data is written
+    // to a private copy first so that readers never see a partial file
+    sprintf( lock, "%s" HC_LOCK_EXT, name );
+    if( !lockCache( lock ) )
+        return;
+    readCacheFile( true );
+    sprintf( temp, "%s.%u", name, (unsigned)getpid() );
+    fp = fopen( temp, "w" );
+    if( fp == NULL ) {
+        remove( lock );
+        return;
+    }
+    fprintf( fp, "%s\n", HC_SIGNATURE );
+    for( i = 0; i < HC_HASH_SIZE; ++i ) {
+        for( entry = hcacheTable[i]; entry != NULL; entry = entry->next ) {
+            if( entry->kind == HC_RESOLVE ) {
+                fprintf( fp, "R %x %s\n", entry->key, entry->name );
+            } else {
+                fprintf( fp, "G %lu %s\n", (unsigned long)entry->mtime, entry->name );
+            }
+            if( entry->value != NULL ) {
+                fprintf( fp, "V %s\n", entry->value );
+            }
+            for( probe = entry->probes; probe != NULL; probe = probe->next ) {
+                fprintf( fp, "P %lu %s\n", (unsigned long)probe->mtime, probe->name );
+            }
+        }
+    }
+    ok = ( ferror( fp ) == 0 );
+    if( fclose( fp ) != 0 )
+        ok = false;
+    if( ok ) {
+        remove( name );
+        ok = ( rename( temp, name ) == 0 );
+    }
+    if( !ok ) {
+        remove( temp );
+    }
+    remove( lock );
+}
+
+
+char **HCacheDirPtr(            // GET LOCATION OF CACHE DIRECTORY NAME
+    void )
+{
+    return( &hcacheDir );
+}
+
+
+unsigned HCacheKey(             // COMPUTE KEY FOR AN #include, 0 ==> NO CACHING
+    const char *file_name,      // - name in #include
+    const char *alias_name,     // - alias of the name
+    src_file_type typ )         // - type of file
+{
+    unsigned key;
+    SRCFILE curr;
+    LINE_NO dummy;
+    char buff[_MAX_PATH];
+
+    if( hcacheDir == NULL )
+        return( 0 );
+    switch( typ ) {
+    case FT_HEADER:
+    case FT_HEADER_FORCED:
+    case FT_LIBRARY:
+        break;
+    default:
+        return( 0 );
+    }
+    if( HAS_PATH( file_name ) )
+        return( 0 );
+    loadCache();
+    // everything which steers the search in doIoSuppOpenSrc goes into the key
+    key = HC_HASH_STEP( HC_HASH_INIT, typ );
+    key = HC_HASH_STEP( key, CompFlags.ignore_default_dirs );
+    key = HC_HASH_STEP( key, CompFlags.ignore_current_dir );
+    key = HC_HASH_STEP( key, CompFlags.check_truncated_fnames );
+    key = HC_HASH_STEP( key, CompFlags.dont_autogen_ext_inc );
+    key = hashString( key, file_name );
+    key = hashString( key, ( alias_name != file_name ) ? alias_name : NULL );
+    if( getcwd( buff, sizeof( buff ) ) != NULL ) {
+        key = hashString( key, buff );
+    }
+    for( curr = SrcFileCurrent(); curr != NULL; curr = SrcFileIncluded( curr, &dummy ) ) {
+        dirOfFile( buff, SrcFileName( curr ) );
+        key = hashString( key, buff );
+    }
+    HFileListStart();
+    for( ;; ) {
+        HFileListNext( buff );
+        if( *buff == '\0' )
+            break;
+        key = hashString( key, buff );
+    }
+    if( key == 0 )
+        key = 1;
+    return( key );
+}
+
+
+const char *HCacheLookup(       // LOOK UP CACHED RESOLUTION OF AN #include
+    unsigned key,               // - key from HCacheKey
+    const char *file_name )     // - name in #include
+{
+    HC_ENTRY *entry;
+    HC_PROBE *probe;
+
+    entry = findEntry( HC_RESOLVE, key, file_name );
+    if( entry == NULL || entry->value == NULL )
+        return( NULL );
+    for( probe = entry->probes; probe != NULL; probe = probe->next ) {
+        if( SysFileTime( probe->name ) != probe->mtime ) {
+            return( NULL );
+        }
+    }
+    return( entry->value );
+}
+
+
+void HCacheRecordStart(         // START RECORDING THE SEARCH FOR AN #include
+    void )
+{
+    recording = true;
+    recordProbes = NULL;
+    recordResolved = NULL;
+}
+
+
+void HCacheRecordProbe(         // RECORD AN ATTEMPT TO OPEN A FILE
+    const char *name,           // - file name tried
+    bool opened )               // - true ==> file was opened
+{
+    char dir[_MAX_PATH];
+
+    if( !recording )
+        return;
+    if( opened ) {
+        recordResolved = CMemStrDup( name );
+        recording = false;
+    } else {
+        dirOfFile( dir, name );
+        addProbe( &recordProbes, dir, SysFileTime( dir ) );
+    }
+}
+
+
+void HCacheRecordEnd(           // FINISH RECORDING THE SEARCH FOR AN #include
+    unsigned key,               // - key from HCacheKey
+    const char *file_name,      // - name in #include
+    bool ok )                   // - true ==> file was found
+{
+    HC_ENTRY *entry;
+
+    recording = false;
+    if( ok && recordResolved != NULL ) {
+        entry = addEntry( HC_RESOLVE, key, file_name );
+        entry->value = recordResolved;
+        entry->probes = recordProbes;
+        entry->dirty = true;
+        hcacheModified = true;
+    } else {
+        CMemFree( recordResolved );
+        freeProbes( recordProbes );
+    }
+    recordResolved = NULL;
+    recordProbes = NULL;
+}
+
+
+bool HCacheGuardSkip(           // TEST IF CACHED GUARD ALLOWS SKIPPING A FILE
+    const char *name,           // - file name
+    time_t ftime )              // - file time stamp
+{
+    HC_ENTRY *entry;
+
+    if( hcacheDir == NULL || CompFlags.cpp_output || ftime == 0 )
+        return( false );
+    loadCache();
+    entry = findEntry( HC_GUARD, hashString( HC_HASH_INIT, name ), name );
+    if( entry == NULL || entry->value == NULL || entry->mtime != ftime )
+        return( false );
+    return( MacroExists( entry->value, strlen( entry->value ) ) );
+}
+
+
+void HCacheSetGuard(            // RECORD GUARD OF A HEADER FILE
+    const char *name,           // - file name
+    time_t ftime,               // - file time stamp
+    const char *guard )         // - #ifndef macro or NULL
+{
+    HC_ENTRY *entry;
+    unsigned key;
+
+    if( hcacheDir == NULL || ftime == 0 )
+        return;
+    loadCache();
+    key = hashString( HC_HASH_INIT, name );
+    entry = findEntry( HC_GUARD, key, name );
+    if( entry != NULL && entry->mtime == ftime ) {
+        if( guard == NULL && entry->value == NULL )
+            return;
+        if( guard != NULL && entry->value != NULL && strcmp( guard, entry->value ) == 0 ) {
+            return;
+        }
+    }
+    entry = addEntry( HC_GUARD, key, name );
+    entry->mtime = ftime;
+    if( guard != NULL ) {
+        entry->value = CMemStrDup( guard );
+    }
+    entry->dirty = true;
+    hcacheModified = true;
+}
+
+
+static void hcacheInit(         // INITIALIZE FOR INCLUDE FILE CACHE
+    INITFINI* defn )            // - definition
+{
+    /* unused parameters */ (void)defn;
+
+    hcacheDir = NULL;
+    hcacheLoaded = false;
+    hcacheModified = false;
+    recording = false;
+    memset( hcacheTable, 0, sizeof( hcacheTable ) );
+}
+
+
+static void hcacheFini(         // WRITE AND FREE INCLUDE FILE CACHE
+    INITFINI* defn )            // - definition
+{
+    HC_ENTRY *entry;
+    HC_ENTRY *next;
+    unsigned i;
+
+    /* unused parameters */ (void)defn;
+
+    if( hcacheDir != NULL && hcacheModified ) {
+        saveCache();
+    }
+    for( i = 0; i < HC_HASH_SIZE; ++i ) {
+        for( entry = hcacheTable[i]; entry != NULL; entry = next ) {
+            next = entry->next;
+            CMemFree( entry->value );
+            freeProbes( entry->probes );
+            CMemFree( entry );
+        }
+        hcacheTable[i] = NULL;
+    }
+    CMemFreePtr( &hcacheDir );
+}
+
+
+INITDEFN( hdr_cache, hcacheInit, hcacheFini )
@@ -44,6 +44,7 @@
 #include "cgdata.h"
 #include "fname.h"
 #include "hfile.h"
+#include "hcache.h"
 #include "initdefs.h"
 #include "stats.h"
 #include "pcheader.h"
@@ -340,13 +341,22 @@ static bool openSrc(            // ATTEMPT TO OPEN FILE
 
     if( SrcFileProcessOnce( name ) ) {
         SrcFileOpen( NULL, name, 0 );
+        HCacheRecordProbe( name, true );
         return( true );
     }
     ftime = SysFileTime( name );
+    if( !CompFlags.watch_for_pcheader && HCacheGuardSkip( name, ftime ) ) {
+        // guard macro recorded by an earlier compile is already defined
+        SrcFileOpen( NULL, name, ftime );
+        HCacheRecordProbe( name, true );
+        return( true );
+    }
     fp = SrcFileFOpen( name, SFO_SOURCE_FILE );
     if( fp == NULL ) {
+        HCacheRecordProbe( name, false );
         return( false );
     }
+    HCacheRecordProbe( name, true );
 #ifdef OPT_BR
     might_browse = false;
 #endif
@@ -717,6 +727,9 @@ bool IoSuppOpenSrc(             // OPEN A SOURCE FILE (PRIMARY,HEADER)
     pgroup2     fa;             // - descriptor for alias file name
     pgroup2     *fap;           // - pointer to descriptor for alias file name
     const char  *alias_file_name;
+    const char  *cached_name;   // - file name from include file cache
+    unsigned    hc_key;         // - include file cache key
+    bool        ok;             // - return: true ==> opened
 
 #ifdef OPT_BR
     if( NULL != file_name
@@ -737,6 +750,7 @@ bool IoSuppOpenSrc(             // OPEN A SOURCE FILE (PRIMARY,HEADER)
     _splitpath2( file_name, fd.buffer, &fd.drive, &fd.dir, &fd.fname, &fd.ext );
     normalizeSep( fd.dir );
     fap = NULL;
+    alias_file_name = file_name;
     switch( typ ) {
     case FT_HEADER:
     case FT_HEADER_FORCED:
@@ -751,7 +765,25 @@ bool IoSuppOpenSrc(             // OPEN A SOURCE FILE (PRIMARY,HEADER)
         }
         break;
     }
-    return( doIoSuppOpenSrc( &fd, fap, typ ) );
+    hc_key = HCacheKey( file_name, alias_file_name, typ );
+    if( hc_key != 0 ) {
+        cached_name = HCacheLookup( hc_key, file_name );
+        if( cached_name != NULL ) {
+            // name is copied by the open, cache entry may be replaced later
+            if( openSrc( (char *)cached_name, typ ) ) {
+                if( typ == FT_LIBRARY ) {
+                    SetSrcFileLibrary();
+                }
+                return( true );
+            }
+        }
+        HCacheRecordStart();
+    }
+    ok = doIoSuppOpenSrc( &fd, fap, typ );
+    if( hc_key != 0 ) {
+        HCacheRecordEnd( hc_key, file_name, ok );
+    }
+    return( ok );
 }
 
 static void ioSuppError(        // SIGNAL I/O ERROR AND ABORT
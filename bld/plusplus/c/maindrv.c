@@ -38,6 +38,10 @@
 #endif
 #include "memmgr.h"
 #include "idedrv.h"
+#if defined( __UNIX__ ) && !defined( __QNX__ )
+    #define USE_IDESRV
+    #include "idesrv.h"
+#endif
 
 #include "clibint.h"
 #include "clibext.h"
@@ -52,11 +56,58 @@
 #define DLL_NAME_STR    _str(DLL_NAME)
 
 
+static int exitStatus( IDEDRV *inf, int retcode )
+/***********************************************/
+{
+    switch( retcode ) {
+    case IDEDRV_SUCCESS:
+    case IDEDRV_ERR_RUN:
+    case IDEDRV_ERR_RUN_EXEC:
+    case IDEDRV_ERR_RUN_FATAL:
+        break;
+    default:
+        IdeDrvPrintError( inf );
+        break;
+    }
+    return( retcode == IDEDRV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+
+#ifdef __UNIX__
+static int runArgv( IDEDRV *inf, int argc, char **argv )
+/******************************************************/
+{
+    return( exitStatus( inf, IdeDrvExecDLLArgv( inf, argc, argv ) ) );
+}
+#endif
+
+#ifdef USE_IDESRV
+static bool isServerOption( char const *arg, char const **dir )
+/*************************************************************/
+{
+    size_t  len;
+
+    len = sizeof( IDESRV_OPTION ) - 1;
+    if( strncmp( arg, IDESRV_OPTION, len ) != 0 )
+        return( false );
+    if( arg[len] == '\0' ) {
+        *dir = NULL;
+    } else if( arg[len] == '=' ) {
+        *dir = arg + len + 1;
+    } else {
+        return( false );
+    }
+    return( true );
+}
+#endif
+
 int main( int argc, char *argv[] )
 /********************************/
 {
-    int         retcode;
+    int         status;
     IDEDRV      info;
+#ifdef USE_IDESRV
+    char const  *dir;
+#endif
 #ifndef __UNIX__
     int         cmd_len;
     char        *cmd_line;
@@ -70,26 +121,22 @@ int main( int argc, char *argv[] )
 #endif
 
     IdeDrvInit( &info, DLL_NAME_STR, NULL );
-#ifdef __UNIX__
-    retcode = IdeDrvExecDLLArgv( &info, argc, argv );
+#if defined( USE_IDESRV )
+    if( argc == 2 && isServerOption( argv[1], &dir ) ) {
+        status = IdeSrvServe( &info, dir, runArgv );
+    } else if( !IdeSrvClient( DLL_NAME_STR, argc, argv, &status ) ) {
+        status = runArgv( &info, argc, argv );
+    }
+#elif defined( __UNIX__ )
+    status = runArgv( &info, argc, argv );
 #else
     cmd_len = _bgetcmd( NULL, 0 ) + 1;
     cmd_line = malloc( cmd_len );
     if( cmd_line != NULL )
         _bgetcmd( cmd_line, cmd_len );
-    retcode = IdeDrvExecDLL( &info, cmd_line );
+    status = exitStatus( &info, IdeDrvExecDLL( &info, cmd_line ) );
     free( cmd_line );
 #endif
-    switch( retcode ) {
-    case IDEDRV_SUCCESS:
-    case IDEDRV_ERR_RUN:
-    case IDEDRV_ERR_RUN_EXEC:
-    case IDEDRV_ERR_RUN_FATAL:
-        break;
-    default:
-        IdeDrvPrintError( &info );
-        break;
-    }
     IdeDrvUnloadDLL( &info );
-    return( retcode == IDEDRV_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE );
+    return( status );
 }
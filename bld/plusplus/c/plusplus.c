@@ -101,7 +101,12 @@ static void CloseFiles( void )
         if( ferror( CppFile ) ) {
             /* issue message */
         }
-        IoSuppCloseFile( &CppFile );
+        if( CppFile == stdout ) {
+            /* a reused compiler writes to it again */
+            CppFile = NULL;
+        } else {
+            IoSuppCloseFile( &CppFile );
+        }
     }
     IoSuppCloseFile( &DefFile );
 }
@@ -46,6 +46,7 @@
 #include "pcheader.h"
 #include "initdefs.h"
 #include "iosupp.h"
+#include "hcache.h"
 #include "pathlist.h"
 #ifdef DEVBUILD
     #include "pragdefn.h"
@@ -532,6 +533,11 @@ bool SrcFileClose(              // CLOSE A SOURCE FILE
         default:
             actual->guard_state = GUARD_INCLUDE;
         }
+        if( browsed && old_src->parent != NULL ) {
+            // remember guard for later compiles (-fhc)
+            HCacheSetGuard( actual->name, actual->time_stamp
+                          , ( actual->guard_state == GUARD_IFNDEF ) ? actual->ifndef_name : NULL );
+        }
     }
     if( old_src->cmdline ) {
         popSrcFile( old_src, act );
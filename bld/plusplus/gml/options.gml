@@ -544,6 +544,12 @@
 :usage.  use pre-compiled header (PCH) file
 :jusage. プリコンパイル･ヘッダー(PCH)を使用します
 
+:option. fhc
+:target. any
+:path.
+:usage.  cache #include lookups and guards in <path>
+:jusage. #includeの検索結果とガードを<path>にキャッシュします
+
 :option. fhd
 :target. any
 :usage.  store debug info for PCH once (DWARF only)
@@ -0,0 +1,81 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Persistent include file cache (-fhc option).
+*
+****************************************************************************/
+
+
+// HCACHE.H -- persistent cache of #include resolutions and include guards
+//
+// The cache lives in a directory given by -fhc=<dir> and is shared by all
+// compiles which name that directory. It remembers:
+//
+//  (1) for an #include in a given search context, the file which was
+//      opened and the directories which were probed without success
+//
+//  (2) for a header file with a given time stamp, the #ifndef macro which
+//      guards the whole file
+//
+// A resolution is reused only when all probed directories still have the
+// time stamps which were recorded, so a header added earlier in the search
+// path is still found.
+
+
+// PROTOTYPES:
+
+char **HCacheDirPtr(            // GET LOCATION OF CACHE DIRECTORY NAME
+    void );
+
+unsigned HCacheKey(             // COMPUTE KEY FOR AN #include, 0 ==> NO CACHING
+    const char *file_name,      // - name in #include
+    const char *alias_name,     // - alias of the name
+    src_file_type typ );        // - type of file
+
+const char *HCacheLookup(       // LOOK UP CACHED RESOLUTION OF AN #include
+    unsigned key,               // - key from HCacheKey
+    const char *file_name );    // - name in #include
+
+void HCacheRecordStart(         // START RECORDING THE SEARCH FOR AN #include
+    void );
+
+void HCacheRecordProbe(         // RECORD AN ATTEMPT TO OPEN A FILE
+    const char *name,           // - file name tried
+    bool opened );              // - true ==> file was opened
+
+void HCacheRecordEnd(           // FINISH RECORDING THE SEARCH FOR AN #include
+    unsigned key,               // - key from HCacheKey
+    const char *file_name,      // - name in #include
+    bool ok );                  // - true ==> file was found
+
+bool HCacheGuardSkip(           // TEST IF CACHED GUARD ALLOWS SKIPPING A FILE
+    const char *name,           // - file name
+    time_t ftime );             // - file time stamp
+
+void HCacheSetGuard(            // RECORD GUARD OF A HEADER FILE
+    const char *name,           // - file name
+    time_t ftime,               // - file time stamp
+    const char *guard );        // - #ifndef macro or NULL
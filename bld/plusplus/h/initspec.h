@@ -91,6 +91,7 @@ EXIT_BEG( cpp )                 // entire compiler
   EXIT_REG( rtf_names )
   EXIT_REG( pchdrs )
   EXIT_REG( h_files )
+  EXIT_REG( hdr_cache )
   EXIT_REG( file_names )
   EXIT_REG( io_support )
 #ifdef XTRA_RPT
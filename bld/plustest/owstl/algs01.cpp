@@ -50,9 +50,11 @@ struct test_case {
     int   size;               // The number of elements in input I care about.
 };
 
-// The test cases. The current version of std::sort uses QuickSort but falls over to
-// InsertionSort on subsequences of length <= 10. Thus it is important to use test cases that
-// are longer than 10 to properly exercise both algorithms.
+// The test cases. The current version of std::sort uses introsort (QuickSort that falls back to
+// HeapSort when the recursion gets too deep) but falls over to InsertionSort on subsequences of
+// length <= 10. Thus it is important to use test cases that are longer than 10 to properly
+// exercise both algorithms. std::stable_sort uses InsertionSort below 15 elements, so only the
+// longest cases exercise its merging.
 //
 // Note that the 'title' member is no longer used but it is retained for documentation and
 // possible future use.
@@ -443,6 +445,136 @@ bool permutation_test( )
 }
 
 
+bool long_sort_test( )
+{
+    // These sequences are long enough for the introsort depth limit and the heap sort fallback
+    // to matter. Organ pipe input is a classic bad case for median-of-three pivots.
+    const int size = 1000;
+    std::vector< int > v( size );
+    bool worked;
+
+    for( int i = 0; i < size; ++i ) v[i] = ( i < size / 2 ) ? i : size - i;
+    std::sort( v.begin( ), v.end( ) );
+    worked = true;
+    for( int i = 1; i < size; ++i ) if( v[i] < v[i - 1] ) worked = false;
+    if( !worked ) FAIL;
+
+    for( int i = 0; i < size; ++i ) v[i] = ( i % 2 ) ? i : size - i;
+    std::sort( v.begin( ), v.end( ), std::greater< int >( ) );
+    worked = true;
+    for( int i = 1; i < size; ++i ) if( v[i] > v[i - 1] ) worked = false;
+    if( !worked ) FAIL;
+
+    for( int i = 0; i < size; ++i ) v[i] = ( i * 7919 ) % 5;
+    std::sort( v.begin( ), v.end( ) );
+    worked = true;
+    for( int i = 1; i < size; ++i ) if( v[i] < v[i - 1] ) worked = false;
+    if( !worked ) FAIL;
+
+    return( true );
+}
+
+// Used to check that stable_sort and inplace_merge keep equal keys in their original order.
+struct keyed {
+    int key;
+    int seq;
+};
+
+struct key_less {
+    bool operator()( const keyed &x, const keyed &y ) const
+        { return( x.key < y.key ); }
+};
+
+static bool keyed_ok( const std::vector< keyed > &v )
+{
+    for( std::vector< keyed >::size_type i = 1; i < v.size( ); ++i ) {
+        if( v[i].key < v[i - 1].key ) return( false );
+        if( v[i].key == v[i - 1].key && v[i].seq < v[i - 1].seq ) return( false );
+    }
+    return( true );
+}
+
+bool stable_sort_test( )
+{
+    // First I must copy the test cases to avoid leaving them sorted.
+    test_case *tc = new test_case[number_cases];
+    for( int i = 0; i < number_cases; ++i ) tc[i] = tests[i];
+
+    // For each test...
+    for( int i = 0; i < number_cases; ++i ) {
+
+        // Do the test.
+        std::stable_sort( &tc[i].input[0], &tc[i].input[tc[i].size] );
+
+        // Did it work?
+        bool worked = true;
+        for( int j = 0; j < tc[i].size; ++j ) {
+            if ( tc[i].input[j] != tc[i].expected[j] ) worked = false;
+        }
+        if ( !worked ) FAIL;
+    }
+    delete [] tc;
+
+    tc = new test_case[number_reverse_cases];
+    for( int i = 0; i < number_reverse_cases; ++i ) tc[i] = reverse_tests[i];
+    for( int i = 0; i < number_reverse_cases; ++i ) {
+        std::stable_sort( &tc[i].input[0], &tc[i].input[tc[i].size], std::greater< int >( ) );
+        bool worked = true;
+        for( int j = 0; j < tc[i].size; ++j ) {
+            if ( tc[i].input[j] != tc[i].expected[j] ) worked = false;
+        }
+        if ( !worked ) FAIL;
+    }
+    delete [] tc;
+
+    // Stability: many equal keys, tagged with their original position.
+    for( int size = 0; size < 300; size += 13 ) {
+        std::vector< keyed > v( size );
+        for( int i = 0; i < size; ++i ) {
+            v[i].key = ( i * 37 ) % 7;
+            v[i].seq = i;
+        }
+        std::stable_sort( v.begin( ), v.end( ), key_less( ) );
+        if( !keyed_ok( v ) ) FAIL;
+    }
+
+    // Strings, so that the merge buffer holds objects with nontrivial copies.
+    std::vector< std::string > s;
+    for( int i = 0; i < 40; ++i ) {
+        s.push_back( std::string( 1, static_cast< char >( 'z' - i % 26 ) ) );
+    }
+    std::stable_sort( s.begin( ), s.end( ) );
+    for( int i = 1; i < 40; ++i ) if( s[i] < s[i - 1] ) FAIL;
+
+    return( true );
+}
+
+bool inplace_merge_test( )
+{
+    const int size = 100;
+
+    for( int middle = 0; middle <= size; middle += 9 ) {
+        std::vector< keyed > v( size );
+        for( int i = 0; i < size; ++i ) {
+            v[i].key = ( i < middle ) ? i % 10 : ( i - middle ) % 10;
+            v[i].seq = 0;
+        }
+        std::sort( v.begin( ), v.begin( ) + middle, key_less( ) );
+        std::sort( v.begin( ) + middle, v.end( ), key_less( ) );
+        for( int i = 0; i < size; ++i ) v[i].seq = i;
+
+        std::inplace_merge( v.begin( ), v.begin( ) + middle, v.end( ), key_less( ) );
+        if( !keyed_ok( v ) ) FAIL;
+    }
+
+    int data[] = { 1, 4, 7, 8, 2, 3, 5, 6, 9 };
+    std::inplace_merge( data, data + 4, data + 9 );
+    for( int i = 0; i < 9; ++i ) if( data[i] != i + 1 ) FAIL;
+
+    return( true );
+}
+
+
 int main( )
 {
     int rc = 0;
@@ -456,6 +588,9 @@ int main( )
         if( !bsearch_test( )         || !heap_ok( "t05" ) ) rc = 1;
         if( !lexicographical_test( ) || !heap_ok( "t06" ) ) rc = 1;
         if( !permutation_test( )     || !heap_ok( "t07" ) ) rc = 1;
+        if( !long_sort_test( )       || !heap_ok( "t08" ) ) rc = 1;
+        if( !stable_sort_test( )     || !heap_ok( "t09" ) ) rc = 1;
+        if( !inplace_merge_test( )   || !heap_ok( "t10" ) ) rc = 1;
     }
     catch( ... ) {
         std::cout << "Unexpected exception of unexpected type.\n";
@@ -0,0 +1,174 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Functional tests for unordered map.
+*
+****************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "sanity.cpp"
+
+/* ------------------------------------------------------------------
+ * construct_test( )
+ * Construct maps in different ways.
+ */
+bool construct_test( )
+{
+    typedef std::unordered_map< int, int > umii_t;
+    umii_t m1;
+    if( INSANE( m1 ) || m1.size( ) || !m1.empty( ) ) FAIL
+
+    std::pair< int, int > init[] = {
+        std::pair< int, int >( 1, 10 ), std::pair< int, int >( 2, 20 ),
+        std::pair< int, int >( 3, 30 ), std::pair< int, int >( 1, 40 ) };
+    umii_t m2( init, init + 4 );
+    if( INSANE( m2 ) || m2.size( ) != 3 || m2[1] != 10 ) FAIL
+
+    umii_t m3( m2 );
+    if( INSANE( m3 ) || m3 != m2 ) FAIL
+    m3[2] = 21;
+    if( m3 == m2 ) FAIL
+    m1 = m3;
+    if( INSANE( m1 ) || m1 != m3 ) FAIL
+
+    std::unordered_multimap< int, int > m4( init, init + 4 );
+    if( INSANE( m4 ) || m4.size( ) != 4 || m4.count( 1 ) != 2 ) FAIL
+    return( true );
+}
+
+/* ------------------------------------------------------------------
+ * access_test( )
+ * operator[], at, insert, find, erase
+ */
+bool access_test( )
+{
+    typedef std::unordered_map< std::string, int > umsi_t;
+    umsi_t m1;
+    char key[8];
+    int i;
+
+    for( i = 0; i < 300; ++i ) {
+        key[0] = 'a' + i % 26;
+        key[1] = 'a' + i / 26;
+        key[2] = '\0';
+        m1[key] = i;
+        if( m1.size( ) != i + 1 ) FAIL
+    }
+    if( INSANE( m1 ) ) FAIL
+    if( m1["ba"] != 1 || m1.at( "ab" ) != 26 ) FAIL
+
+    bool thrown = false;
+    try {
+        m1.at( "none" );
+    }
+    catch( std::out_of_range & ) {
+        thrown = true;
+    }
+    if( !thrown ) FAIL
+
+    std::pair< umsi_t::iterator, bool > ans;
+    ans = m1.insert( umsi_t::value_type( "aa", 99 ) );
+    if( ans.second || ans.first->second != 0 ) FAIL
+    ans = m1.insert( umsi_t::value_type( "zzz", 99 ) );
+    if( !ans.second || ans.first->second != 99 || m1.size( ) != 301 ) FAIL
+
+    // references stay valid when the table grows
+    int *p = &m1["zzz"];
+    m1.rehash( m1.bucket_count( ) * 8 );
+    if( INSANE( m1 ) || p != &m1["zzz"] ) FAIL
+
+    umsi_t::iterator it = m1.find( "zzz" );
+    it = m1.erase( it );
+    if( INSANE( m1 ) || m1.size( ) != 300 || m1.count( "zzz" ) ) FAIL
+    if( m1.erase( "aa" ) != 1 || m1.erase( "aa" ) != 0 ) FAIL
+    if( INSANE( m1 ) || m1.size( ) != 299 ) FAIL
+    m1.clear( );
+    if( INSANE( m1 ) || !m1.empty( ) || m1.find( "ba" ) != m1.end( ) ) FAIL
+    return( true );
+}
+
+/* ------------------------------------------------------------------
+ * multi_test( )
+ * equivalent keys, kept in insertion order
+ */
+bool multi_test( )
+{
+    typedef std::unordered_multimap< int, int > ummii_t;
+    ummii_t m1;
+    int i;
+
+    for( i = 0; i < 200; ++i ) {
+        m1.insert( ummii_t::value_type( i % 7, i ) );
+    }
+    if( INSANE( m1 ) || m1.size( ) != 200 ) FAIL
+    for( i = 0; i < 7; ++i ) {
+        std::pair< ummii_t::iterator, ummii_t::iterator > r = m1.equal_range( i );
+        int last = -1;
+        int n = 0;
+        for( ; r.first != r.second; ++r.first ) {
+            if( r.first->first != i || r.first->second <= last ) FAIL
+            last = r.first->second;
+            ++n;
+        }
+        if( n != m1.count( i ) ) FAIL
+    }
+    // erase the first of a group, then the rest
+    m1.erase( m1.find( 3 ) );
+    if( INSANE( m1 ) || m1.find( 3 )->second != 10 ) FAIL
+    if( m1.erase( 3 ) != 28 ) FAIL
+    if( INSANE( m1 ) || m1.size( ) != 200 - 29 ) FAIL
+
+    ummii_t m2( m1 );
+    if( INSANE( m2 ) || m2 != m1 ) FAIL
+    return( true );
+}
+
+
+int main( )
+{
+    int rc = 0;
+    int original_count = heap_count( );
+
+    try {
+        if( !construct_test( ) || !heap_ok( "t01" ) ) rc = 1;
+        if( !access_test( )    || !heap_ok( "t02" ) ) rc = 1;
+        if( !multi_test( )     || !heap_ok( "t03" ) ) rc = 1;
+    }
+    catch( ... ) {
+        std::cout << "Unexpected exception of unexpected type.\n";
+        rc = 1;
+    }
+
+    if( heap_count( ) != original_count ) {
+        std::cout << "Possible memory leak!\n";
+        rc = 1;
+    }
+    return( rc );
+}
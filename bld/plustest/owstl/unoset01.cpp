@@ -29,36 +29,181 @@
 ****************************************************************************/
 
 #include <iostream>
+#include <string>
 #include <unordered_set>
 
 #include "sanity.cpp"
 
-bool some_test( )
+/* ------------------------------------------------------------------
+ * construct_test( )
+ * Construct sets in different ways.
+ */
+bool construct_test( )
 {
-  bool rc = true;
+    typedef std::unordered_set< int > usi_t;
 
-  // Exercise some facility here.
+    usi_t s1;
+    if( INSANE( s1 ) || s1.size( ) || !s1.empty( ) ) FAIL
+    if( s1.begin( ) != s1.end( ) ) FAIL
 
-  return( rc );
+    usi_t s2( 100 );
+    if( INSANE( s2 ) || s2.size( ) || s2.bucket_count( ) < 100 ) FAIL
+
+    int init[] = { 1, 2, 3, 4, 3, 2, 1 };
+    usi_t s3( init, init + 7 );
+    if( INSANE( s3 ) || s3.size( ) != 4 ) FAIL
+    for( int i = 0; i < 7; ++i ) {
+        if( s3.find( init[i] ) == s3.end( ) ) FAIL
+    }
+
+    usi_t *s4 = new usi_t( s3 );
+    if( INSANE( *s4 ) || s4->size( ) != 4 || *s4 != s3 ) FAIL
+    s1 = *s4;
+    delete s4;
+    if( INSANE( s1 ) || s1.size( ) != 4 || !( s1 == s3 ) ) FAIL
+
+    std::unordered_multiset< int > s5( init, init + 7 );
+    if( INSANE( s5 ) || s5.size( ) != 7 || s5.count( 4 ) != 1 || s5.count( 2 ) != 2 ) FAIL
+    return( true );
+}
+
+/* ------------------------------------------------------------------
+ * access_test( )
+ * insert, find, erase, count on a set large enough to rehash a few times
+ */
+bool access_test( )
+{
+    std::unordered_set< int > s1;
+    int const size = 1000;
+    int i;
+
+    for( i = 0; i < size; ++i ) {
+        std::pair< std::unordered_set< int >::iterator, bool > ans;
+        ans = s1.insert( i * 8 );
+        if( !ans.second || *ans.first != i * 8 || s1.size( ) != i + 1 ) FAIL
+    }
+    if( INSANE( s1 ) ) FAIL
+    if( s1.load_factor( ) > s1.max_load_factor( ) ) FAIL
+    for( i = 0; i < size; ++i ) {
+        if( s1.insert( i * 8 ).second ) FAIL
+        if( s1.count( i * 8 ) != 1 || s1.count( i * 8 + 1 ) != 0 ) FAIL
+    }
+    if( INSANE( s1 ) || s1.size( ) != size ) FAIL
+
+    // erase every other element, by key and by iterator
+    for( i = 0; i < size; i += 2 ) {
+        if( i % 4 ) {
+            if( s1.erase( i * 8 ) != 1 ) FAIL
+        } else {
+            s1.erase( s1.find( i * 8 ) );
+        }
+    }
+    if( INSANE( s1 ) || s1.size( ) != size / 2 ) FAIL
+    for( i = 0; i < size; ++i ) {
+        if( ( s1.find( i * 8 ) != s1.end( ) ) != ( i % 2 == 1 ) ) FAIL
+    }
+    if( s1.erase( 3 ) != 0 ) FAIL
+
+    // iteration sees each element once
+    int count = 0;
+    std::unordered_set< int >::const_iterator it;
+    for( it = s1.begin( ); it != s1.end( ); ++it ) {
+        if( *it % 16 != 8 ) FAIL
+        ++count;
+    }
+    if( count != size / 2 ) FAIL
+
+    s1.erase( s1.begin( ), s1.end( ) );
+    if( INSANE( s1 ) || !s1.empty( ) ) FAIL
+    return( true );
+}
+
+/* ------------------------------------------------------------------
+ * multi_test( )
+ * equivalent keys stay together
+ */
+bool multi_test( )
+{
+    typedef std::unordered_multiset< std::string > ums_t;
+    ums_t s1;
+    char const *words[] = { "one", "two", "three", "two", "three", "three" };
+
+    for( int i = 0; i < 6; ++i ) {
+        s1.insert( words[i] );
+        if( INSANE( s1 ) || s1.size( ) != i + 1 ) FAIL
+    }
+    if( s1.count( "one" ) != 1 || s1.count( "two" ) != 2 || s1.count( "three" ) != 3 ) FAIL
+    if( s1.count( "four" ) != 0 ) FAIL
+
+    std::pair< ums_t::iterator, ums_t::iterator > r = s1.equal_range( "three" );
+    int n = 0;
+    for( ; r.first != r.second; ++r.first ) {
+        if( *r.first != "three" ) FAIL
+        ++n;
+    }
+    if( n != 3 ) FAIL
+
+    s1.erase( s1.find( "three" ) );
+    if( INSANE( s1 ) || s1.count( "three" ) != 2 ) FAIL
+    if( s1.erase( "two" ) != 2 ) FAIL
+    if( INSANE( s1 ) || s1.size( ) != 3 ) FAIL
+    return( true );
+}
+
+/* ------------------------------------------------------------------
+ * bucket_test( )
+ * bucket interface and hash policy
+ */
+bool bucket_test( )
+{
+    std::unordered_set< long > s1;
+    long i;
+
+    s1.reserve( 500 );
+    std::unordered_set< long >::size_type buckets = s1.bucket_count( );
+    if( buckets < 500 ) FAIL
+    for( i = 0; i < 500; ++i ) {
+        s1.insert( i * 1024 );
+    }
+    if( INSANE( s1 ) || s1.bucket_count( ) != buckets ) FAIL
+
+    std::unordered_set< long >::size_type total = 0;
+    for( std::unordered_set< long >::size_type b = 0; b < s1.bucket_count( ); ++b ) {
+        total += s1.bucket_size( b );
+    }
+    if( total != s1.size( ) ) FAIL
+    std::unordered_set< long >::size_type b = s1.bucket( 1024 );
+    if( s1.bucket_size( b ) != 1 || *s1.begin( b ) != 1024 ) FAIL
+
+    s1.max_load_factor( 0.25f );
+    if( INSANE( s1 ) || s1.load_factor( ) > 0.25f ) FAIL
+    s1.rehash( 0 );
+    if( INSANE( s1 ) || s1.size( ) != 500 ) FAIL
+    s1.clear( );
+    if( INSANE( s1 ) || !s1.empty( ) ) FAIL
+    return( true );
 }
 
 
 int main( )
 {
-  int rc = 0;
-  int original_count = heap_count( );
-
-  try {
-    if( !some_test( )    || !heap_ok( "t01" ) ) rc = 1;
-  }
-  catch( ... ) {
-    std::cout << "Unexpected exception of unexpected type.\n";
-    rc = 1;
-  }
-
-  if( heap_count( ) != original_count ) {
-    std::cout << "Possible memory leak!\n";
-    rc = 1;
-  }
-  return( rc );
+    int rc = 0;
+    int original_count = heap_count( );
+
+    try {
+        if( !construct_test( ) || !heap_ok( "t01" ) ) rc = 1;
+        if( !access_test( )    || !heap_ok( "t02" ) ) rc = 1;
+        if( !multi_test( )     || !heap_ok( "t03" ) ) rc = 1;
+        if( !bucket_test( )    || !heap_ok( "t04" ) ) rc = 1;
+    }
+    catch( ... ) {
+        std::cout << "Unexpected exception of unexpected type.\n";
+        rc = 1;
+    }
+
+    if( heap_count( ) != original_count ) {
+        std::cout << "Possible memory leak!\n";
+        rc = 1;
+    }
+    return( rc );
 }
@@ -0,0 +1,9 @@
+/*****
+ pp18.c - compiled twice with -fhc, the second time from the cache
+\*****/
+#include "pp18.h"
+int line5;
+#include "pp18.h"
+int line7;
+#include "pp18.gh"
+int line9;
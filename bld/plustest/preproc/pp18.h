@@ -0,0 +1,4 @@
+#ifndef PP18_H
+#define PP18_H
+int pp18h_line3;
+#endif
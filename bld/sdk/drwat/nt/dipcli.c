@@ -181,3 +181,17 @@ dig_arch DIPCLIENTRY( CurrArch )( void )
     return( SysConfig.arch );
 }
 
+void *DIPCLIENTRY( MapView )( FILE *fp, unsigned long offset, unsigned long size )
+/********************************************************************************/
+{
+    /* unused parameters */ (void)fp; (void)offset; (void)size;
+
+    return( NULL );
+}
+
+void DIPCLIENTRY( UnmapView )( void *view, unsigned long size )
+/*************************************************************/
+{
+    /* unused parameters */ (void)view; (void)size;
+}
+
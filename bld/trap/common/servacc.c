@@ -36,11 +36,14 @@
 #include "trpld.h"
 #include "trpcore.h"
 #include "trpcomm.h"
+#include "trpbatch.h"
 #include "trperr.h"
 #include "packet.h"
 #include "servio.h"
 #include "nothing.h"
 
+#include "clibext.h"
+
 
 trap_version     TrapVersion;
 
@@ -98,6 +101,141 @@ static void AccLoadProg( void )
     AccTrap( true );
 }
 
+static void AccGetSupp( bool want_return )
+{
+    get_supplementary_service_ret   *ret;
+    char                            *name;
+
+    name = GetInPtr( sizeof( get_supplementary_service_req ) );
+    if( want_return && stricmp( name, QUOTED( BATCH_SUPP_NAME ) ) == 0 ) {
+        /*
+         * the batch service is provided by the server for any trap file
+         */
+        ret = GetOutPtr( 0 );
+        ret->err = 0;
+        ret->id = BATCH_SUPP_ID;
+        PutBuffPacket( RWBuff, sizeof( *ret ) );
+    } else {
+        AccTrap( want_return );
+    }
+}
+
+/*
+ * A batch is performed without looking at the replies, so it may only
+ * hold requests which don't depend on each other. Anything that runs or
+ * changes the program is refused and left for the debugger to send on
+ * its own, so a queued read never sees a state the debugger didn't
+ * expect.
+ */
+static bool BatchAllowed( const void *ptr, trap_elen len )
+{
+    const supp_prefix   *supp;
+
+    switch( *(const trap_req *)ptr ) {
+    case REQ_CONNECT:
+    case REQ_DISCONNECT:
+    case REQ_SUSPEND:
+    case REQ_RESUME:
+    case REQ_PROG_LOAD:
+    case REQ_PROG_KILL:
+    case REQ_PROG_GO:
+    case REQ_PROG_STEP:
+    case REQ_WRITE_MEM:
+    case REQ_WRITE_IO:
+    case REQ_WRITE_REGS:
+    case REQ_SET_BREAK:
+    case REQ_CLEAR_BREAK:
+    case REQ_SET_WATCH:
+    case REQ_CLEAR_WATCH:
+    case REQ_GET_SUPPLEMENTARY_SERVICE:
+        return( false );
+    case REQ_PERFORM_SUPPLEMENTARY_SERVICE:
+        supp = ptr;
+        if( len < sizeof( *supp ) || supp->id == BATCH_SUPP_ID ) {
+            return( false );
+        }
+        break;
+    }
+    return( true );
+}
+
+static void AccBatch( bool want_return )
+{
+    batch_access_req    *acc;
+    batch_access_ret    *ret;
+    batch_access_entry  entry;
+    batch_access_result result;
+    in_mx_entry         in[1];
+    mx_entry            out[1];
+    char                *data;
+    trap_elen           in_left;
+    trap_elen           out_pos;
+    trap_elen           max;
+    trap_elen           len;
+    unsigned            count;
+    unsigned            i;
+
+    acc = GetInPtr( 0 );
+    ret = GetOutPtr( 0 );
+    count = acc->count;
+    data = GetInPtr( sizeof( *acc ) );
+    in_left = In[0].len - sizeof( *acc );
+    max = MaxPacketSize();
+    if( max > sizeof( RWBuff ) )
+        max = sizeof( RWBuff );
+    out_pos = sizeof( *ret );
+    for( i = 0; i < count; i++ ) {
+        if( in_left < sizeof( entry ) )
+            break;
+        memcpy( &entry, data, sizeof( entry ) );
+        CONV_LE_16( entry.in_len );
+        CONV_LE_16( entry.out_len );
+        if( entry.in_len < sizeof( trap_req ) || entry.in_len > in_left - sizeof( entry ) )
+            break;
+        if( out_pos + sizeof( result ) + entry.out_len > max )
+            break;
+        data += sizeof( entry );
+        in_left -= sizeof( entry );
+        if( !BatchAllowed( data, entry.in_len ) )
+            break;
+        in[0].ptr = data;
+        in[0].len = entry.in_len;
+        if( entry.out_len == 0 ) {
+            TrapAccess( 1, in, 0, NULL );
+            len = 0;
+        } else {
+            out[0].ptr = RWBuff + out_pos + sizeof( result );
+            out[0].len = entry.out_len;
+            len = TrapAccess( 1, in, 1, out );
+            if( len > entry.out_len ) {
+                len = 0;
+            }
+        }
+        result.len = len;
+        CONV_LE_16( result.len );
+        memcpy( RWBuff + out_pos, &result, sizeof( result ) );
+        out_pos += sizeof( result ) + len;
+        data += entry.in_len;
+        in_left -= entry.in_len;
+    }
+    ret->count = i;
+    if( want_return ) {
+        PutBuffPacket( RWBuff, out_pos );
+    }
+}
+
+static void AccPerformSupp( bool want_return )
+{
+    supp_prefix     *acc;
+
+    acc = GetInPtr( 0 );
+    if( acc->id == BATCH_SUPP_ID ) {
+        AccBatch( want_return );
+    } else {
+        AccTrap( want_return );
+    }
+}
+
 bool Session( void )
 {
     unsigned    req;
@@ -148,6 +286,12 @@ bool Session( void )
         case REQ_PROG_LOAD:
             AccLoadProg();
             break;
+        case REQ_GET_SUPPLEMENTARY_SERVICE:
+            AccGetSupp( want_return );
+            break;
+        case REQ_PERFORM_SUPPLEMENTARY_SERVICE:
+            AccPerformSupp( want_return );
+            break;
         default:
             AccTrap( want_return );
             break;
@@ -0,0 +1,368 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Test of the batched requests service of the remote server.
+*
+****************************************************************************/
+
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "trptypes.h"
+#include "trpcore.h"
+#include "trpcomm.h"
+#include "trpld.h"
+#include "trpbatch.h"
+#include "packet.h"
+#include "servio.h"
+#include "nothing.h"
+
+
+#define READ_OFFSET     0x1000
+
+#define VERIFY( exp ) \
+    if( !(exp) ) {                                          \
+        printf( "%s: ***FAILURE*** at line %d of %s.\n",    \
+                ProgramName, __LINE__, __FILE__ );          \
+        NumErrors++;                                        \
+        exit( EXIT_FAILURE );                               \
+    }
+
+char                    PackBuff[0x400];
+
+static char             SendBuff[0x400];
+static trap_elen        SendLen;
+static char             ReplyBuff[0x400];
+static trap_elen        ReplyLen;
+static trap_elen        MaxPacket = sizeof( PackBuff );
+static unsigned         TrapCalls[REQ__LAST];
+
+char                    ProgramName[128];   /* executable filename */
+int                     NumErrors = 0;      /* number of errors */
+
+/*
+ * The remote link. The server gets the test packet first and then a
+ * REQ_DISCONNECT which ends the session.
+ */
+trap_retval GetPacket( void )
+{
+    trap_elen   len;
+
+    if( SendLen == 0 ) {
+        ((disconnect_req *)PackBuff)->req = REQ_DISCONNECT;
+        return( sizeof( disconnect_req ) );
+    }
+    memcpy( PackBuff, SendBuff, SendLen );
+    len = SendLen;
+    SendLen = 0;
+    return( len );
+}
+
+void *GetPacketBuffPtr( void )
+{
+    return( PackBuff );
+}
+
+trap_retval PutBuffPacket( void *buff, trap_elen len )
+{
+    memcpy( ReplyBuff, buff, len );
+    ReplyLen = len;
+    return( len );
+}
+
+trap_elen MaxPacketSize( void )
+{
+    return( MaxPacket );
+}
+
+bool RemoteConnect( void )
+{
+    return( true );
+}
+
+void RemoteDisco( void )
+{
+}
+
+void ServError( const char *msg )
+{
+    printf( "%s: server error: %s\n", ProgramName, msg );
+    NumErrors++;
+    exit( EXIT_FAILURE );
+}
+
+void NothingToDo( void )
+{
+}
+
+/*
+ * The trap file. It knows no supplementary services and answers
+ * REQ_READ_MEM with bytes derived from the address.
+ */
+unsigned TrapAccess( trap_elen num_in_mx, in_mx_entry_p mx_in, trap_elen num_out_mx, mx_entry_p mx_out )
+{
+    read_mem_req                    *acc;
+    get_supplementary_service_ret   *ret;
+    unsigned char                   *data;
+    unsigned                        len;
+    unsigned                        i;
+
+    /* unused parameters */ (void)num_in_mx;
+
+    acc = (read_mem_req *)mx_in[0].ptr;
+    if( acc->req < REQ__LAST )
+        TrapCalls[acc->req]++;
+    if( num_out_mx == 0 )
+        return( 0 );
+    switch( acc->req ) {
+    case REQ_READ_MEM:
+        len = acc->len;
+        if( len > mx_out[0].len )
+            len = mx_out[0].len;
+        data = mx_out[0].ptr;
+        for( i = 0; i < len; i++ ) {
+            data[i] = (unsigned char)( acc->mem_addr.offset + i );
+        }
+        return( len );
+    case REQ_GET_SUPPLEMENTARY_SERVICE:
+        ret = mx_out[0].ptr;
+        ret->err = 0;
+        ret->id = 0;
+        return( sizeof( *ret ) );
+    }
+    return( 0 );
+}
+
+/* Send one packet to the server and return the size of its reply */
+static trap_elen Exchange( void )
+{
+    memset( TrapCalls, 0, sizeof( TrapCalls ) );
+    ReplyLen = 0;
+    VERIFY( Session() );
+    VERIFY( TrapCalls[REQ_DISCONNECT] == 1 );
+    return( ReplyLen );
+}
+
+static trap_shandle GetSuppId( const char *name )
+{
+    get_supplementary_service_req   *acc;
+    get_supplementary_service_ret   *ret;
+
+    acc = (get_supplementary_service_req *)SendBuff;
+    acc->req = REQ_GET_SUPPLEMENTARY_SERVICE;
+    strcpy( (char *)( acc + 1 ), name );
+    SendLen = sizeof( *acc ) + strlen( name ) + 1;
+    if( Exchange() != sizeof( *ret ) )
+        return( 0 );
+    ret = (get_supplementary_service_ret *)ReplyBuff;
+    if( ret->err != 0 )
+        return( 0 );
+    return( ret->id );
+}
+
+static void BatchStart( void )
+{
+    batch_access_req    *acc;
+
+    acc = (batch_access_req *)SendBuff;
+    acc->supp.core_req = REQ_PERFORM_SUPPLEMENTARY_SERVICE;
+    acc->supp.id = BATCH_SUPP_ID;
+    acc->req = REQ_BATCH_ACCESS;
+    acc->count = 0;
+    SendLen = sizeof( *acc );
+}
+
+static void *BatchAdd( trap_elen in_len, trap_elen out_len )
+{
+    batch_access_req    *acc;
+    batch_access_entry  entry;
+    void                *ptr;
+
+    acc = (batch_access_req *)SendBuff;
+    acc->count++;
+    entry.in_len = in_len;
+    entry.out_len = out_len;
+    memcpy( SendBuff + SendLen, &entry, sizeof( entry ) );
+    ptr = SendBuff + SendLen + sizeof( entry );
+    memset( ptr, 0, in_len );
+    SendLen += sizeof( entry ) + in_len;
+    return( ptr );
+}
+
+static void BatchReadMem( addr_off offset, unsigned_16 len )
+{
+    read_mem_req        *acc;
+
+    acc = BatchAdd( sizeof( *acc ), len );
+    acc->req = REQ_READ_MEM;
+    acc->mem_addr.offset = offset;
+    acc->mem_addr.segment = 0;
+    acc->len = len;
+}
+
+/* Check the replies of the first 'count' REQ_READ_MEM of a batch */
+static unsigned BatchResults( trap_elen len, unsigned count, unsigned_16 size )
+{
+    batch_access_ret    *ret;
+    batch_access_result result;
+    unsigned char       *data;
+    trap_elen           pos;
+    unsigned            i;
+    unsigned            j;
+
+    if( len < sizeof( *ret ) )
+        return( 0 );
+    ret = (batch_access_ret *)ReplyBuff;
+    pos = sizeof( *ret );
+    for( i = 0; i < ret->count && i < count; i++ ) {
+        memcpy( &result, ReplyBuff + pos, sizeof( result ) );
+        pos += sizeof( result );
+        if( result.len != size || pos + size > len )
+            return( 0 );
+        data = (unsigned char *)ReplyBuff + pos;
+        for( j = 0; j < size; j++ ) {
+            if( data[j] != (unsigned char)( READ_OFFSET + i * size + j ) ) {
+                return( 0 );
+            }
+        }
+        pos += size;
+    }
+    VERIFY( pos == len );
+    return( ret->count );
+}
+
+static void TestSupp( void )
+{
+    VERIFY( GetSuppId( QUOTED( BATCH_SUPP_NAME ) ) == BATCH_SUPP_ID );
+    VERIFY( TrapCalls[REQ_GET_SUPPLEMENTARY_SERVICE] == 0 );
+    VERIFY( GetSuppId( "Other" ) == 0 );
+    VERIFY( TrapCalls[REQ_GET_SUPPLEMENTARY_SERVICE] == 1 );
+}
+
+static void TestBatch( void )
+{
+    unsigned    i;
+
+    BatchStart();
+    for( i = 0; i < 20; i++ ) {
+        BatchReadMem( READ_OFFSET + i * 8, 8 );
+    }
+    VERIFY( BatchResults( Exchange(), 20, 8 ) == 20 );
+    VERIFY( TrapCalls[REQ_READ_MEM] == 20 );
+}
+
+static void TestNoReply( void )
+{
+    batch_access_result result;
+
+    BatchStart();
+    ((read_mem_req *)BatchAdd( sizeof( read_mem_req ), 0 ))->req = REQ_READ_MEM;
+    VERIFY( Exchange() == sizeof( batch_access_ret ) + sizeof( result ) );
+    memcpy( &result, ReplyBuff + sizeof( batch_access_ret ), sizeof( result ) );
+    VERIFY( ((batch_access_ret *)ReplyBuff)->count == 1 && result.len == 0 );
+    VERIFY( TrapCalls[REQ_READ_MEM] == 1 );
+}
+
+static void TestFull( void )
+{
+    unsigned    expect;
+    unsigned    i;
+
+    /* the replies of 8 requests don't fit into one packet */
+    expect = ( MaxPacket - sizeof( batch_access_ret ) ) / ( sizeof( batch_access_result ) + 200 );
+    BatchStart();
+    for( i = 0; i < 8; i++ ) {
+        BatchReadMem( READ_OFFSET + i * 200, 200 );
+    }
+    VERIFY( BatchResults( Exchange(), 8, 200 ) == expect );
+    VERIFY( TrapCalls[REQ_READ_MEM] == expect );
+
+    /* a smaller link packet stops it earlier */
+    MaxPacket = 0x100;
+    BatchStart();
+    for( i = 0; i < 8; i++ ) {
+        BatchReadMem( READ_OFFSET + i * 100, 100 );
+    }
+    VERIFY( BatchResults( Exchange(), 8, 100 ) == 2 );
+    MaxPacket = sizeof( PackBuff );
+}
+
+static void TestRefused( trap_req req, trap_elen size )
+{
+    trap_req    *acc;
+
+    BatchStart();
+    BatchReadMem( READ_OFFSET, 4 );
+    BatchReadMem( READ_OFFSET + 4, 4 );
+    acc = BatchAdd( size, 16 );
+    *acc = req;
+    BatchReadMem( READ_OFFSET + 8, 4 );
+    VERIFY( BatchResults( Exchange(), 4, 4 ) == 2 );    /* stops at 'req' */
+    VERIFY( TrapCalls[req] == 0 && TrapCalls[REQ_READ_MEM] == 2 );
+}
+
+static void TestNested( void )
+{
+    batch_access_req    *acc;
+
+    BatchStart();
+    BatchReadMem( READ_OFFSET, 4 );
+    acc = BatchAdd( sizeof( *acc ), 16 );
+    acc->supp.core_req = REQ_PERFORM_SUPPLEMENTARY_SERVICE;
+    acc->supp.id = BATCH_SUPP_ID;
+    acc->req = REQ_BATCH_ACCESS;
+    VERIFY( BatchResults( Exchange(), 2, 4 ) == 1 );
+}
+
+int main( int argc, char *argv[] )
+{
+    /* unused parameters */ (void)argc;
+
+    strcpy( ProgramName, argv[0] );             /* store filename */
+
+    TestSupp();
+    TestBatch();
+    TestNoReply();
+    TestFull();
+    TestRefused( REQ_CONNECT, sizeof( connect_req ) );
+    TestRefused( REQ_RESUME, sizeof( resume_req ) );
+    TestRefused( REQ_PROG_LOAD, sizeof( prog_load_req ) + 8 );
+    TestRefused( REQ_PROG_KILL, sizeof( prog_kill_req ) );
+    TestRefused( REQ_PROG_GO, sizeof( prog_go_req ) );
+    TestRefused( REQ_PROG_STEP, sizeof( prog_step_req ) );
+    TestRefused( REQ_WRITE_MEM, sizeof( write_mem_req ) + 4 );
+    TestRefused( REQ_WRITE_REGS, sizeof( write_regs_req ) + 16 );
+    TestRefused( REQ_SET_BREAK, sizeof( set_break_req ) );
+    TestRefused( REQ_GET_SUPPLEMENTARY_SERVICE, sizeof( get_supplementary_service_req ) + 6 );
+    TestNested();
+    if( NumErrors != 0 ) {
+        printf( "%s: FAILURE (%d errors).\n", ProgramName, NumErrors );
+        return( EXIT_FAILURE );
+    }
+    printf( "Tests completed (%s).\n", ProgramName );
+    return( EXIT_SUCCESS );
+}
@@ -718,6 +718,25 @@ int IdeDrvExecDLLArgv           // EXECUTE THE DLL ONE TIME (LOAD IF REQ'D)
 #endif
 
 
+int IdeDrvLoadDLL               // LOAD AND INITIALIZE THE DLL (IF REQ'D)
+    ( IDEDRV *inf )             // - driver control information
+/************************************
+ * Load without running, so that later runs (or forked copies of this
+ * process) start with an initialized DLL
+ */
+{
+    int runcode;
+    int retcode;
+
+#ifndef STATIC_LINKAGE
+    Inf = inf;
+#endif
+    retcode = ensureLoaded( inf, &runcode );
+    stashCodes( inf, runcode, retcode );
+    return( retcode );
+}
+
+
 int IdeDrvUnloadDLL             // UNLOAD THE DLL
     ( IDEDRV *inf )             // - driver control information
 #ifdef STATIC_LINKAGE
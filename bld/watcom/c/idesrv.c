@@ -0,0 +1,629 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Compile server for IDE driver based tools (Unix only).
+*
+****************************************************************************/
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#ifdef __WATCOMC__
+    #include <process.h>
+#endif
+#include "wio.h"
+#include "bool.h"
+#include "idedll.h"
+#include "idedrv.h"
+#include "idesrv.h"
+
+#include "clibext.h"
+
+
+/*
+ * Protocol
+ *
+ * The client sends a request header followed by a block of null terminated
+ * strings: the stamp of the executable, the current directory, argc
+ * arguments and envc environment strings.
+ *
+ * The server answers with frames, each a frame header followed by 'len'
+ * bytes of output for standard output (FRAME_STDOUT) or standard error
+ * (FRAME_STDERR), in the order the tool wrote them. The last frame is
+ * FRAME_EXIT with the exit status in 'len' and no data. A connection closed
+ * without any frame means that the request was refused (for instance
+ * because the server runs a different executable) and the client must run
+ * the tool itself.
+ */
+
+#define REQUEST_MAGIC   0x3153574fU     /* "OWS1" */
+#define MAX_REQUEST     0x100000U       /* largest block of strings */
+
+#define MAX_WORKERS     64              /* most workers, one per CPU */
+#define MAX_RUNS        256             /* runs before a worker is replaced */
+
+#define FRAME_EXIT      0
+#define FRAME_STDOUT    1
+#define FRAME_STDERR    2
+
+typedef struct {
+    unsigned    magic;
+    unsigned    size;                   // size of block of strings
+    unsigned    argc;
+    unsigned    envc;
+    unsigned    umask;
+} request_hdr;
+
+typedef struct {
+    unsigned    kind;
+    unsigned    len;
+} frame_hdr;
+
+#if !defined( __WATCOMC__ )
+extern char     **environ;
+#endif
+
+static int              listenSock = -1;    // socket the workers accept on
+static int              srvOut = -1;        // standard output of the server
+static int              srvErr = -1;        // standard error of the server
+static char             tmpName[_MAX_PATH]; // template for output files
+static int              runConn = -1;       // connection of the current run
+static int              runOutput[2];       // - reads what it wrote so far
+static bool             runOk;              // - connection still works
+static IDECallBacks     toolCallbacks;      // call-backs of the driver
+static IDECallBacks     srvCallbacks;       // - wrapped by the server
+static volatile bool    stopServer;
+
+
+static bool readFull( int fd, void *buf, size_t len )
+{
+    char    *p;
+    ssize_t n;
+
+    for( p = buf; len > 0; p += n, len -= n ) {
+        n = read( fd, p, len );
+        if( n == -1 && errno == EINTR ) {
+            n = 0;
+        } else if( n <= 0 ) {
+            return( false );
+        }
+    }
+    return( true );
+}
+
+static bool writeFull( int fd, const void *buf, size_t len )
+{
+    const char  *p;
+    ssize_t     n;
+
+    for( p = buf; len > 0; p += n, len -= n ) {
+        n = write( fd, p, len );
+        if( n == -1 && errno == EINTR ) {
+            n = 0;
+        } else if( n <= 0 ) {
+            return( false );
+        }
+    }
+    return( true );
+}
+
+static void exeStamp( char *buf )
+/********************************
+ * Identify the executable, so that a client never talks to a server which
+ * runs an older (or newer) build of the same tool
+ */
+{
+    struct stat st;
+    char        name[_MAX_PATH];
+
+    buf[0] = '\0';
+    if( _cmdname( name ) != NULL && stat( name, &st ) == 0 ) {
+        sprintf( buf, "%lx.%lx.%lx.%lx", (unsigned long)st.st_dev, (unsigned long)st.st_ino,
+                 (unsigned long)st.st_size, (unsigned long)st.st_mtime );
+    }
+}
+
+static bool makeAddress( struct sockaddr_un *addr, char const *dir, char const *dll_name )
+{
+    size_t  len;
+
+    len = strlen( dir ) + 1 + strlen( dll_name ) + sizeof( ".sock" );
+    if( len > sizeof( addr->sun_path ) )
+        return( false );
+    memset( addr, 0, sizeof( *addr ) );
+    addr->sun_family = AF_UNIX;
+    sprintf( addr->sun_path, "%s/%s.sock", dir, dll_name );
+    return( true );
+}
+
+static void sendOutput( void )
+/****************************
+ * Send what the tool wrote since the last call, standard output first
+ */
+{
+    frame_hdr   hdr;
+    char        buf[4096];
+    ssize_t     n;
+    int         i;
+
+    fflush( stdout );
+    fflush( stderr );
+    for( i = 0; i < 2; i++ ) {
+        while( (n = read( runOutput[i], buf, sizeof( buf ) )) > 0 ) {
+            if( runOk ) {
+                hdr.kind = ( i == 0 ) ? FRAME_STDOUT : FRAME_STDERR;
+                hdr.len = (unsigned)n;
+                runOk = writeFull( runConn, &hdr, sizeof( hdr ) ) && writeFull( runConn, buf, n );
+            }
+        }
+    }
+}
+
+/*
+ * The messages of the tool go through the driver's call-backs. The output
+ * written before each message is sent ahead of it and the message itself
+ * right after it, so that standard output and standard error keep their
+ * order.
+ */
+
+static IDEBool IDEAPI srvPrintMessage( IDECBHdl hdl, char const *message )
+{
+    IDEBool ret;
+
+    if( runConn != -1 )
+        sendOutput();
+    ret = toolCallbacks.PrintMessage( hdl, message );
+    if( runConn != -1 )
+        sendOutput();
+    return( ret );
+}
+
+static IDEBool IDEAPI srvPrintWithCrLf( IDECBHdl hdl, char const *message )
+{
+    IDEBool ret;
+
+    if( runConn != -1 )
+        sendOutput();
+    ret = toolCallbacks.PrintWithCRLF( hdl, message );
+    if( runConn != -1 )
+        sendOutput();
+    return( ret );
+}
+
+static IDEBool IDEAPI srvPrintWithInfo( IDECBHdl hdl, IDEMsgInfo *inf )
+{
+    IDEBool ret;
+
+    if( runConn != -1 )
+        sendOutput();
+    ret = toolCallbacks.PrintWithInfo( hdl, inf );
+    if( runConn != -1 )
+        sendOutput();
+    return( ret );
+}
+
+static bool openOutput( int *wfd, int *rfd )
+/*******************************************
+ * Open a file for the tool to write and a second, independent, descriptor
+ * to read back what it wrote
+ */
+{
+    char    name[_MAX_PATH];
+
+    strcpy( name, tmpName );
+    *wfd = mkstemp( name );
+    if( *wfd == -1 )
+        return( false );
+    *rfd = open( name, O_RDONLY );
+    unlink( name );
+    if( *rfd == -1 ) {
+        close( *wfd );
+        return( false );
+    }
+    return( true );
+}
+
+static bool serveRequest( IDEDRV *inf, int conn, IDESRV_RUN run, char const *stamp )
+/***********************************************************************************
+ * Run one request in this worker; the tool keeps what it initialized in
+ * earlier runs. Returns true when the tool was run
+ */
+{
+    request_hdr req;
+    frame_hdr   hdr;
+    char        *block;
+    char        *p;
+    char        **argv;
+    char        **envp;
+    char        **old_environ;
+    unsigned    old_umask;
+    unsigned    i;
+    int         out;
+    int         err;
+    bool        ran;
+
+    if( !readFull( conn, &req, sizeof( req ) ) )
+        return( false );
+    if( req.magic != REQUEST_MAGIC || req.size > MAX_REQUEST || req.size == 0 )
+        return( false );
+    block = malloc( req.size );
+    argv = malloc( ( req.argc + 1 ) * sizeof( char * ) );
+    envp = malloc( ( req.envc + 1 ) * sizeof( char * ) );
+    ran = false;
+    if( block == NULL || argv == NULL || envp == NULL || !readFull( conn, block, req.size ) )
+        goto done;
+    block[req.size - 1] = '\0';
+    /*
+     * stamp, current directory, arguments and environment
+     */
+    p = block;
+    if( strcmp( p, stamp ) != 0 )
+        goto done;
+    p += strlen( p ) + 1;
+    if( p >= block + req.size || chdir( p ) != 0 )
+        goto done;
+    for( i = 0; i < req.argc; i++ ) {
+        p += strlen( p ) + 1;
+        if( p >= block + req.size )
+            goto done;
+        argv[i] = p;
+    }
+    argv[i] = NULL;
+    for( i = 0; i < req.envc; i++ ) {
+        p += strlen( p ) + 1;
+        if( p >= block + req.size )
+            goto done;
+        envp[i] = p;
+    }
+    envp[i] = NULL;
+    if( !openOutput( &out, &runOutput[0] ) )
+        goto done;
+    if( !openOutput( &err, &runOutput[1] ) ) {
+        close( out );
+        close( runOutput[0] );
+        goto done;
+    }
+    fflush( NULL );
+    dup2( out, STDOUT_FILENO );
+    dup2( err, STDERR_FILENO );
+    close( out );
+    close( err );
+    old_environ = environ;
+    environ = envp;
+    old_umask = umask( req.umask );
+    runConn = conn;
+    runOk = true;
+    hdr.len = run( inf, (int)req.argc, argv );
+    sendOutput();
+    runConn = -1;
+    umask( old_umask );
+    environ = old_environ;
+    dup2( srvOut, STDOUT_FILENO );
+    dup2( srvErr, STDERR_FILENO );
+    close( runOutput[0] );
+    close( runOutput[1] );
+    if( runOk ) {
+        hdr.kind = FRAME_EXIT;
+        writeFull( conn, &hdr, sizeof( hdr ) );
+    }
+    ran = true;
+done:
+    free( envp );
+    free( argv );
+    free( block );
+    return( ran );
+}
+
+static void runWorker( IDEDRV *inf, IDESRV_RUN run, char const *stamp )
+/**********************************************************************
+ * Serve requests one after the other, then make room for a fresh worker;
+ * this is a forked copy of the server
+ */
+{
+    unsigned    runs;
+    int         conn;
+    int         nul;
+
+    signal( SIGTERM, SIG_DFL );
+    signal( SIGINT, SIG_DFL );
+    nul = open( "/dev/null", O_RDONLY );
+    if( nul != -1 ) {
+        dup2( nul, STDIN_FILENO );
+        close( nul );
+    }
+    srvOut = dup( STDOUT_FILENO );
+    srvErr = dup( STDERR_FILENO );
+    for( runs = 0; runs < MAX_RUNS; ) {
+        conn = accept( listenSock, NULL, NULL );
+        if( conn == -1 ) {
+            if( errno == EINTR || errno == ECONNABORTED )
+                continue;
+            _exit( EXIT_FAILURE );
+        }
+        if( serveRequest( inf, conn, run, stamp ) )
+            runs++;
+        close( conn );
+    }
+    _exit( EXIT_SUCCESS );
+}
+
+static pid_t startWorker( IDEDRV *inf, IDESRV_RUN run, char const *stamp )
+{
+    pid_t   pid;
+
+    fflush( NULL );
+    pid = fork();
+    if( pid == 0 ) {
+        runWorker( inf, run, stamp );
+    }
+    return( pid );
+}
+
+static void stopHandler( int sig_num )
+{
+    /* unused parameters */ (void)sig_num;
+
+    stopServer = true;
+}
+
+int IdeSrvServe                 // RUN AS A SERVER (UNTIL STOPPED OR ON ERROR)
+    ( IDEDRV *inf               // - driver control information
+    , char const *dir           // - socket directory or NULL
+    , IDESRV_RUN run )          // - tool runner
+{
+    struct sockaddr_un  addr;
+    char                stamp[80];
+    struct sigaction    sa;
+    pid_t               workers[MAX_WORKERS];
+    pid_t               pid;
+    long                count;
+    int                 status;
+    int                 i;
+    mode_t              old_umask;
+    bool                ok;
+
+    if( dir == NULL || *dir == '\0' ) {
+        dir = getenv( IDESRV_ENV );
+        if( dir == NULL || *dir == '\0' ) {
+            fprintf( stderr, "%s: no socket directory, use %s=<dir> or set %s\n",
+                     inf->dll_name, IDESRV_OPTION, IDESRV_ENV );
+            return( EXIT_FAILURE );
+        }
+    }
+    if( !makeAddress( &addr, dir, inf->dll_name ) ) {
+        fprintf( stderr, "%s: socket directory name too long\n", inf->dll_name );
+        return( EXIT_FAILURE );
+    }
+    sprintf( tmpName, "%s/%s.XXXXXX", dir, inf->dll_name );
+    /*
+     * the DLL keeps the call-backs it was initialized with
+     */
+    toolCallbacks = *(IDECallBacks *)IdeDrvGetCallbacks();
+    srvCallbacks = toolCallbacks;
+    srvCallbacks.PrintMessage = srvPrintMessage;
+    srvCallbacks.PrintWithCRLF = srvPrintWithCrLf;
+    srvCallbacks.PrintWithInfo = srvPrintWithInfo;
+    IdeDrvSetCallbacks( &srvCallbacks );
+    if( IdeDrvLoadDLL( inf ) != IDEDRV_SUCCESS ) {
+        IdeDrvPrintError( inf );
+        return( EXIT_FAILURE );
+    }
+    exeStamp( stamp );
+    listenSock = socket( AF_UNIX, SOCK_STREAM, 0 );
+    if( listenSock == -1 ) {
+        perror( inf->dll_name );
+        return( EXIT_FAILURE );
+    }
+    unlink( addr.sun_path );
+    /*
+     * the socket is created accessible to its owner only
+     */
+    old_umask = umask( S_IRWXG | S_IRWXO );
+    ok = ( bind( listenSock, (struct sockaddr *)&addr, sizeof( addr ) ) == 0 );
+    umask( old_umask );
+    if( !ok || listen( listenSock, SOMAXCONN ) != 0 ) {
+        perror( addr.sun_path );
+        close( listenSock );
+        return( EXIT_FAILURE );
+    }
+    /*
+     * each worker keeps the tool initialized between the requests it runs
+     */
+    count = sysconf( _SC_NPROCESSORS_ONLN );
+    if( count < 1 )
+        count = 1;
+    if( count > MAX_WORKERS )
+        count = MAX_WORKERS;
+    signal( SIGPIPE, SIG_IGN );
+    /*
+     * no SA_RESTART, the signals must interrupt wait()
+     */
+    memset( &sa, 0, sizeof( sa ) );
+    sa.sa_handler = stopHandler;
+    sigemptyset( &sa.sa_mask );
+    sigaction( SIGTERM, &sa, NULL );
+    sigaction( SIGINT, &sa, NULL );
+    for( i = 0; i < count; i++ ) {
+        workers[i] = startWorker( inf, run, stamp );
+    }
+    status = EXIT_SUCCESS;
+    while( !stopServer ) {
+        pid = wait( &status );
+        if( pid == -1 ) {
+            if( errno == EINTR )
+                continue;
+            break;
+        }
+        for( i = 0; i < count; i++ ) {
+            if( workers[i] == pid ) {
+                break;
+            }
+        }
+        if( i == count )
+            continue;
+        workers[i] = -1;
+        if( WIFEXITED( status ) && WEXITSTATUS( status ) != EXIT_SUCCESS ) {
+            /*
+             * the socket is broken
+             */
+            fprintf( stderr, "%s: %s: cannot accept requests\n", inf->dll_name, addr.sun_path );
+            break;
+        }
+        /*
+         * the worker retired, or died in the middle of a run
+         */
+        workers[i] = startWorker( inf, run, stamp );
+    }
+    for( i = 0; i < count; i++ ) {
+        if( workers[i] > 0 ) {
+            kill( workers[i], SIGTERM );
+        }
+    }
+    while( wait( NULL ) > 0 || errno == EINTR )
+        ;
+    close( listenSock );
+    unlink( addr.sun_path );
+    return( stopServer ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+
+int IdeSrvClient                // PASS A RUN TO A SERVER, IF ONE IS RUNNING
+    ( char const *dll_name      // - dll name
+    , int argc                  // - # of arguments
+    , char **argv               // - argument vector
+    , int *status )             // - exit status of the run
+/************************************
+ * Returns true when the server did the run
+ */
+{
+    struct sockaddr_un  addr;
+    request_hdr         req;
+    frame_hdr           hdr;
+    char                stamp[80];
+    char                cwd[_MAX_PATH];
+    char                buf[4096];
+    char                *block;
+    char                *p;
+    char                **env;
+    char const          *dir;
+    size_t              size;
+    size_t              len;
+    int                 conn;
+    int                 i;
+    bool                answered;
+    bool                done;
+
+    dir = getenv( IDESRV_ENV );
+    if( dir == NULL || *dir == '\0' )
+        return( false );
+    if( !makeAddress( &addr, dir, dll_name ) )
+        return( false );
+    if( getcwd( cwd, sizeof( cwd ) ) == NULL )
+        return( false );
+    exeStamp( stamp );
+    /*
+     * build the request
+     */
+    req.magic = REQUEST_MAGIC;
+    req.argc = argc;
+    req.envc = 0;
+    req.umask = umask( 0 );
+    umask( req.umask );
+    size = strlen( stamp ) + 1 + strlen( cwd ) + 1;
+    for( i = 0; i < argc; i++ ) {
+        size += strlen( argv[i] ) + 1;
+    }
+    for( env = environ; *env != NULL; env++ ) {
+        size += strlen( *env ) + 1;
+        req.envc++;
+    }
+    if( size > MAX_REQUEST )
+        return( false );
+    req.size = (unsigned)size;
+    block = malloc( size );
+    if( block == NULL )
+        return( false );
+    p = block;
+    len = strlen( stamp ) + 1;
+    p = (char *)memcpy( p, stamp, len ) + len;
+    len = strlen( cwd ) + 1;
+    p = (char *)memcpy( p, cwd, len ) + len;
+    for( i = 0; i < argc; i++ ) {
+        len = strlen( argv[i] ) + 1;
+        p = (char *)memcpy( p, argv[i], len ) + len;
+    }
+    for( env = environ; *env != NULL; env++ ) {
+        len = strlen( *env ) + 1;
+        p = (char *)memcpy( p, *env, len ) + len;
+    }
+    /*
+     * send it and copy the output
+     */
+    answered = false;
+    done = false;
+    conn = socket( AF_UNIX, SOCK_STREAM, 0 );
+    if( conn != -1 ) {
+        if( connect( conn, (struct sockaddr *)&addr, sizeof( addr ) ) == 0
+          && writeFull( conn, &req, sizeof( req ) )
+          && writeFull( conn, block, size ) ) {
+            while( !done && readFull( conn, &hdr, sizeof( hdr ) ) ) {
+                answered = true;
+                if( hdr.kind == FRAME_EXIT ) {
+                    *status = (int)hdr.len;
+                    done = true;
+                    break;
+                }
+                for( ; hdr.len > 0; hdr.len -= len ) {
+                    len = hdr.len;
+                    if( len > sizeof( buf ) )
+                        len = sizeof( buf );
+                    if( !readFull( conn, buf, len ) )
+                        break;
+                    writeFull( ( hdr.kind == FRAME_STDERR ) ? STDERR_FILENO : STDOUT_FILENO, buf, len );
+                }
+                if( hdr.len > 0 ) {
+                    break;
+                }
+            }
+        }
+        close( conn );
+    }
+    free( block );
+    if( answered && !done ) {
+        /*
+         * the server went away in the middle of the run
+         */
+        *status = EXIT_FAILURE;
+    }
+    return( answered );
+}
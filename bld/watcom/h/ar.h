@@ -71,6 +71,33 @@ typedef struct ar_header ar_header;
 #define AR_LONG_NAME_END_STRING     "/\n"
 #define AR_LONG_NAME_END_STRING_LEN 2
 
+/*
+ * Optional hashed symbol index written by wlib after the dictionaries
+ * and the long name table. All values are little endian unsigned_32:
+ *
+ *  signature ("OWH1"), number of buckets (power of 2)
+ *  buckets * { hash, offset of name in string area, file offset of member }
+ *  zero terminated symbol names
+ *
+ * A bucket with a zero member offset is empty, collisions are resolved
+ * by linear probing. The hash is FNV-1a on the names with every character
+ * ORed with 0x20 first. That folds ASCII letters to lower case, so that one
+ * index serves both case sensitive and case insensitive lookups. It also
+ * folds some other characters together (e.g. '@' and '`'), which only costs
+ * an extra name compare.
+ */
+#define AR_HASH_NAME            "/<OWHASH>/"
+#define AR_HASH_NAME_LEN        10
+
+#define AR_HASH_SIGNATURE       "OWH1"
+#define AR_HASH_SIGNATURE_LEN   4
+
+#define AR_HASH_HEADER_SIZE     (AR_HASH_SIGNATURE_LEN + 4)
+#define AR_HASH_BUCKET_SIZE     (3 * 4)
+
+#define AR_HASH_INIT            0x811c9dc5UL
+#define AR_HASH_STEP( h, c )    (((h) ^ ((unsigned char)(c) | 0x20)) * 0x01000193UL)
+
 #if defined( __UNIX__ ) || defined( __WATCOMC__ )
 
 #include <sys/stat.h>
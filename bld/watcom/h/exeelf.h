@@ -319,6 +319,7 @@ typedef struct {
 #define SHT_REL         9               // as RELA but no explicit addends
 #define SHT_SHLIB       10              // reserved but evil
 #define SHT_DYNSYM      11              // dynamic link symbol table
+#define SHT_GROUP       17              // section group
 #define SHT_OS          0x60000001      // info to identify target OS
 #define SHT_IMPORTS     0x60000002      // info on refs to external symbols
 #define SHT_EXPORTS     0x60000003      // info on symbols exported by ordinal
@@ -344,6 +345,7 @@ typedef struct {
 #define SHF_WRITE       0x00000001      // section writable during execution
 #define SHF_ALLOC       0x00000002      // section occupies space during exec.
 #define SHF_EXECINSTR   0x00000004      // section contains code.
+#define SHF_GROUP       0x00000200      // section is a member of a group
 #define SHF_BEGIN       0x01000000      // section to be placed at the beginning
                                         // of like-named sections by static link
 #define SHF_END         0x02000000      // same, end.
@@ -352,6 +354,10 @@ typedef struct {
 #define SHF_X86_64_LARGE 0x1000000      // section with more than 2GB
 #define SHF_ALPHA_GPREL 0x10000000
 
+// section group flags (first word of SHT_GROUP section)
+
+#define GRP_COMDAT      0x00000001      // keep only one copy of the group
+
 // symbol table entry
 
 typedef struct {
@@ -38,6 +38,7 @@
 #define IdeDrvExecDLLArgv       _IdeDrvExecDLLArgv
 #define IdeDrvInit              _IdeDrvInit
 #define IdeDrvPrintError        _IdeDrvPrintError
+#define IdeDrvLoadDLL           _IdeDrvLoadDLL
 #define IdeDrvUnloadDLL         _IdeDrvUnloadDLL
 #define IdeDrvStopRunning       _IdeDrvStopRunning
 #define IdeDrvChainCallbacks    _IdeDrvChainCallbacks
@@ -100,6 +101,9 @@ void IdeDrvInit                 // INITIALIZE IDEDRV INFORMATION
 int IdeDrvPrintError            // UNLOAD THE DLL
     ( IDEDRV *inf )             // - driver control information
 ;
+int IdeDrvLoadDLL               // LOAD AND INITIALIZE THE DLL (IF REQ'D)
+    ( IDEDRV *inf )             // - driver control information
+;
 int IdeDrvUnloadDLL             // UNLOAD THE DLL
     ( IDEDRV *inf )             // - driver control information
 ;
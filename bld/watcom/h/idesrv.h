@@ -0,0 +1,67 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Compile server for IDE driver based tools (Unix only).
+*
+****************************************************************************/
+
+
+#ifndef __IDESRV_H__
+#define __IDESRV_H__
+
+// A tool started as "<tool> --server[=<dir>]" initializes its DLL once and
+// then serves requests on the Unix domain socket <dir>/<dll name>.sock. One
+// forked worker per CPU runs the requests, each one after the other in the
+// same DLL instance, the way the IDE reuses it. <dir> defaults to the value
+// of the OWSERVER environment variable. SIGTERM or SIGINT stops the server.
+//
+// A tool started normally while OWSERVER is set first tries to hand its
+// command line, current directory and environment to that server, and
+// only runs itself when no server answers.
+
+#define IDESRV_ENV          "OWSERVER"
+#define IDESRV_OPTION       "--server"
+
+typedef int (*IDESRV_RUN)       // RUN THE TOOL, RETURN EXIT STATUS
+    ( IDEDRV *inf               // - driver control information
+    , int argc                  // - # of arguments
+    , char **argv )             // - argument vector
+;
+
+// PROTOTYPES
+
+int IdeSrvServe                 // RUN AS A SERVER (UNTIL STOPPED OR ON ERROR)
+    ( IDEDRV *inf               // - driver control information
+    , char const *dir           // - socket directory or NULL
+    , IDESRV_RUN run )          // - tool runner
+;
+int IdeSrvClient                // PASS A RUN TO A SERVER, IF ONE IS RUNNING
+    ( char const *dll_name      // - dll name
+    , int argc                  // - # of arguments
+    , char **argv               // - argument vector
+    , int *status )             // - exit status of the run
+;
+#endif
@@ -35,10 +35,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
 #ifndef __UNIX__
 #include <direct.h>
+#include <process.h>
 #else
 #include <dirent.h>
+#include <sys/wait.h>
 #endif
 #include "wio.h"
 #include "diskos.h"
@@ -65,6 +68,22 @@ list    *Obj_List;                      /* linked list of object filenames    */
 char    *Obj_Name;                      /* object file name pattern           */
 char    *Exe_Name;                      /* name of executable                 */
 list    *Directive_List;                /* linked list of wlink directives    */
+unsigned MaxJobs = 1;                   /* -j number of parallel compiles     */
+
+typedef struct job {
+    struct job  *next;
+    FILE        *out;                   /* captured output of the compiler    */
+    char        *path;                  /* compiler path for messages         */
+    char        *fn;                    /* source file name for messages      */
+    int         pid;
+    int         rc;                     /* exit status, -1 if not run         */
+    int         done;
+} job;
+
+static job      *Jobs_Head;             /* jobs in command line order         */
+static job      **Jobs_Tail = &Jobs_Head;
+static unsigned Jobs_Running;
+static int      Jobs_Failed;
 
 static char *DebugOptions[] = {
     "",
@@ -526,3 +545,179 @@ void  MakeName( char *name, const char *ext )
         strcat( name, ext );
     }
 }
+
+
+/*
+ * Parallel compiles (-j option)
+ *
+ * A compile started by JobStart runs with its standard output and standard
+ * error redirected to a temporary file. The file is copied to our standard
+ * output when the compile ends, but not before the output of every compile
+ * started earlier, so that diagnostics appear in command line order just as
+ * they do for sequential compiles.
+ */
+
+static int startJob( job *j, const char *const *argv )
+/****************************************************/
+{
+    int     pid;
+    int     fd;
+#ifndef __UNIX__
+    int     save_out;
+    int     save_err;
+#endif
+
+    fd = fileno( j->out );
+    fflush( NULL );
+#ifdef __UNIX__
+    pid = fork();
+    if( pid == 0 ) {
+        dup2( fd, STDOUT_FILENO );
+        dup2( fd, STDERR_FILENO );
+        execvp( j->path, (char * const *)argv );
+        _exit( 127 );
+    }
+#else
+    save_out = dup( fileno( stdout ) );
+    save_err = dup( fileno( stderr ) );
+    dup2( fd, fileno( stdout ) );
+    dup2( fd, fileno( stderr ) );
+    pid = (int)spawnvp( P_NOWAIT, j->path, argv );
+    dup2( save_out, fileno( stdout ) );
+    dup2( save_err, fileno( stderr ) );
+    close( save_out );
+    close( save_err );
+#endif
+    return( pid );
+}
+
+static void waitJob( void )
+/*************************/
+{
+    job     *j;
+    int     pid;
+    int     status;
+
+#ifdef __UNIX__
+    while( (pid = waitpid( -1, &status, 0 )) == -1 ) {
+        if( errno != EINTR ) {
+            break;
+        }
+    }
+    for( j = Jobs_Head; j != NULL; j = j->next ) {
+        if( !j->done && ( pid == -1 || pid == j->pid ) ) {
+            break;
+        }
+    }
+    if( j == NULL )
+        return;
+    if( pid == -1 || !WIFEXITED( status ) || WEXITSTATUS( status ) == 127 ) {
+        j->rc = -1;
+    } else {
+        j->rc = WEXITSTATUS( status );
+    }
+#else
+    /* cwait can only wait for a given process, so take the oldest one */
+    for( j = Jobs_Head; j != NULL; j = j->next ) {
+        if( !j->done ) {
+            break;
+        }
+    }
+    if( j == NULL )
+        return;
+    pid = cwait( &status, j->pid, WAIT_CHILD );
+    if( pid == -1 ) {
+        j->rc = -1;
+    } else {
+        j->rc = ( status >> 8 ) & 0xff;
+    }
+#endif
+    j->done = 1;
+    Jobs_Running--;
+}
+
+static void flushJobs( void )
+/***************************/
+{
+    job     *j;
+    char    buf[512];
+    size_t  len;
+
+    while( (j = Jobs_Head) != NULL && j->done ) {
+        fflush( stdout );
+        rewind( j->out );
+        while( (len = fread( buf, 1, sizeof( buf ), j->out )) != 0 ) {
+            write( fileno( stdout ), buf, len );
+        }
+        fclose( j->out );
+        if( j->rc != 0 ) {
+            if( (j->rc == -1) || (j->rc == 255) ) {
+                PrintMsg( WclMsgs[UNABLE_TO_INVOKE_EXE], j->path );
+            } else {
+                PrintMsg( WclMsgs[COMPILER_RETURNED_A_BAD_STATUS], j->fn );
+            }
+            Jobs_Failed++;
+        }
+        Jobs_Head = j->next;
+        if( Jobs_Head == NULL )
+            Jobs_Tail = &Jobs_Head;
+        MemFree( j->path );
+        MemFree( j->fn );
+        MemFree( j );
+    }
+}
+
+void JobStart( const char *path, const char *const *argv, const char *fn )
+/************************************************************************/
+{
+    job     *j;
+    int     i;
+
+    while( Jobs_Running >= MaxJobs ) {
+        waitJob();
+        flushJobs();
+    }
+    j = MemAlloc( sizeof( job ) );
+    j->next = NULL;
+    j->path = MemStrDup( path );
+    j->fn = MemStrDup( fn );
+    j->rc = -1;
+    j->done = 1;
+    *Jobs_Tail = j;
+    Jobs_Tail = &j->next;
+    j->out = tmpfile();
+    if( j->out == NULL ) {
+        PrintMsg( WclMsgs[UNABLE_TO_OPEN_TEMPORARY_FILE], "", strerror( errno ) );
+        exit( 1 );
+    }
+    if( !Flags.be_quiet ) {
+        fputc( '\t', j->out );
+        for( i = 0; argv[i] != NULL; i++ ) {
+            if( i > 0 )
+                fputc( ' ', j->out );
+            fputs( argv[i], j->out );
+        }
+        fputc( '\n', j->out );
+    }
+    j->pid = startJob( j, argv );
+    if( j->pid != -1 ) {
+        j->done = 0;
+        Jobs_Running++;
+    }
+    flushJobs();
+}
+
+int JobsFinish( void )
+/********************/
+{
+    int     failed;
+
+    while( Jobs_Running > 0 ) {
+        waitJob();
+        flushJobs();
+    }
+    flushJobs();
+    failed = Jobs_Failed;
+    Jobs_Failed = 0;
+    return( failed );
+}
@@ -658,7 +658,7 @@ static  int  ParseArgs( int argc, char **argv )
                         "O::o:P::QSs::U:vW::wx:yz::",
 #else
                         "b:CcD:Ef:g::"
-                        "HI:i::L:l:M::m:"
+                        "HI:i::j:L:l:M::m:"
                         "O::o:P::QSs::U:vW::wx::yz::",
 #endif
                         UsageText )) != -1 ) {
@@ -837,6 +837,14 @@ static  int  ParseArgs( int argc, char **argv )
                 Flags.windows = true;
             }
             break;
+        case 'j':           /* -j <num> parallel compiles */
+            MaxJobs = atoi( Word );
+            if( MaxJobs < 1 )
+                MaxJobs = 1;
+            if( MaxJobs > MAX_JOBS )
+                MaxJobs = MAX_JOBS;
+            wcc_option = false;
+            break;
         case 'E':
             preprocess_only = true;
             wcc_option = false;
@@ -1238,6 +1246,12 @@ static int tool_exec( tool_type utl, const char *fn, const char **options )
     pass_argv[pass_argc++] = fn;
     pass_argv[pass_argc] = NULL;
 
+    if( MaxJobs > 1 && utl >= TYPE_ALLARCH_COUNT ) {
+        /* compiles may run in parallel, JobsFinish reports any errors */
+        JobStart( tool->path, pass_argv, fn );
+        return( 0 );
+    }
+
     if( !Flags.be_quiet ) {
         printf( "\t" );
         for( i = 0; i < pass_argc; i++ )
@@ -1422,6 +1436,9 @@ static  int  CompLink( void )
 
     Word = MemAlloc( MAX_CMD );
     errors_found = false;
+    if( Flags.do_disas ) {
+        MaxJobs = 1;    /* wdis needs each object as soon as it is compiled */
+    }
     for( itm = Files_List; itm != NULL; itm = itm->next ) {
         char    buffer[_MAX_PATH];
 
@@ -1481,6 +1498,10 @@ static  int  CompLink( void )
         }
         MemFree( path );
     }
+    /* link only when all parallel compiles have succeeded */
+    if( JobsFinish() != 0 ) {
+        errors_found = true;
+    }
     if( errors_found ) {
         rc = 1;
     } else {
@@ -723,6 +723,16 @@ static int Parse( const char *cmd )
                 case 'y':
                     wcc_option = 0;
                     break;
+                case 'j':           /* -j<num> parallel compiles, -j is signed char */
+                    if( isdigit( (unsigned char)Word[1] ) ) {
+                        MaxJobs = atoi( Word + 1 );
+                        if( MaxJobs < 1 )
+                            MaxJobs = 1;
+                        if( MaxJobs > MAX_JOBS )
+                            MaxJobs = MAX_JOBS;
+                        wcc_option = 0;
+                    }
+                    break;
 #if defined( WCLI86 ) || defined( WCL386 )
                 case 'm':           /* memory model */
                     /* if tiny model specified then change to small for compilers */
@@ -820,6 +830,17 @@ static int tool_exec( tool_type utl, const char *p1, const char *p2 )
     etool   *tool;
 
     tool = FindToolGetPath( utl );
+    if( MaxJobs > 1 && utl >= TYPE_ALLARCH_COUNT ) {
+        const char  *argv[4];
+
+        /* compiles may run in parallel, JobsFinish reports any errors */
+        argv[0] = tool->name;
+        argv[1] = p1;
+        argv[2] = p2;
+        argv[3] = NULL;
+        JobStart( tool->path, argv, p1 );
+        return( 0 );
+    }
     if( !Flags.be_quiet ) {
         if( p2 == NULL ) {
             PrintMsg( "\t%s %s\n", tool->name, p1 );
@@ -1013,6 +1034,10 @@ static  int  CompLink( void )
         }
         MemFree( path );
     }
+    /* link only when all parallel compiles have succeeded */
+    if( JobsFinish() != 0 ) {
+        errors_found = 1;
+    }
     if( tmp_env != NULL )
         killTmpEnv( tmp_env );
     if( errors_found ) {
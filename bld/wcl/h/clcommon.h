@@ -37,6 +37,13 @@
 #define MAX_CMD 500
 #endif
 
+/* Maximum for the -j option; DOS can only run one program at a time */
+#if defined(__OS2__) || defined(__NT__) || defined(__UNIX__)
+#define MAX_JOBS 64
+#else
+#define MAX_JOBS 1
+#endif
+
 #if defined(__UNIX__)
 #define fname_cmp   strcmp
 #else
@@ -141,6 +148,7 @@ extern list     *Directive_List;    /* linked list of wlink directives    */
 extern const char *WclMsgs[];
 
 extern flags    Flags;
+extern unsigned MaxJobs;            /* -j number of parallel compiles     */
 
 extern char     *StackSize;         /* size of stack                      */
 extern DBG_OPT  DebugFlag;          /* debug info wanted                  */
@@ -169,3 +177,5 @@ extern void     AddDirectivePath( const char *directive, const char *path );
 extern char     *RemoveExt( char * );
 extern int      HasFileExtension( const char *p, const char *ext );
 extern void     MakeName( char *name, const char *ext );
+extern void     JobStart( const char *path, const char *const *argv, const char *fn );
+extern int      JobsFinish( void );
@@ -121,6 +121,11 @@
 :usage. compile only, no link
 :target. any
 
+:option. j
+:usage. run up to <num> compiles in parallel
+:number.
+:target. any
+
 :option. o
 :usage. set output file name
 :argequal. ..
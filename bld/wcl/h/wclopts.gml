@@ -121,6 +121,10 @@
 :usage. treat source files as C++ code
 :target. any
 
+:option. j<num>
+:usage. run up to <num> compiles in parallel
+:target. any
+
 :option. y
 :usage. ignore the WCLAXP environment variable
 :target. axp
@@ -68,6 +68,9 @@ typedef struct {
     unsigned_16         *offsettab;
     char                **symbtab;
     unsigned_32         num_entries;
+    unsigned_8          *hashtab;       /* wlib hashed symbol index or NULL */
+    unsigned_32         hash_buckets;
+    unsigned long       hash_size;
 } ar_dict_entry;
 
 typedef union dict_entry {
@@ -293,46 +296,101 @@ static void ReadARStringTable( file_list *list, unsigned long *loc, unsigned siz
     }
 }
 
+static bool ReadARHashIndex( file_list *list, unsigned long loc, unsigned long size )
+/***********************************************************************************/
+/* map the hashed symbol index written by wlib, it makes the sorted dictionary
+ * unnecessary. The index has to end in a NUL, so that every name in it is
+ * terminated inside the index */
+{
+    ar_dict_entry   *dict;
+    unsigned_8      *data;
+    unsigned_32     buckets;
+
+    if( size < AR_HASH_HEADER_SIZE )
+        return( false );
+    data = CachePermRead( list, loc, size );
+    buckets = MGET_LE_32_UN( data + AR_HASH_SIGNATURE_LEN );
+    if( memcmp( data, AR_HASH_SIGNATURE, AR_HASH_SIGNATURE_LEN ) != 0
+      || buckets == 0 || ( buckets & ( buckets - 1 ) ) != 0
+      || buckets > ( size - AR_HASH_HEADER_SIZE ) / AR_HASH_BUCKET_SIZE
+      || data[size - 1] != '\0' ) {
+        CacheFree( list, data );
+        return( false );
+    }
+    dict = &list->u.dict->a;
+    dict->hashtab = data;
+    dict->hash_buckets = buckets;
+    dict->hash_size = size;
+    return( true );
+}
+
 static bool ReadARDict( file_list *list, unsigned long *loc, bool makedict )
 /**************************************************************************/
 {
     const ar_header *ar_hdr;
     unsigned long   size;
     int             numdicts;
+    int             i;
+    unsigned long   dictloc[2];
+    unsigned long   dictsize[2];
+    bool            hashed;
 
     numdicts = 0;
+    hashed = false;
     if( makedict ) {
         if( list->u.dict == NULL ) {
             _ChkAlloc( list->u.dict, sizeof( dict_entry ) );
+            list->u.dict->a.hashtab = NULL;
         }
     }
     for( ;; ) {
         ar_hdr = CacheRead( list, *loc, sizeof( ar_header ) );
         size = GetARValue( ar_hdr->size, AR_SIZE_LEN );
         if( ar_hdr->name[0] == '/' && ar_hdr->name[1] == ' ' ) {
-            ++numdicts;
             *loc += sizeof( ar_header );
-            if( makedict )
-                ReadARDictData( list, loc, size, numdicts );
+            if( numdicts < 2 ) {
+                dictloc[numdicts] = *loc;
+                dictsize[numdicts] = size;
+            }
+            ++numdicts;
             *loc += __ROUND_UP_SIZE_EVEN( size );
         } else if( ar_hdr->name[0] == '/' && ar_hdr->name[1] == '/' ) {
             *loc += sizeof( ar_header );
             ReadARStringTable( list, loc, size );
             *loc += __ROUND_UP_SIZE_EVEN( size );
+        } else if( memcmp( ar_hdr->name, AR_HASH_NAME, AR_HASH_NAME_LEN ) == 0 ) {
+            *loc += sizeof( ar_header );
+            if( makedict && !hashed ) {
+                hashed = ReadARHashIndex( list, *loc, size );
+            }
+            *loc += __ROUND_UP_SIZE_EVEN( size );
         } else {
             break;         // found an actual object file
         }
     }
     if( makedict ) {
-        if( numdicts == 0 ) {
+        if( numdicts == 0 && !hashed ) {
             Locator( list->infile->name.u.ptr, NULL, 0 );
             LnkMsg( ERR+MSG_NO_DICT_FOUND, NULL );
             _LnkFree( list->u.dict );
             list->u.dict = NULL;
             return( false );
         }
-        if( (LinkFlags & LF_CASE_FLAG) == 0 || numdicts == 1 ) {
-            SortARDict( &list->u.dict->a );
+        if( hashed ) {
+            /* the hashed index replaces the dictionaries */
+            list->u.dict->a.num_entries = 0;
+            list->u.dict->a.filepostab = NULL;
+            list->u.dict->a.offsettab = NULL;
+            list->u.dict->a.symbtab = NULL;
+        } else {
+            if( numdicts > 2 )
+                numdicts = 2;
+            for( i = 0; i < numdicts; i++ ) {
+                ReadARDictData( list, &dictloc[i], dictsize[i], i + 1 );
+            }
+            if( (LinkFlags & LF_CASE_FLAG) == 0 || numdicts == 1 ) {
+                SortARDict( &list->u.dict->a );
+            }
         }
     }
     return( true );
@@ -554,8 +612,12 @@ void BurnLibs( void )
         if( dict == NULL )
             continue;
         if( temp->flags & STAT_AR_LIB ) {
-            CacheFree( temp, dict->a.filepostab - 1 );
-            _LnkFree( dict->a.symbtab );
+            if( dict->a.hashtab != NULL ) {
+                CacheFree( temp, dict->a.hashtab );
+            } else {
+                CacheFree( temp, dict->a.filepostab - 1 );
+                _LnkFree( dict->a.symbtab );
+            }
         } else {
             if( dict->o.cache != NULL ) {
                 FreeDictCache( dict->o.cache, ( dict->o.pages / PAGES_IN_CACHE ) + 1 );
@@ -585,6 +647,52 @@ static int ARCompIName( const void *key, const void *vbase )
     return( stricmp( key, *base ) );
 }
 
+static bool ARSearchHashIndex( ar_dict_entry *dict, const char *name, unsigned long *off )
+/***************************************************************************************/
+/* Probe the hashed symbol index for specified symbol. */
+{
+    unsigned_32         hash;
+    unsigned_32         mask;
+    unsigned_32         i;
+    unsigned_32         count;
+    unsigned_32         name_offset;
+    unsigned_32         file_offset;
+    unsigned long       names;
+    const unsigned_8    *bucket;
+    const char          *p;
+
+    hash = AR_HASH_INIT;
+    for( p = name; *p != '\0'; ++p ) {
+        hash = AR_HASH_STEP( hash, *p );
+    }
+    mask = dict->hash_buckets - 1;
+    names = AR_HASH_HEADER_SIZE + (unsigned long)dict->hash_buckets * AR_HASH_BUCKET_SIZE;
+    for( i = hash & mask, count = dict->hash_buckets; count > 0; i = ( i + 1 ) & mask, --count ) {
+        bucket = dict->hashtab + AR_HASH_HEADER_SIZE + (unsigned long)i * AR_HASH_BUCKET_SIZE;
+        file_offset = MGET_LE_32_UN( bucket + 8 );
+        if( file_offset == 0 )
+            break;
+        if( MGET_LE_32_UN( bucket ) != hash )
+            continue;
+        name_offset = MGET_LE_32_UN( bucket + 4 );
+        if( names + name_offset >= dict->hash_size )
+            continue;
+        p = (const char *)dict->hashtab + names + name_offset;
+        if( LinkFlags & LF_CASE_FLAG ) {
+            if( strcmp( name, p ) != 0 ) {
+                continue;
+            }
+        } else {
+            if( stricmp( name, p ) != 0 ) {
+                continue;
+            }
+        }
+        *off = file_offset;
+        return( true );
+    }
+    return( false );
+}
+
 static bool ARSearchExtLib( file_list *lib, const char *name, unsigned long *off )
 /********************************************************************************/
 /* Search AR format library for specified member. */
@@ -594,6 +702,9 @@ static bool ARSearchExtLib( file_list *lib, const char *name, unsigned long *off
     unsigned            tabidx;
 
     dict = &lib->u.dict->a;
+    if( dict->hashtab != NULL ) {
+        return( ARSearchHashIndex( dict, name, off ) );
+    }
     if( LinkFlags & LF_CASE_FLAG ) {
         result = bsearch( name, dict->symbtab, dict->num_entries, sizeof( char * ), ARCompName );
     } else {
@@ -642,11 +753,12 @@ mod_entry *SearchLib( file_list *lib, const char *name )
      *  update lib struct since we found desired object file
      */
     obj = NewModEntry();
-    obj->location = pos;
     obj->f.source = lib;
     obj->modtime = lib->infile->modtime;
     obj->modinfo = (lib->flags & DBI_MASK) | (ObjFormat & FMT_OBJ_FMT_MASK);
     objname = IdentifyObject( lib, &pos, &dummy );
+    /* an AR member starts after its header */
+    obj->location = pos;
     if( objname != NULL ) {
         obj->name.u.ptr = AddStringStringTable( &PermStrings, objname );
         _LnkFree( objname );
@@ -34,6 +34,13 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include "walloca.h"
+#if defined( __UNIX__ ) && !defined( __QNX__ ) && !defined( USE_VIRTMEM )
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define USE_MAPPED_OUTPUT
+#endif
 #include "linkstd.h"
 #if !defined( __UNIX__ ) || defined(__WATCOMC__)
 #include <process.h>
@@ -75,6 +82,14 @@
 
 
 #define IMPLIB_BUFSIZE  _4K
+#define BUFF_BLOCK_SIZE _16K
+
+#ifdef USE_MAPPED_OUTPUT
+/* groups with at least this much data are copied into a mapping of the
+ * load file by several threads */
+#define MAPPED_MIN_SIZE     _1M
+#define MAPPED_MAX_THREADS  8
+#endif
 
 typedef struct {
     f_handle    handle;
@@ -86,10 +101,31 @@ typedef struct {
     boolbit     didone  : 1;
 } implibinfo;
 
+#ifdef USE_MAPPED_OUTPUT
+typedef struct {
+    segdata         *sdata;
+    unsigned long   pos;        // load file position of the data
+} piece_write;
+
+typedef struct {
+    piece_write     *pieces;
+    size_t          first;
+    size_t          last;
+    unsigned long   prev_end;   // end of the data before the first piece
+    char            *map;
+    unsigned long   map_base;   // load file position of map
+} mapped_work;
+#endif
+
 typedef struct  {
     unsigned_32 grp_start;
     unsigned_32 seg_start;
     group_entry *lastgrp;       // used only for copy classes
+#ifdef USE_MAPPED_OUTPUT
+    piece_write *pieces;        // collect the pieces rather than write them
+    size_t      num_pieces;
+    size_t      max_pieces;
+#endif
     boolbit     repos   : 1;
     boolbit     copy    : 1;
 } grpwriteinfo;
@@ -1095,6 +1131,24 @@ static bool WriteSegData( void *_sdata, void *_info )
 
     if( !sdata->isuninit && !sdata->isdead && ( sdata->length > 0 ) ) {
         newpos = info->seg_start + sdata->a.delta;
+        if( sdata->vm_data == 0 ) {
+            sdata->vm_data = sdata->u1.vm_ptr;
+        }
+        if( !info->copy ) {
+            sdata->u1.vm_offs = newpos;   // for incremental linking
+        }
+#ifdef USE_MAPPED_OUTPUT
+        if( info->pieces != NULL ) {
+            if( info->num_pieces == info->max_pieces ) {
+                info->max_pieces *= 2;
+                _LnkRealloc( info->pieces, info->pieces, info->max_pieces * sizeof( piece_write ) );
+            }
+            info->pieces[info->num_pieces].sdata = sdata;
+            info->pieces[info->num_pieces].pos = newpos;
+            info->num_pieces++;
+            return( false );
+        }
+#endif
         if( info->repos ) {
             SeekLoad( newpos );
         } else {
@@ -1102,12 +1156,6 @@ static bool WriteSegData( void *_sdata, void *_info )
             DbgAssert( newpos >= oldpos );
             PadLoad( newpos - oldpos );
         }
-        if( sdata->vm_data == 0 ) {
-            sdata->vm_data = sdata->u1.vm_ptr;
-        }
-        if( !info->copy ) {
-            sdata->u1.vm_offs = newpos;   // for incremental linking
-        }
         WriteInfoLoad( sdata->vm_data, sdata->length );
     }
     return( false );
@@ -1127,6 +1175,9 @@ void WriteLeaderLoad( void *seg )
     info.repos = false;
     info.copy = false;
     info.seg_start = PosLoad();
+#ifdef USE_MAPPED_OUTPUT
+    info.pieces = NULL;
+#endif
     DoWriteLeader( seg, &info );
 }
 
@@ -1173,6 +1224,143 @@ static bool WriteCopyGroups( void *_seg, void *_info )
     return( false );
 }
 
+#ifdef USE_MAPPED_OUTPUT
+static void *WriteMappedPieces( void *_work )
+/*******************************************/
+/* copy a run of pieces into the mapping, padding the gaps in front of them.
+ * Nothing in here may call back into the linker proper */
+{
+    mapped_work     *work = _work;
+    piece_write     *piece;
+    unsigned long   end;
+    size_t          i;
+
+    end = work->prev_end;
+    for( i = work->first; i < work->last; i++ ) {
+        piece = &work->pieces[i];
+        memset( work->map + ( end - work->map_base ), FmtData.FillChar, piece->pos - end );
+        memcpy( work->map + ( piece->pos - work->map_base ), piece->sdata->vm_data, piece->sdata->length );
+        end = piece->pos + piece->sdata->length;
+    }
+    return( NULL );
+}
+
+static bool WriteMapped( outfilelist *outfile, piece_write *pieces, size_t num_pieces )
+/*************************************************************************************/
+/* write the pieces of a group with several threads, each copying a run of
+ * them straight into a shared mapping of the load file. The load file is
+ * left positioned after the last piece as if it had been written with
+ * WriteLoad. Returns false without having written anything if the
+ * mapping can't be made */
+{
+    mapped_work     work[MAPPED_MAX_THREADS];
+    pthread_t       threads[MAPPED_MAX_THREADS];
+    bool            started[MAPPED_MAX_THREADS];
+    unsigned long   start;
+    unsigned long   end;
+    unsigned long   map_base;
+    size_t          map_len;
+    unsigned long   pagesize;
+    unsigned long   share;
+    unsigned long   done;
+    size_t          modpos;
+    size_t          i;
+    unsigned        nthreads;
+    unsigned        t;
+    long            ncpu;
+    char            *map;
+    struct stat     st;
+
+    if( outfile->buffer != NULL ) {
+        start = outfile->bufpos;
+        modpos = start % BUFF_BLOCK_SIZE;
+    } else {
+        start = QPos( outfile->handle );
+        modpos = 0;
+    }
+    end = start;
+    for( i = 0; i < num_pieces; i++ ) {
+        pieces[i].pos += outfile->origin;
+        if( pieces[i].pos < end )
+            return( false );
+        end = pieces[i].pos + pieces[i].sdata->length;
+    }
+    pagesize = sysconf( _SC_PAGESIZE );
+    map_base = ( start - modpos ) & ~( pagesize - 1 );
+    if( fstat( outfile->handle, &st ) != 0 )
+        return( false );
+    if( st.st_size < end && ftruncate( outfile->handle, end ) != 0 )
+        return( false );
+    map_len = end - map_base;
+    map = mmap( NULL, map_len, PROT_READ | PROT_WRITE, MAP_SHARED, outfile->handle, map_base );
+    if( map == MAP_FAILED )
+        return( false );
+    if( modpos > 0 ) {
+        /* the start of the block still sitting in the buffer */
+        memcpy( map + ( start - modpos - map_base ), outfile->buffer, modpos );
+    }
+    ncpu = sysconf( _SC_NPROCESSORS_ONLN );
+    nthreads = ( ncpu < 1 ) ? 1 : ( ncpu > MAPPED_MAX_THREADS ) ? MAPPED_MAX_THREADS : ncpu;
+    if( nthreads > num_pieces )
+        nthreads = num_pieces;
+    /* hand each thread about the same amount of data */
+    share = ( end - start ) / nthreads + 1;
+    i = 0;
+    for( t = 0; t < nthreads; t++ ) {
+        work[t].pieces = pieces;
+        work[t].map = map;
+        work[t].map_base = map_base;
+        work[t].first = i;
+        work[t].prev_end = ( i == 0 ) ? start : pieces[i - 1].pos + pieces[i - 1].sdata->length;
+        done = 0;
+        while( i < num_pieces && ( done < share || t == nthreads - 1 ) ) {
+            done += pieces[i].sdata->length;
+            i++;
+        }
+        work[t].last = i;
+        started[t] = false;
+        if( t > 0 && work[t].first < work[t].last ) {
+            started[t] = ( pthread_create( &threads[t], NULL, WriteMappedPieces, &work[t] ) == 0 );
+        }
+    }
+    WriteMappedPieces( &work[0] );
+    for( t = 1; t < nthreads; t++ ) {
+        if( started[t] ) {
+            pthread_join( threads[t], NULL );
+        } else {
+            WriteMappedPieces( &work[t] );
+        }
+    }
+    if( outfile->buffer != NULL ) {
+        /* keep the buffer holding the start of the current block */
+        modpos = end % BUFF_BLOCK_SIZE;
+        memcpy( outfile->buffer, map + ( end - modpos - map_base ), modpos );
+        outfile->bufpos = end;
+        end -= modpos;
+    }
+    munmap( map, map_len );
+    QSeek( outfile->handle, end, outfile->fname );
+    return( true );
+}
+
+static bool WriteGroupMapped( group_entry *group, grpwriteinfo *info )
+/********************************************************************/
+{
+    bool        ok;
+
+    if( group->size < MAPPED_MIN_SIZE )
+        return( false );
+    info->num_pieces = 0;
+    info->max_pieces = 64;
+    _ChkAlloc( info->pieces, info->max_pieces * sizeof( piece_write ) );
+    Ring2Lookup( group->leaders, DoGroupLeader, info );
+    ok = ( info->num_pieces > 0 ) && WriteMapped( CurrSect->outfile, info->pieces, info->num_pieces );
+    _LnkFree( info->pieces );
+    info->pieces = NULL;
+    return( ok );
+}
+#endif
+
 offset  WriteGroupLoad( group_entry *group, bool repos )
 /******************************************************/
 {
@@ -1183,6 +1371,9 @@ offset  WriteGroupLoad( group_entry *group, bool repos )
     grp_start = PosLoad();
     info.repos = repos;
     info.grp_start = grp_start;
+#ifdef USE_MAPPED_OUTPUT
+    info.pieces = NULL;
+#endif
     // If group is a copy group, substitute source group(s) here
     class = group->leaders->class;
     if( class->flags & CLASS_COPY ) {
@@ -1191,6 +1382,11 @@ offset  WriteGroupLoad( group_entry *group, bool repos )
         RingLookup( class->DupClass->segs->group->leaders, WriteCopyGroups, &info );
     } else {
         info.copy = false;
+#ifdef USE_MAPPED_OUTPUT
+        if( !repos && WriteGroupMapped( group, &info ) ) {
+            return( PosLoad() - grp_start );
+        }
+#endif
         Ring2Lookup( group->leaders, DoGroupLeader, &info );
     }
     return( PosLoad() - grp_start );
@@ -1219,8 +1415,6 @@ static void *SetToFillChar( void *dest, const void *dummy, size_t size )
     return( (void *)dummy );
 }
 
-#define BUFF_BLOCK_SIZE _16K
-
 static void WriteBuffer( const char *data, size_t len, outfilelist *outfile, writebuffer_fn *rtn )
 /************************************************************************************************/
 {
@@ -1230,9 +1424,16 @@ static void WriteBuffer( const char *data, size_t len, outfilelist *outfile, wri
     modpos = outfile->bufpos % BUFF_BLOCK_SIZE;
     outfile->bufpos += len;
     while( modpos + len >= BUFF_BLOCK_SIZE ) {
-        adjust = BUFF_BLOCK_SIZE - modpos;
-        rtn( outfile->buffer + modpos, data, adjust );
-        QWrite( outfile->handle, outfile->buffer, BUFF_BLOCK_SIZE, outfile->fname );
+        if( modpos == 0 && rtn == memcpy ) {
+            /* whole blocks of segment data go straight out, no need to
+             * copy them through the buffer first */
+            adjust = len - len % BUFF_BLOCK_SIZE;
+            QWrite( outfile->handle, data, adjust, outfile->fname );
+        } else {
+            adjust = BUFF_BLOCK_SIZE - modpos;
+            rtn( outfile->buffer + modpos, data, adjust );
+            QWrite( outfile->handle, outfile->buffer, BUFF_BLOCK_SIZE, outfile->fname );
+        }
         data += adjust;
         len -= adjust;
         modpos = 0;
@@ -33,12 +33,20 @@
 
 /*
   MIXCACHE - object file caching routines which do both full file caching
-                and paged caching.
+                and paged caching. Where the host can, files are mapped
+                rather than read into cache blocks.
 */
 
 #include <string.h>
 #include <limits.h>
 #include <stdio.h>
+#if defined( __UNIX__ ) && !defined( __QNX__ )
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#define USE_READ_AHEAD
+#define USE_MMAP
+#endif
 #include "linkstd.h"
 #include "msg.h"
 #include "alloc.h"
@@ -50,7 +58,44 @@
 
 #define CACHE_PAGE_SIZE _8K
 
+#define READ_AHEAD_FILES    8   /* # of object files read ahead of pass 1 */
+#define READ_AHEAD_THREADS  4
+
+/* limit on the total size of the mapped files, so that a link with big
+ * libraries doesn't run a 32-bit host out of address space */
+#define MAP_MAX_TOTAL   ((sizeof( void * ) > 4) ? ULONG_MAX : 512UL * 1024 * 1024)
+
 static bool             Multipage;
+#ifdef USE_MMAP
+static unsigned long    MappedTotal;
+#endif
+
+#ifdef USE_READ_AHEAD
+typedef enum {
+    RA_FREE,
+    RA_QUEUED,
+    RA_READING,
+    RA_DONE
+} ra_state;
+
+typedef struct {
+    infilelist      *infile;
+    int             handle;
+    char            *buf;
+    unsigned long   len;
+    ra_state        state;
+    bool            ok;
+    bool            mapped;     // just fault in the pages of buf
+} read_ahead;
+
+static read_ahead       ReadAheads[READ_AHEAD_FILES];
+static pthread_mutex_t  RAMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   RAQueued = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t   RADone = PTHREAD_COND_INITIALIZER;
+static pthread_t        RAThreadIds[READ_AHEAD_THREADS];
+static unsigned         RAThreads;
+static bool             RAShutdown;
+#endif
 
 static unsigned NumCacheBlocks( unsigned long len )
 /*************************************************/
@@ -65,6 +110,244 @@ static unsigned NumCacheBlocks( unsigned long len )
     return( numblocks );
 }
 
+#ifdef USE_MMAP
+static bool MapInfile( infilelist *infile )
+/*****************************************/
+/* map the whole file to back a full cache, so the readers get pointers
+ * straight into the page cache. The mapping is private and writable since
+ * some readers patch the data they are handed. INSTAT_MAPPED records that
+ * the cache has to be unmapped rather than freed */
+{
+    void    *p;
+
+    if( infile->len > MAP_MAX_TOTAL - MappedTotal )
+        return( false );
+    p = mmap( NULL, infile->len, PROT_READ | PROT_WRITE, MAP_PRIVATE, infile->handle, 0 );
+    if( p == MAP_FAILED )
+        return( false );
+    MappedTotal += infile->len;
+    infile->cache = p;
+    infile->status |= INSTAT_MAPPED;
+    return( true );
+}
+#endif
+
+static void SetCacheType( infilelist *infile )
+/*******************************************/
+/* pick the cache type of a file. It stays the same for as long as the file
+ * is around, since CacheFree depends on it */
+{
+    if( (infile->status & INSTAT_SET_CACHE) == 0 ) {
+        if( LinkFlags & LF_CACHE_FLAG ) {
+            infile->status |= INSTAT_FULL_CACHE;
+        } else if( LinkFlags & LF_NOCACHE_FLAG ) {
+            infile->status |= INSTAT_PAGE_CACHE;
+        } else {
+            if( infile->status & INSTAT_LIBRARY ) {
+#ifdef USE_MMAP
+                /* a library is only fully cached if it can be mapped */
+                if( infile->cache == NULL && MapInfile( infile ) ) {
+                    infile->status |= INSTAT_FULL_CACHE;
+                    return;
+                }
+#endif
+                infile->status |= INSTAT_PAGE_CACHE;
+            } else {
+                infile->status |= INSTAT_FULL_CACHE;
+            }
+        }
+    }
+}
+
+#ifdef USE_READ_AHEAD
+
+static void *ReadAheadThread( void *arg )
+/***************************************/
+/* read whole object files into buffers handed out by the main thread.
+ * Nothing in here may call back into the linker proper */
+{
+    read_ahead      *ra;
+    unsigned long   done;
+    ssize_t         amt;
+    int             i;
+
+    /* unused parameters */ (void)arg;
+
+    pthread_mutex_lock( &RAMutex );
+    for( ;; ) {
+        ra = NULL;
+        for( i = 0; i < READ_AHEAD_FILES; i++ ) {
+            if( ReadAheads[i].state == RA_QUEUED ) {
+                ra = &ReadAheads[i];
+                break;
+            }
+        }
+        if( ra == NULL ) {
+            if( RAShutdown )
+                break;
+            pthread_cond_wait( &RAQueued, &RAMutex );
+            continue;
+        }
+        ra->state = RA_READING;
+        pthread_mutex_unlock( &RAMutex );
+        done = 0;
+        if( ra->mapped ) {
+            /* fault the pages in, the kernel does the reading */
+            for( ; done < ra->len; done += _4K ) {
+                (void)*(volatile char *)( ra->buf + done );
+            }
+            done = ra->len;
+        } else if( lseek( ra->handle, 0, SEEK_SET ) == 0 ) {
+            /* the handle is ours until the main thread has waited for us */
+            for( ; done < ra->len; done += amt ) {
+                amt = read( ra->handle, ra->buf + done, ra->len - done );
+                if( amt <= 0 ) {
+                    break;
+                }
+            }
+        }
+        pthread_mutex_lock( &RAMutex );
+        ra->ok = ( done == ra->len );
+        ra->state = RA_DONE;
+        pthread_cond_broadcast( &RADone );
+    }
+    pthread_mutex_unlock( &RAMutex );
+    return( NULL );
+}
+
+static read_ahead *FindReadAhead( infilelist *infile )
+/****************************************************/
+{
+    int     i;
+
+    for( i = 0; i < READ_AHEAD_FILES; i++ ) {
+        if( ReadAheads[i].state != RA_FREE && ReadAheads[i].infile == infile ) {
+            return( &ReadAheads[i] );
+        }
+    }
+    return( NULL );
+}
+
+static bool ReadAheadWait( infilelist *infile )
+/*********************************************/
+/* wait for a pending read-ahead of the file. Returns true if the file
+ * is now fully cached, false if it has to be read the normal way */
+{
+    read_ahead  *ra;
+    bool        ok;
+
+    if( (infile->status & INSTAT_READ_AHEAD) == 0 )
+        return( false );
+    pthread_mutex_lock( &RAMutex );
+    ra = FindReadAhead( infile );
+    while( ra->state != RA_DONE ) {
+        pthread_cond_wait( &RADone, &RAMutex );
+    }
+    ra->state = RA_FREE;
+    ok = ra->ok;
+    pthread_mutex_unlock( &RAMutex );
+    infile->status &= ~(INSTAT_READ_AHEAD | INSTAT_IN_USE);
+    if( ra->mapped ) {
+        return( true );
+    } else if( ok ) {
+        infile->cache = ra->buf;
+        infile->currpos = infile->len;
+    } else {
+        infile->currpos = ULONG_MAX;    // force a seek before the next read
+        _LnkFree( ra->buf );
+    }
+    return( ok );
+}
+
+static void ReadAheadFile( infilelist *infile )
+/*********************************************/
+{
+    read_ahead      *ra;
+    int             i;
+    infile_status   nowarn;
+    bool            opened;
+
+    ra = NULL;
+    for( i = 0; i < READ_AHEAD_FILES; i++ ) {
+        if( ReadAheads[i].state == RA_FREE ) {
+            ra = &ReadAheads[i];
+            break;
+        }
+    }
+    if( ra == NULL )
+        return;
+    /* failures are reported when pass 1 gets to the file */
+    nowarn = infile->status & INSTAT_NO_WARNING;
+    infile->status |= INSTAT_NO_WARNING;
+    opened = DoObjOpen( infile );
+    infile->status = ( infile->status & ~INSTAT_NO_WARNING ) | nowarn;
+    if( !opened )
+        return;
+    if( infile->len == 0 ) {
+        infile->len = QFileSize( infile->handle );
+        if( infile->len == 0 ) {
+            return;
+        }
+    }
+    SetCacheType( infile );
+    if( infile->status & INSTAT_PAGE_CACHE )
+        return;
+    ra->mapped = false;
+#ifdef USE_MMAP
+    ra->mapped = MapInfile( infile );
+#endif
+    if( RAThreads == 0 ) {
+        pthread_mutex_lock( &RAMutex );
+        RAShutdown = false;
+        pthread_mutex_unlock( &RAMutex );
+    }
+    if( RAThreads < READ_AHEAD_THREADS ) {
+        if( pthread_create( &RAThreadIds[RAThreads], NULL, ReadAheadThread, NULL ) == 0 ) {
+            RAThreads++;
+        } else if( RAThreads == 0 ) {
+            return;
+        }
+    }
+    /* keep the handle from being closed while a worker uses it */
+    infile->status |= INSTAT_READ_AHEAD | INSTAT_IN_USE;
+    ra->infile = infile;
+    ra->handle = infile->handle;
+    ra->len = infile->len;
+    if( ra->mapped ) {
+        ra->buf = infile->cache;
+    } else {
+        _ChkAlloc( ra->buf, infile->len );
+    }
+    pthread_mutex_lock( &RAMutex );
+    ra->state = RA_QUEUED;
+    pthread_cond_signal( &RAQueued );
+    pthread_mutex_unlock( &RAMutex );
+}
+
+#endif
+
+void CacheReadAhead( file_list *list )
+/*******************************************/
+/* start reading the next few object files in the background, so pass 1
+ * finds them already cached. Libraries are paged, so they are left alone */
+{
+#ifdef USE_READ_AHEAD
+    int         i;
+    infilelist  *infile;
+
+    for( i = 0; list != NULL && i < READ_AHEAD_FILES; list = list->next_file, i++ ) {
+        infile = list->infile;
+        if( (infile->status & (INSTAT_LIBRARY | INSTAT_IOERR | INSTAT_READ_AHEAD))
+          || infile->cache != NULL || (list->flags & STAT_IS_LIB) ) {
+            continue;
+        }
+        ReadAheadFile( infile );
+    }
+#else
+    /* unused parameters */ (void)list;
+#endif
+}
+
 bool CacheOpen( file_list *list )
 /**************************************/
 {
@@ -77,6 +360,9 @@ bool CacheOpen( file_list *list )
     infile = list->infile;
     if( infile->status & INSTAT_IOERR )
         return( false );
+#ifdef USE_READ_AHEAD
+    ReadAheadWait( infile );
+#endif
     if( DoObjOpen( infile ) ) {
         infile->status |= INSTAT_IN_USE;
     } else {
@@ -91,21 +377,14 @@ bool CacheOpen( file_list *list )
             return( false );
         }
     }
-    if( (infile->status & INSTAT_SET_CACHE) == 0 ) {
-        if( LinkFlags & LF_CACHE_FLAG ) {
-            infile->status |= INSTAT_FULL_CACHE;
-        } else if( LinkFlags & LF_NOCACHE_FLAG ) {
-            infile->status |= INSTAT_PAGE_CACHE;
-        } else {
-            if( infile->status & INSTAT_LIBRARY ) {
-                infile->status |= INSTAT_PAGE_CACHE;
-            } else {
-                infile->status |= INSTAT_FULL_CACHE;
-            }
-        }
-    }
+    SetCacheType( infile );
     if( infile->cache == NULL ) {
         if( infile->status & INSTAT_FULL_CACHE ) {
+#ifdef USE_MMAP
+            if( MapInfile( infile ) ) {
+                return( true );
+            }
+#endif
             _ChkAlloc( infile->cache, infile->len );
             if( infile->currpos != 0 ) {
                 QLSeek( infile->handle, 0, SEEK_SET, infile->name.u.ptr );
@@ -154,6 +433,27 @@ static bool DumpFileCache( infilelist *infile, bool nuke )
     return( blockfreed );
 }
 
+static void FreeFileCache( infilelist *infile )
+/*********************************************/
+{
+#ifdef USE_MMAP
+    if( infile->status & INSTAT_MAPPED ) {
+        munmap( infile->cache, infile->len );
+        MappedTotal -= infile->len;
+        /* the cache type stays, if the file can't be mapped again it is read */
+        infile->status &= ~INSTAT_MAPPED;
+        infile->cache = NULL;
+        return;
+    }
+#endif
+    if( infile->status & INSTAT_FULL_CACHE ) {
+        _LnkFree( infile->cache );
+    } else {
+        DumpFileCache( infile, true );
+    }
+    infile->cache = NULL;
+}
+
 void CacheClose( file_list *list, unsigned pass )
 /******************************************************/
 {
@@ -287,9 +587,54 @@ bool CacheEnd( file_list *list, unsigned long pos )
     return( pos >= list->infile->len );
 }
 
+#ifdef USE_READ_AHEAD
+static void ReadAheadStop( bool freecache )
+/*****************************************/
+/* wait for the outstanding read-aheads and join the workers, so none of
+ * them is left running once the files have been dealt with */
+{
+    int         i;
+    unsigned    j;
+    infilelist  *infile;
+
+    for( i = 0; i < READ_AHEAD_FILES; i++ ) {
+        if( ReadAheads[i].state != RA_FREE ) {
+            infile = ReadAheads[i].infile;
+            if( ReadAheadWait( infile ) && freecache ) {
+                FreeFileCache( infile );
+            }
+        }
+    }
+    if( RAThreads == 0 )
+        return;
+    pthread_mutex_lock( &RAMutex );
+    RAShutdown = true;
+    pthread_cond_broadcast( &RAQueued );
+    pthread_mutex_unlock( &RAMutex );
+    for( j = 0; j < RAThreads; j++ ) {
+        pthread_join( RAThreadIds[j], NULL );
+    }
+    RAThreads = 0;
+}
+#endif
+
+void CacheReadAheadFini( void )
+/************************************/
+/* pass 1 is done with the object files, anything still read ahead is
+ * kept as the file's cache */
+{
+#ifdef USE_READ_AHEAD
+    ReadAheadStop( false );
+#endif
+}
+
 void CacheFini( void )
 /********************/
 {
+#ifdef USE_READ_AHEAD
+    /* don't leave workers writing into memory that is about to go away */
+    ReadAheadStop( true );
+#endif
 }
 
 void CacheFree( file_list *list, void *mem )
@@ -306,12 +651,7 @@ void FreeObjCache( file_list *list )
 {
     if( list == NULL )
         return;
-    if( list->infile->status & INSTAT_FULL_CACHE ) {
-        _LnkFree( list->infile->cache );
-    } else {
-        DumpFileCache( list->infile, true );
-    }
-    list->infile->cache = NULL;
+    FreeFileCache( list->infile );
 }
 
 bool DumpObjCache( void )
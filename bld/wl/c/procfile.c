@@ -576,6 +576,7 @@ void ProcObjFiles( void )
         }
 #endif
     }
+    CacheReadAheadFini();
 }
 
 void LoadObjFiles( section *sect )
@@ -586,6 +587,7 @@ void LoadObjFiles( section *sect )
     CurrSect = sect;
     CurrMod = NULL;
     for( list = sect->files; list != NULL; list = list->next_file ) {
+        CacheReadAhead( list->next_file );
         DoPass1( NULL, list );
     }
 }
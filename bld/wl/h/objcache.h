@@ -30,6 +30,8 @@
 ****************************************************************************/
 
 
+extern void     CacheReadAhead( file_list * );
+extern void     CacheReadAheadFini( void );
 extern bool     CacheOpen( file_list * );
 extern void     CacheClose( file_list *, unsigned );
 extern void     *CachePermRead( file_list *, unsigned long, size_t );
@@ -110,7 +110,9 @@ typedef enum {
     INSTAT_FULL_CACHE   = 0x0020,   // read entire file.
     INSTAT_PAGE_CACHE   = 0x0040,   // read in "paged"
     INSTAT_GOT_MODTIME  = 0x0080,
-    INSTAT_NO_WARNING   = 0x0100
+    INSTAT_NO_WARNING   = 0x0100,
+    INSTAT_READ_AHEAD   = 0x0200,   // being read by a read-ahead worker
+    INSTAT_MAPPED       = 0x0400    // full cache is a mapping of the file
 } infile_status;
 
 #define INSTAT_SET_CACHE (INSTAT_FULL_CACHE | INSTAT_PAGE_CACHE)
@@ -33,9 +33,9 @@
 
 #define INC_FILE_SIG_SIZE        36
 #ifdef __QNX__
-#define INC_FILE_SIG  "WLINK Incremental Link File V1.03\n\x0c\x04"
+#define INC_FILE_SIG  "WLINK Incremental Link File V1.04\n\x0c\x04"
 #else
-#define INC_FILE_SIG  "WLINK Incremental Link File V1.03\r\n\x1a"
+#define INC_FILE_SIG  "WLINK Incremental Link File V1.04\r\n\x1a"
 #endif
 
 typedef struct {
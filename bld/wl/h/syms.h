@@ -195,6 +195,7 @@ typedef struct symbol {
     struct symbol       *publink;
     struct symbol       *link;
     targ_addr           addr;
+    unsigned_32         hashval;    // full hash of the name, before masking
     unsigned_16         namelen_cmp;
     sym_info            info;       // flags & floating point patch type.
     struct mod_entry    *mod;
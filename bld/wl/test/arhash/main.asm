@@ -0,0 +1,21 @@
+; Pulls one symbol out of each member of the test libraries.
+
+.386
+.model flat
+
+extrn   Alpha:near
+extrn   alpha_2:near
+extrn   BETA@4:near
+extrn   gamma_Delta:near
+
+.code
+public  _start
+_start  proc
+        call    Alpha
+        call    alpha_2
+        call    BETA@4
+        call    gamma_Delta
+        ret
+_start  endp
+
+end     _start
@@ -0,0 +1,17 @@
+.386
+.model flat
+
+.code
+public  Alpha
+Alpha   proc
+        mov     eax,1
+        ret
+Alpha   endp
+
+public  alpha_2
+alpha_2 proc
+        mov     eax,2
+        ret
+alpha_2 endp
+
+end
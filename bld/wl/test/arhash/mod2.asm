@@ -0,0 +1,11 @@
+.386
+.model flat
+
+.code
+public  BETA@4
+BETA@4  proc
+        mov     eax,3
+        ret
+BETA@4  endp
+
+end
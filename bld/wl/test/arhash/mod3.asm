@@ -0,0 +1,18 @@
+.386
+.model flat
+
+.code
+public  gamma_Delta
+gamma_Delta proc
+        mov     eax,4
+        ret
+gamma_Delta endp
+
+; not referenced, must not be linked in
+public  unused_Sym
+unused_Sym proc
+        mov     eax,5
+        ret
+unused_Sym endp
+
+end
@@ -0,0 +1,89 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Copy an AR library with the last byte of its hashed
+*               symbol index changed from NUL.
+*
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ar.h"
+
+
+int main( int argc, char *argv[] )
+{
+    FILE            *fp;
+    char            *buff;
+    long            size;
+    long            pos;
+    long            len;
+    ar_header       *head;
+
+    if( argc != 3 ) {
+        printf( "Usage: nonul <hashed lib> <output lib>\n" );
+        return( EXIT_FAILURE );
+    }
+    fp = fopen( argv[1], "rb" );
+    if( fp == NULL ) {
+        printf( "cannot open %s\n", argv[1] );
+        return( EXIT_FAILURE );
+    }
+    fseek( fp, 0, SEEK_END );
+    size = ftell( fp );
+    fseek( fp, 0, SEEK_SET );
+    buff = malloc( size );
+    if( buff == NULL || fread( buff, 1, size, fp ) != (size_t)size ) {
+        printf( "cannot read %s\n", argv[1] );
+        return( EXIT_FAILURE );
+    }
+    fclose( fp );
+    if( size < AR_IDENT_LEN || memcmp( buff, AR_IDENT, AR_IDENT_LEN ) != 0 ) {
+        printf( "%s is not an AR library\n", argv[1] );
+        return( EXIT_FAILURE );
+    }
+    for( pos = AR_IDENT_LEN; pos + (long)AR_HEADER_SIZE <= size; pos += len + ( len & 1 ) ) {
+        head = (ar_header *)( buff + pos );
+        len = strtol( head->size, NULL, 10 );
+        pos += AR_HEADER_SIZE;
+        if( len <= 0 || pos + len > size )
+            break;
+        if( memcmp( head->name, AR_HASH_NAME, AR_HASH_NAME_LEN ) == 0 ) {
+            /* the index ends with the NUL of its last name */
+            buff[pos + len - 1] = 'x';
+            fp = fopen( argv[2], "wb" );
+            if( fp == NULL || fwrite( buff, 1, size, fp ) != (size_t)size ) {
+                printf( "cannot write %s\n", argv[2] );
+                return( EXIT_FAILURE );
+            }
+            fclose( fp );
+            return( EXIT_SUCCESS );
+        }
+    }
+    printf( "%s has no hashed symbol index\n", argv[1] );
+    return( EXIT_FAILURE );
+}
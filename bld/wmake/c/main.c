@@ -266,6 +266,15 @@ STATIC char *procFlags( char const * const *argv, const char **log_name )
 #endif
                 case 'y':   Glob.show_offenders = true; break;
                 case 'z':   Glob.hold           = true; break;
+                case 'g':
+                    /* requires a number of jobs, not passed to MAKEFLAGS */
+                    p = *++argv;
+                    if( p == NULL || !isdigit( (unsigned char)*p ) || (Glob.jobs = (UINT16)strtoul( p, NULL, 10 )) == 0 ) {
+                        PrtMsg( ERR | INVALID_JOBS_OPTION, select, option );
+                        Usage();
+                        // never return
+                    }
+                    continue;
                     /* these options require a filename */
                 case 'f':
                 case 'l':
@@ -611,6 +620,8 @@ static int ExitSafe( int rc )
 
     if( !busy ) {
         busy = true;
+        /* don't leave parallel jobs behind */
+        UpdateWaitJobs();
         if( rc == EXIT_ERROR || rc == EXIT_FATAL ) {
             PrtMsg( ERR | MAKE_ABORT );
         }
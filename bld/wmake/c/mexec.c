@@ -195,6 +195,10 @@ STATIC bool     execLine( char *line ); /* called recursively in handleFor */
 STATIC NKLIST   *noKeepList;            /* contains the list of files that
                                            needs to be cleaned when wmake
                                            exits */
+#ifdef __UNIX__
+STATIC NKLIST   *jobNoKeepList;         /* noKeepList when the parallel job
+                                           process was started */
+#endif
 
 char *CmdGetFileName( char *src, char **fname, bool osname )
 /**********************************************************/
@@ -2523,3 +2527,32 @@ void ExecFini( void )
      */
     destroyNKList();
 }
+
+#ifdef __UNIX__
+void ExecJobInit( void )
+/***********************
+ * called in the child process of a parallel job
+ */
+{
+    jobNoKeepList = noKeepList;
+    /*
+     * jobs run concurrently, so don't let them pick the same temp file names
+     */
+    tmpFileNumber = (UINT16)( ( getpid() + time( NULL ) ) % 100000 );
+}
+
+
+void ExecJobFini( void )
+/***********************
+ * the job process ends, its list of files is lost with it, so destroy
+ * the files that it created and will not be kept
+ */
+{
+    NKLIST const    *temp;
+
+    closeCurrentFile();
+    for( temp = noKeepList; temp != jobNoKeepList; temp = temp->next ) {
+        remove( temp->fileName );
+    }
+}
+#endif
@@ -36,6 +36,12 @@
 #else
     #include <sys/utime.h>
 #endif
+#ifdef __UNIX__
+    #include <errno.h>
+    #include <sys/types.h>
+    #include <sys/time.h>
+    #include <sys/wait.h>
+#endif
 #include "make.h"
 #include "wio.h"
 #include "macros.h"
@@ -58,6 +64,8 @@
 
 
 STATIC bool     checkForAutoDeps( TARGET *targ, char *name, time_t *max_time );
+STATIC RET_T    carryOutDone( TARGET *targ, bool ok, time_t max_time );
+STATIC bool     updateDone( TARGET *targ, UINT32 startcount );
 
 /*
  *  exStack is used to stack the special macro pointers during ExecCList()
@@ -75,6 +83,41 @@ STATIC UINT8            exStackP;
 STATIC bool             doneBefore;     /* executed the .BEFORE commands? */
 STATIC UINT32           cListCount;     /* number of CLISTs executed so far */
 
+#ifdef __UNIX__
+/*
+ *  With -g <n> the command lists are executed by forked wmake processes.
+ *  Each job collects its stdout and stderr output into its own buffers,
+ *  they are written out in one piece when the job terminates. The parent
+ *  waits for a pending target only when its state is needed.
+ */
+typedef struct jobOutput {
+    char        *data;
+    size_t      len;
+    size_t      size;
+    int         fd;                 /* read end of the pipe, -1 after EOF   */
+} JOBOUT;
+
+typedef struct job  JOB;
+struct job {
+    JOB             *next;
+    TARGET          *targ;          /* target which is updated by the job   */
+    pid_t           pid;
+    int             status;         /* from waitpid                         */
+    time_t          max_time;
+    UINT32          startcount;     /* for the deferred Update() completion */
+    bool            deferred;       /* Update() completion is pending       */
+    UINT8           exStackP;       /* special macro context for .ERROR     */
+    struct exStack  exStack[MAX_EXSTACK];
+    JOBOUT          out[2];         /* stdout and stderr of the job         */
+};
+
+#define JOBS_ACTIVE()   (Glob.jobs > 1 && !jobChild && !Glob.noexec)
+
+STATIC JOB              *jobList;       /* running jobs                     */
+STATIC unsigned         jobCount;       /* number of running jobs           */
+STATIC bool             jobChild;       /* executing in a job process?      */
+#endif
+
 bool    DoingUpdate;
 
 const char *MonthNames[] = {
@@ -107,6 +150,317 @@ void exPop( void )
 }
 
 
+#ifdef __UNIX__
+STATIC void jobRead( JOBOUT *out )
+/*********************************
+ * append available output of a job to its buffer
+ */
+{
+    char        *data;
+    ssize_t     len;
+
+    if( out->size - out->len < 512 ) {
+        out->size = ( out->size == 0 ) ? 1024 : out->size * 2;
+        data = MallocSafe( out->size );
+        if( out->data != NULL ) {
+            memcpy( data, out->data, out->len );
+            FreeSafe( out->data );
+        }
+        out->data = data;
+    }
+    len = read( out->fd, out->data + out->len, out->size - out->len );
+    if( len > 0 ) {
+        out->len += len;
+    } else if( len == 0 || errno != EINTR ) {
+        close( out->fd );
+        out->fd = -1;
+    }
+}
+
+
+STATIC JOB *jobCollect( void )
+/*****************************
+ * read output of the running jobs until one of them terminates,
+ * return the terminated job or NULL if there is no job running
+ */
+{
+    JOB         *job;
+    JOB         **owner;
+    fd_set      fds;
+    int         maxfd;
+    int         i;
+
+    for( ;; ) {
+        for( owner = &jobList; (job = *owner) != NULL; owner = &job->next ) {
+            if( job->out[0].fd == -1 && job->out[1].fd == -1 ) {
+                *owner = job->next;
+                --jobCount;
+                while( waitpid( job->pid, &job->status, 0 ) == -1 ) {
+                    if( errno != EINTR ) {
+                        job->status = -1;
+                        break;
+                    }
+                }
+                return( job );
+            }
+        }
+        if( jobList == NULL ) {
+            return( NULL );
+        }
+        FD_ZERO( &fds );
+        maxfd = -1;
+        for( job = jobList; job != NULL; job = job->next ) {
+            for( i = 0; i < 2; i++ ) {
+                if( job->out[i].fd != -1 ) {
+                    FD_SET( job->out[i].fd, &fds );
+                    if( maxfd < job->out[i].fd ) {
+                        maxfd = job->out[i].fd;
+                    }
+                }
+            }
+        }
+        if( select( maxfd + 1, &fds, NULL, NULL, NULL ) == -1 ) {
+            if( errno == EINTR ) {
+                CheckForBreak();
+                continue;
+            }
+            /* fall back to a blocking read of each output */
+            for( job = jobList; job != NULL; job = job->next ) {
+                for( i = 0; i < 2; i++ ) {
+                    if( job->out[i].fd != -1 ) {
+                        FD_SET( job->out[i].fd, &fds );
+                    }
+                }
+            }
+        }
+        for( job = jobList; job != NULL; job = job->next ) {
+            for( i = 0; i < 2; i++ ) {
+                if( job->out[i].fd != -1 && FD_ISSET( job->out[i].fd, &fds ) ) {
+                    jobRead( &job->out[i] );
+                }
+            }
+        }
+    }
+}
+
+
+STATIC void jobFree( JOB *job )
+/*****************************/
+{
+    int     i;
+
+    for( i = 0; i < job->exStackP; i++ ) {
+        if( job->exStack[i].dep != NULL ) {
+            FreeDepend( job->exStack[i].dep );
+        }
+        if( job->exStack[i].impDep != NULL ) {
+            FreeDepend( job->exStack[i].impDep );
+        }
+    }
+    for( i = 0; i < 2; i++ ) {
+        if( job->out[i].fd != -1 ) {
+            close( job->out[i].fd );
+        }
+        if( job->out[i].data != NULL ) {
+            FreeSafe( job->out[i].data );
+        }
+    }
+    FreeSafe( job );
+}
+
+
+STATIC void jobFinish( JOB *job, bool aborting )
+/***********************************************
+ * write out the output of a terminated job and complete the update of
+ * its target the same way as if the commands were executed by carryOut
+ */
+{
+    TARGET          *targ;
+    struct exStack  save[MAX_EXSTACK];
+    UINT8           saveP;
+    UINT32          startcount;
+    bool            deferred;
+    bool            ok;
+    RET_T           ret;
+
+    assert( job != NULL );
+
+    targ = job->targ;
+    targ->pending = false;
+    if( job->out[0].len > 0 ) {
+        fwrite( job->out[0].data, 1, job->out[0].len, stdout );
+    }
+    fflush( stdout );
+    if( job->out[1].len > 0 ) {
+        fwrite( job->out[1].data, 1, job->out[1].len, stderr );
+    }
+    fflush( stderr );
+    ok = false;
+    if( job->status != -1 ) {
+        if( WIFEXITED( job->status ) ) {
+            ok = ( WEXITSTATUS( job->status ) == EXIT_OK );
+        } else if( WIFSIGNALED( job->status ) ) {
+            if( WTERMSIG( job->status ) > 0 && WTERMSIG( job->status ) <= 15 ) {
+                PrtMsg( INF | (SIG_ERR_0 + WTERMSIG( job->status ) ) );
+            } else {
+                PrtMsg( INF | SIG_ERR_0, WTERMSIG( job->status ) );
+            }
+        }
+    }
+    /* the job may have changed any file */
+    ResetExecuted();
+
+    /* .ERROR commands must see the special macros of the job */
+    memcpy( save, exStack, sizeof( save ) );
+    saveP = exStackP;
+    memcpy( exStack, job->exStack, sizeof( exStack ) );
+    exStackP = job->exStackP;
+    ret = carryOutDone( targ, ok, job->max_time );
+    memcpy( exStack, save, sizeof( exStack ) );
+    exStackP = saveP;
+
+    deferred = job->deferred;
+    startcount = job->startcount;
+    jobFree( job );
+    if( aborting ) {
+        return;
+    }
+    if( ret == RET_ERROR ) {
+        ExitError();
+        // never return
+    }
+    if( ret != RET_SUCCESS ) {
+        targ->error = true;
+        targ->busy = false;
+    } else if( deferred ) {
+        updateDone( targ, startcount );
+    }
+}
+
+
+STATIC void jobWait( TARGET *targ )
+/**********************************
+ * wait until a parallel job updating targ terminates
+ */
+{
+    while( targ->pending ) {
+        jobFinish( jobCollect(), false );
+    }
+}
+
+
+STATIC void jobWaitAll( void )
+/****************************/
+{
+    JOB     *job;
+
+    while( (job = jobCollect()) != NULL ) {
+        jobFinish( job, false );
+    }
+}
+
+
+STATIC void jobDefer( TARGET *targ, UINT32 startcount )
+/******************************************************
+ * the Update() of targ is completed when its job terminates
+ */
+{
+    JOB     *job;
+
+    for( job = jobList; job != NULL; job = job->next ) {
+        if( job->targ == targ ) {
+            job->deferred = true;
+            job->startcount = startcount;
+            break;
+        }
+    }
+}
+
+
+STATIC void jobStart( TARGET *targ, CLIST *clist, time_t max_time )
+/******************************************************************
+ * execute the command list in a forked process, the special macro context
+ * must already be on the exStack
+ */
+{
+    JOB     *job;
+    int     fds[2][2];
+    int     i;
+    pid_t   pid;
+    bool    ok;
+
+    while( jobCount >= Glob.jobs ) {
+        jobFinish( jobCollect(), false );
+    }
+    if( pipe( fds[0] ) == -1 ) {
+        PrtMsg( FTL | UNABLE_TO_EXEC, targ->node.name, strerror( errno ) );
+        ExitFatal();
+        // never return
+    }
+    if( pipe( fds[1] ) == -1 ) {
+        PrtMsg( FTL | UNABLE_TO_EXEC, targ->node.name, strerror( errno ) );
+        ExitFatal();
+        // never return
+    }
+    /* don't let the job inherit buffered output */
+    fflush( NULL );
+    pid = fork();
+    if( pid == -1 ) {
+        PrtMsg( FTL | UNABLE_TO_EXEC, targ->node.name, strerror( errno ) );
+        ExitFatal();
+        // never return
+    }
+    if( pid == 0 ) {
+        /*
+         * child process
+         */
+        jobChild = true;
+        for( job = jobList; job != NULL; job = job->next ) {
+            for( i = 0; i < 2; i++ ) {
+                if( job->out[i].fd != -1 ) {
+                    close( job->out[i].fd );
+                }
+            }
+        }
+        jobList = NULL;
+        jobCount = 0;
+        close( fds[0][0] );
+        close( fds[1][0] );
+        dup2( fds[0][1], STDOUT_FILENO );
+        dup2( fds[1][1], STDERR_FILENO );
+        close( fds[0][1] );
+        close( fds[1][1] );
+        ExecJobInit();
+        ok = ExecCList( clist );
+        ExecJobFini();
+        fflush( NULL );
+        _exit( ok ? EXIT_OK : EXIT_ERROR );
+        // never return
+    }
+    job = CallocSafe( sizeof( *job ) );
+    job->targ = targ;
+    job->pid = pid;
+    job->max_time = max_time;
+    for( i = 0; i < 2; i++ ) {
+        close( fds[i][1] );
+        fcntl( fds[i][0], F_SETFD, FD_CLOEXEC );
+        job->out[i].fd = fds[i][0];
+    }
+    /* dependents lists may be freed before the job terminates */
+    job->exStackP = exStackP;
+    for( i = 0; i < exStackP; i++ ) {
+        job->exStack[i].targ = exStack[i].targ;
+        job->exStack[i].dep = DupDepend( exStack[i].dep );
+        job->exStack[i].impDep = DupDepend( exStack[i].impDep );
+    }
+    job->next = jobList;
+    jobList = job;
+    ++jobCount;
+    targ->pending = true;
+}
+#endif
+
+
 STATIC signed int dateCmp( time_t targ, time_t dep )
 /**************************************************/
 {
@@ -123,6 +477,9 @@ STATIC signed int dateCmp( time_t targ, time_t dep )
 STATIC void getStats( TARGET *targ )
 /**********************************/
 {
+#ifdef __UNIX__
+    jobWait( targ );
+#endif
     if( targ->executed ) {
         targ->executed = false;
         if( targ->touched ) {       /* used with symbolic, -t, -n, -q */
@@ -200,18 +557,19 @@ STATIC void getDate( TARGET *targ )
 #ifdef __WATCOMC__
 #pragma on (check_stack);
 #endif
-STATIC RET_T carryOut( TARGET *targ, CLIST *clist, time_t max_time )
-/******************************************************************/
+STATIC RET_T carryOutDone( TARGET *targ, bool ok, time_t max_time )
+/******************************************************************
+ * process the result of the command list executed for targ
+ */
 {
     CLIST               *err;
     int                 i;
     struct utimbuf      times;
     char                msg[max( MAX_RESOURCE_SIZE, _MAX_PATH )];
 
-    assert( targ != NULL && clist != NULL );
+    assert( targ != NULL );
 
-    ++cListCount;
-    if( ExecCList( clist ) ) {
+    if( ok ) {
         if( Glob.rcs_make && !Glob.noexec && !Glob.touch ) {
             if( max_time != OLDEST_DATE ) {
                 targ->date = max_time;
@@ -278,6 +636,16 @@ STATIC RET_T carryOut( TARGET *targ, CLIST *clist, time_t max_time )
 #endif
 
 
+STATIC RET_T carryOut( TARGET *targ, CLIST *clist, time_t max_time )
+/******************************************************************/
+{
+    assert( targ != NULL && clist != NULL );
+
+    ++cListCount;
+    return( carryOutDone( targ, ExecCList( clist ), max_time ) );
+}
+
+
 STATIC time_t maxDepTime( time_t max_time, DEPEND *dep )
 /******************************************************/
 {
@@ -387,6 +755,15 @@ STATIC RET_T perform( TARGET *targ, DEPEND *dep, DEPEND *impldep, time_t max_tim
         doneBefore = true;
     }
     exPush( targ, depend, impliedDepend );
+#ifdef __UNIX__
+    if( JOBS_ACTIVE() ) {
+        /* the result is processed when the job terminates */
+        ++cListCount;
+        jobStart( targ, clist, findMaxTime( targ, dep, max_time ) );
+        exPop();
+        return( RET_SUCCESS );
+    }
+#endif
     ret = carryOut( targ, clist, findMaxTime( targ, dep, max_time ) );
     exPop();
     if( ret == RET_ERROR ) {
@@ -402,10 +779,11 @@ bool MakeList( TLIST *tlist )
 {
     bool    ok;
     TARGET  *targ;
+    TLIST   *tl;
 
     ok = true;
-    for( ; tlist != NULL; tlist = tlist->next ) {
-        targ = tlist->target;
+    for( tl = tlist; tl != NULL; tl = tl->next ) {
+        targ = tl->target;
         if( !targ->mentioned ) {
             PrtMsg( WRN | TARGET_NOT_MENTIONED, targ->node.name );
             targ->mentioned = true;
@@ -414,6 +792,16 @@ bool MakeList( TLIST *tlist )
             ok = false;
         }
     }
+#ifdef __UNIX__
+    /* the list is updated when all its parallel jobs terminated */
+    for( ; tlist != NULL; tlist = tlist->next ) {
+        targ = tlist->target;
+        jobWait( targ );
+        if( targ->error ) {
+            ok = false;
+        }
+    }
+#endif
     return( ok );
 }
 
@@ -706,9 +1094,10 @@ STATIC RET_T imply( TARGET *targ, const char *drive, const char *dir,
         if( targExists( imptarg ) ) {
             /* it exists - now we perform the implicit cmd list, and return */
             ret = implyMaybePerform( targ, imptarg, slist->cretarg, must );
-            if( newtarg && !Glob.noexec ) {
+            if( newtarg && !Glob.noexec && !targ->pending ) {
                 /* destroy the implied target, because the info in the target
                  * structure is nicely stored on disk (unless Glob.noexec)
+                 * the running job of targ still refers to it
                  */
                 KillTarget( imptarg->node.name );
             }
@@ -882,10 +1271,12 @@ bool Update( TARGET *targ )
 {
     DEPEND      *curdep;
     UINT32      startcount;
-    bool        target_exists;
     RET_T       ret;
 
     CheckForBreak();
+#ifdef __UNIX__
+    jobWait( targ );
+#endif
     if( targ->error ) {
         return( false );
     }
@@ -947,6 +1338,29 @@ bool Update( TARGET *targ )
         }
     }
 
+#ifdef __UNIX__
+    if( targ->pending ) {
+        /* finish the update when the job terminates */
+        jobDefer( targ, startcount );
+        return( true );
+    }
+    if( targ->error ) {
+        /* the job of targ terminated already and failed */
+        targ->busy = false;
+        return( false );
+    }
+#endif
+    return( updateDone( targ, startcount ) );
+}
+
+
+STATIC bool updateDone( TARGET *targ, UINT32 startcount )
+/********************************************************
+ * check the result of updating targ
+ */
+{
+    bool        target_exists;
+
     if( (targ->attr.symbolic || Glob.noexec || Glob.query) && startcount != cListCount ) {
         targ->existing = true;
         targ->touched = true;
@@ -1154,6 +1568,9 @@ void UpdateFini( void )
 {
     CLIST   *after;
 
+#ifdef __UNIX__
+    jobWaitAll();
+#endif
     assert( exStackP == 0 );
 
     after = DotCList( DOT_AFTER );
@@ -1165,3 +1582,18 @@ void UpdateFini( void )
     }
     DoingUpdate = false;
 }
+
+
+void UpdateWaitJobs( void )
+/*************************
+ * wait for the running parallel jobs before wmake terminates
+ */
+{
+#ifdef __UNIX__
+    JOB     *job;
+
+    while( (job = jobCollect()) != NULL ) {
+        jobFinish( job, true );
+    }
+#endif
+}
@@ -70,6 +70,7 @@
 
 struct Glob {
     char        swchar;                 /* the 'switch' character (ie: '-' or '/' )      */
+    UINT16      jobs;                   /* maximum number of parallel command lists      */
 
     boolbit     all             : 1;    /* make all targets                              */
     boolbit     block           : 1;    /* block the use of implicit rules               */
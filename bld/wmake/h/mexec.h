@@ -40,5 +40,9 @@ extern bool     ExecCList( CLIST *clist );
 extern INT32    ExecCommand( char *line );
 extern void     ExecInit( void );
 extern void     ExecFini( void );
+#ifdef __UNIX__
+extern void     ExecJobInit( void );
+extern void     ExecJobFini( void );
+#endif
 
 #endif
@@ -105,6 +105,7 @@ struct Target {
     boolbit     allow_nocmd : 1;    /* allow no command list to update */
     boolbit     cmds_done   : 1;    /* command list was executed to update it */
     boolbit     sufsuf      : 1;    /* is this an implicit rule             */
+    boolbit     pending     : 1;    /* cmds are running as a parallel job   */
 
 };
 
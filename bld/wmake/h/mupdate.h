@@ -40,6 +40,7 @@ extern bool         DoingUpdate;
 
 extern void         UpdateInit( void );
 extern void         UpdateFini( void );
+extern void         UpdateWaitJobs( void );
 extern bool         Update( TARGET *targ );
 extern bool         MakeList( TLIST *list );
 
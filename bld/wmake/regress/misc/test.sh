@@ -69,6 +69,12 @@ $1 -a -c -h -f misc${TEST}u > test$TEST.lst 2>&1
 diff -b misc${TEST}u.chk test$TEST.lst
 do_check
 
+TEST=08
+print_header
+$1 -a -c -h -g 3 -f misc$TEST 2>&1 | LC_ALL=C sort > test$TEST.lst
+diff -b misc$TEST.chk test$TEST.lst
+do_check
+
 if [ "$ERRORS" -eq "0" ]; then
     rm -f *.lst
 fi
@@ -38,11 +38,20 @@
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
+#include <dirent.h>
 #include <sys/types.h>
 #include <sys/time.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
 #include <sys/ptrace.h>
 #include <sys/wait.h>
+#ifdef __WATCOMC__
+#include <sys/perfevt.h>
+#else
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
 #include "madconf.h"
 #include "sample.h"
 #include "wmsg.h"
@@ -61,6 +70,29 @@
 
 #define BUFF_SIZE   2048
 
+#define PERF_RING_PAGES     64      // data pages per ring buffer, power of 2
+#define PERF_DRAIN_USEC     10000   // how often the ring buffers are emptied
+#define PERF_MAX_STACK      64      // deepest call chain kept per sample
+#define PERF_RECORD_MAX     0x10000 // perf_event_header.size is 16-bit
+
+#ifndef __WATCOMC__
+#define perf_event_open( attr, pid, cpu, group_fd, flags ) \
+    syscall( SYS_perf_event_open, attr, pid, cpu, group_fd, flags )
+#endif
+
+#if defined( __GNUC__ )
+    #define PERF_BARRIER()  __sync_synchronize()
+#elif defined( _M_IX86 )
+    extern void PerfBarrier( void );
+    #pragma aux PerfBarrier = \
+            "lock or dword ptr [esp],0" \
+        __parm      [] \
+        __modify    __exact []
+    #define PERF_BARRIER()  PerfBarrier()
+#else
+    #error PERF_BARRIER() not defined for this target
+#endif
+
 typedef struct lli {
     addr_off    offset;
     addr_off    dbg_dyn_sect;
@@ -70,13 +102,28 @@ typedef struct lli {
     char        filename[257]; // TODO: This should really be dynamic!
 } lib_load_info;
 
+/* one perf event ring buffer per CPU, shared by all events on that CPU */
+typedef struct perf_ring {
+    int                                     fd;
+    long                                    cpu;
+    volatile struct perf_event_mmap_page    *page;
+    unsigned char                           *data;
+} perf_ring;
+
+/* kernel thread id and last call chain of a sampled thread */
+typedef struct perf_thread {
+    pid_t       tid;
+    unsigned    depth;
+    off         chain[PERF_MAX_STACK];
+} perf_thread;
+
 #ifndef __WATCOMC__
 extern char             **environ;
 #endif
 
 static void             CodeLoad( const char *name, u_long addr, samp_block_kinds kind );
 
-static unsigned         SleepTime;
+static unsigned long    SampleRate;     // microseconds between samples
 static unsigned         *SampleIndexP;
 static unsigned         *SampleCountP;
 static samp_block       **SamplesP;
@@ -99,6 +146,16 @@ static far_address      CommonAddr;
 static lib_load_info    *ModuleInfo;
 static int              ModuleTop;
 
+static bool             UsePerf;        // samples come from perf_event rings
+static perf_ring        *PerfRings;
+static unsigned         PerfRingCount;
+static int              *PerfFds;       // events writing into another ring
+static unsigned         PerfFdCount;
+static unsigned long    PerfDataSize;   // bytes of data in each ring
+static perf_thread      *PerfThreads;   // index + 1 is the sample thread id
+static unsigned         PerfThreadCount;
+static uint_64          PerfRecord[PERF_RECORD_MAX / sizeof( uint_64 )];
+
 
 /*
  * The following routines that keep track of loaded shared libraries were
@@ -292,19 +349,25 @@ static void SetPid( const char **cmd )
 
 void InitTimerRate( void )
 {
-    SleepTime = 10;     // default to 10 milliseconds
+    SampleRate = 10000;     // default to 10 milliseconds
 }
 
 
 void SetTimerRate( const char **cmd )
 {
-    SleepTime = GetNumber( 1, 1000, cmd, 10 );
+    SampleRate = 1000UL * GetNumber( 1, 1000, cmd, 10 );
+}
+
+
+static void SetTimerRateMicro( const char **cmd )
+{
+    SampleRate = GetNumber( 50, 1000000, cmd, 10 );
 }
 
 
 unsigned long TimerRate( void )
 {
-    return( 1000UL * SleepTime );
+    return( SampleRate );
 }
 
 
@@ -577,6 +640,324 @@ static bool ProcessBreakpoint( pid_t pid, u_long ip )
 }
 
 
+/*
+ * The perf_event sampler. The kernel samples the instruction pointer (and
+ * optionally the user mode call chain) of every thread of the profiled
+ * program into ring buffers mapped into our address space, so the program
+ * is never stopped to take a sample. The buffers are emptied into the
+ * usual sample blocks whenever the drain timer interrupts waitpid().
+ */
+
+/* Map a kernel thread id to a sample thread id (1 is the main thread) */
+static unsigned PerfThreadId( pid_t tid )
+{
+    static unsigned last = 0;
+    unsigned        i;
+
+    if( last < PerfThreadCount && PerfThreads[last].tid == tid )
+        return( last + 1 );
+    for( i = 0; i < PerfThreadCount; ++i ) {
+        if( PerfThreads[i].tid == tid ) {
+            last = i;
+            return( i + 1 );
+        }
+    }
+    PerfThreads = realloc( PerfThreads, ( PerfThreadCount + 1 ) * sizeof( perf_thread ) );
+    PerfThreads[PerfThreadCount].tid = tid;
+    PerfThreads[PerfThreadCount].depth = 0;
+    last = PerfThreadCount++;
+    return( PerfThreadCount );
+}
+
+
+/*
+ * Record a sample with its call chain. The chain is stored the same way
+ * RecordCGraph does it: the sample is followed by a push/pop entry and
+ * the pushed return addresses, relative to the previous chain of the
+ * same thread.
+ */
+static void RecordChainSample( off ip, unsigned tid, off *chain, unsigned depth )
+{
+    perf_thread *thread;
+    unsigned    common;
+    unsigned    push;
+    unsigned    pop;
+    unsigned    i;
+
+    thread = PerfThreads + tid - 1;
+    for( common = 0; common < depth && common < thread->depth; ++common ) {
+        if( chain[depth - common - 1] != thread->chain[thread->depth - common - 1] ) {
+            break;
+        }
+    }
+    pop = thread->depth - common;
+    push = depth - common;
+
+    if( tid > MaxThread ) {
+        GrowArrays( tid );
+    }
+    --tid;
+    if( SampleIndexP[tid] + 2 + push > Ceiling ) {
+        StopAndSave();
+    }
+    if( SampleIndexP[tid] == 0 ) {
+        SamplesP[tid]->pref.tick = CurrTick;
+        CallGraphP[tid]->pref.tick = CurrTick;
+    }
+    ++CurrTick;
+    SamplesP[tid]->d.sample.sample[SampleIndexP[tid]].offset = ip;
+    SamplesP[tid]->d.sample.sample[SampleIndexP[tid]].segment = FlatSeg;
+    SampleIndexP[tid]++;
+    SamplesP[tid]->d.sample.sample[SampleIndexP[tid]].offset = ( (off)push << 16 ) + pop;
+    SamplesP[tid]->d.sample.sample[SampleIndexP[tid]].segment = 0;
+    SampleIndexP[tid]++;
+    for( i = 0; i < push; ++i ) {
+        SamplesP[tid]->d.sample.sample[SampleIndexP[tid]].offset = chain[i];
+        SamplesP[tid]->d.sample.sample[SampleIndexP[tid]].segment = FlatSeg;
+        SampleIndexP[tid]++;
+    }
+    SampleCountP[tid]++;
+    memcpy( thread->chain, chain, depth * sizeof( off ) );
+    thread->depth = depth;
+    if( SampleIndexP[tid] >= Margin ) {
+        StopAndSave();
+    }
+}
+
+
+/* Decode one PERF_RECORD_SAMPLE (IP, TID and optional CALLCHAIN) */
+static void PerfSample( const uint_64 *rec )
+{
+    off         chain[PERF_MAX_STACK];
+    unsigned    depth;
+    uint_64     context;
+    uint_64     nr;
+    off         ip;
+    pid_t       tid;
+    bool        leaf;
+
+    ip = (off)rec[0];
+    tid = ((const uint_32 *)( rec + 1 ))[1];
+    if( !CallGraphMode ) {
+        RecordSample( ip, PerfThreadId( tid ) );
+        return;
+    }
+    /*
+     * keep the user mode return addresses only; the first user mode
+     * entry is the sampled ip itself
+     */
+    depth = 0;
+    leaf = true;
+    context = PERF_CONTEXT_USER;
+    rec += 2;
+    for( nr = *rec++; nr > 0; --nr, ++rec ) {
+        if( *rec >= PERF_CONTEXT_MAX ) {
+            context = *rec;
+        } else if( context == PERF_CONTEXT_USER ) {
+            if( leaf ) {
+                leaf = false;
+            } else if( depth < PERF_MAX_STACK ) {
+                chain[depth++] = (off)*rec;
+            }
+        }
+    }
+    RecordChainSample( ip, PerfThreadId( tid ), chain, depth );
+}
+
+
+/* Empty all ring buffers into the sample blocks */
+static void PerfDrain( void )
+{
+    perf_ring                   *ring;
+    struct perf_event_header    *hdr;
+    unsigned long               head;
+    unsigned long               tail;
+    unsigned long               pos;
+    unsigned long               len;
+    unsigned                    i;
+
+    for( i = 0; i < PerfRingCount; ++i ) {
+        ring = PerfRings + i;
+        head = (unsigned long)ring->page->data_head;
+        PERF_BARRIER();
+        tail = (unsigned long)ring->page->data_tail;
+        while( tail != head ) {
+            pos = tail & ( PerfDataSize - 1 );
+            hdr = (struct perf_event_header *)( ring->data + pos );
+            if( pos + hdr->size > PerfDataSize ) {
+                /* record wraps around the end of the buffer */
+                len = PerfDataSize - pos;
+                memcpy( PerfRecord, ring->data + pos, len );
+                memcpy( (char *)PerfRecord + len, ring->data, hdr->size - len );
+                hdr = (struct perf_event_header *)PerfRecord;
+            }
+            switch( hdr->type ) {
+            case PERF_RECORD_SAMPLE:
+                PerfSample( (const uint_64 *)( hdr + 1 ) );
+                break;
+            case PERF_RECORD_LOST:
+                LostData = true;
+                break;
+            }
+            tail += hdr->size;
+        }
+        PERF_BARRIER();
+        ring->page->data_tail = tail;
+    }
+}
+
+
+/* Find the ring buffer of a CPU */
+static perf_ring *PerfFindRing( long cpu )
+{
+    unsigned    i;
+
+    for( i = 0; i < PerfRingCount; ++i ) {
+        if( PerfRings[i].cpu == cpu ) {
+            return( PerfRings + i );
+        }
+    }
+    return( NULL );
+}
+
+
+/*
+ * Open one sampling event per CPU for the given thread. The first event
+ * on a CPU gets a ring buffer mapped, any later one (the other threads of
+ * an attached process) is redirected into that ring, so the number of
+ * buffers to map and drain does not grow with the number of threads.
+ * Returns false if an event was opened but could not be given a buffer;
+ * *opened is set if at least one event is recording.
+ */
+static bool PerfOpenTask( pid_t tid, bool *opened )
+{
+    struct perf_event_attr  attr;
+    perf_ring               *ring;
+    void                    *map;
+    long                    page_size;
+    long                    cpus;
+    long                    cpu;
+    int                     fd;
+
+    memset( &attr, 0, sizeof( attr ) );
+    attr.size = sizeof( attr );
+    attr.type = PERF_TYPE_SOFTWARE;
+    attr.config = PERF_COUNT_SW_CPU_CLOCK;
+    attr.sample_period = 1000ULL * SampleRate;  // nanoseconds
+    attr.sample_type = PERF_SAMPLE_IP | PERF_SAMPLE_TID;
+    if( CallGraphMode )
+        attr.sample_type |= PERF_SAMPLE_CALLCHAIN;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    page_size = sysconf( _SC_PAGESIZE );
+    PerfDataSize = PERF_RING_PAGES * page_size;
+    cpus = sysconf( _SC_NPROCESSORS_CONF );
+    for( cpu = 0; cpu < cpus; ++cpu ) {
+        /* offline CPUs just fail to open */
+        fd = perf_event_open( &attr, tid, cpu, -1, 0 );
+        if( fd < 0 )
+            continue;
+        ring = PerfFindRing( cpu );
+        if( ring != NULL ) {
+            if( ioctl( fd, PERF_EVENT_IOC_SET_OUTPUT, ring->fd ) != 0 ) {
+                close( fd );
+                return( false );
+            }
+            PerfFds = realloc( PerfFds, ( PerfFdCount + 1 ) * sizeof( int ) );
+            PerfFds[PerfFdCount++] = fd;
+        } else {
+            map = mmap( NULL, page_size + PerfDataSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+            if( map == MAP_FAILED ) {
+                /* usually the perf_event_mlock_kb limit */
+                close( fd );
+                return( false );
+            }
+            PerfRings = realloc( PerfRings, ( PerfRingCount + 1 ) * sizeof( perf_ring ) );
+            ring = PerfRings + PerfRingCount++;
+            ring->fd = fd;
+            ring->cpu = cpu;
+            ring->page = map;
+            ring->data = (unsigned char *)map + page_size;
+        }
+        *opened = true;
+    }
+    return( true );
+}
+
+
+/*
+ * Start perf_event sampling of a process. A started program is sampled
+ * with inherited events that follow all threads it creates; the threads
+ * of an attached process already exist and need events of their own.
+ * If a buffer cannot be set up the samples of some CPUs would silently
+ * be missing, so the caller falls back to the ptrace sampler instead.
+ */
+static bool PerfOpen( pid_t pid )
+{
+    char            procdir[32];
+    DIR             *dirp;
+    struct dirent   *dire;
+    pid_t           tid;
+    bool            opened;
+    bool            ok;
+
+    PerfRingCount = 0;
+    PerfFdCount = 0;
+    PerfThreadCount = 0;
+    PerfThreadId( pid );
+    opened = false;
+    dirp = NULL;
+    if( Attached ) {
+        sprintf( procdir, "/proc/%d/task", pid );
+        dirp = opendir( procdir );
+    }
+    if( dirp == NULL ) {
+        ok = PerfOpenTask( pid, &opened );
+    } else {
+        ok = true;
+        while( ok && (dire = readdir( dirp )) != NULL ) {
+            tid = atoi( dire->d_name );
+            if( tid > 0 ) {
+                ok = PerfOpenTask( tid, &opened );
+            }
+        }
+        closedir( dirp );
+    }
+    if( !ok ) {
+        OutputMsgNL( MSG_SAMPLE_7 );
+        return( false );
+    }
+    return( opened );
+}
+
+
+static void PerfClose( void )
+{
+    long        page_size;
+    unsigned    i;
+
+    page_size = sysconf( _SC_PAGESIZE );
+    for( i = 0; i < PerfFdCount; ++i ) {
+        close( PerfFds[i] );
+    }
+    free( PerfFds );
+    PerfFds = NULL;
+    PerfFdCount = 0;
+    for( i = 0; i < PerfRingCount; ++i ) {
+        munmap( (void *)PerfRings[i].page, page_size + PerfDataSize );
+        close( PerfRings[i].fd );
+    }
+    free( PerfRings );
+    PerfRings = NULL;
+    PerfRingCount = 0;
+    free( PerfThreads );
+    PerfThreads = NULL;
+    PerfThreadCount = 0;
+}
+
+
 /*
  * Real time signal (SIGALRM) handler. All we really need to do is wake up
  * periodically to interrupt waitpid(), the signal handler need not do much
@@ -591,7 +972,7 @@ static void alarm_handler( int signo )
 
 
 /* Install periodic real time alarm signal */
-static void InstSigHandler( int msec_period )
+static void InstSigHandler( unsigned long usec_period )
 {
     struct sigaction    sigalrm;
     struct itimerval    timer;
@@ -602,10 +983,9 @@ static void InstSigHandler( int msec_period )
 
     sigaction( SIGALRM, &sigalrm, NULL );
 
-    timer.it_interval.tv_sec = 0;
-    timer.it_interval.tv_usec = msec_period * 1000;
-    timer.it_value.tv_sec = 0;
-    timer.it_value.tv_usec = msec_period * 1000;
+    timer.it_interval.tv_sec = usec_period / 1000000;
+    timer.it_interval.tv_usec = usec_period % 1000000;
+    timer.it_value = timer.it_interval;
 
     if( setitimer( ITIMER_REAL, &timer, NULL ) ) {
         internalErrorMsg( MSG_SAMPLE_6 );
@@ -621,6 +1001,8 @@ static void InstSigHandler( int msec_period )
  * remember the current execution point and continue the profiled app. Note
  * that we may miss some ticks but this is not a problem - the ticks don't
  * even need to be regular to provide usable results.
+ * When the samples come from perf_event ring buffers the application is left
+ * running and SIGALRM only tells us to empty the buffers.
  */
 static void SampleLoop( pid_t pid )
 {
@@ -633,7 +1015,7 @@ static void SampleLoop( pid_t pid )
     opcode_type         brk_opcode = BRKPOINT;
 
     TimerTicked = false;
-    InstSigHandler( SleepTime );
+    InstSigHandler( UsePerf ? PERF_DRAIN_USEC : SampleRate );
 
     do {
         if( do_cont && ptrace( PTRACE_CONT, pid, NULL, (void *)ptrace_sig ) == -1)
@@ -643,8 +1025,12 @@ static void SampleLoop( pid_t pid )
             /* did we get woken up by SIGALRM? */
             if( TimerTicked ) {
                 TimerTicked = false;
-                /* interrupt child process - next waitpid() will see this */
-                kill( pid, SIGSTOP );
+                if( UsePerf ) {
+                    PerfDrain();
+                } else {
+                    /* interrupt child process - next waitpid() will see this */
+                    kill( pid, SIGSTOP );
+                }
             } else {
                 dbg_printf( "who the hell interrupted waitpid()?\n" );
             }
@@ -654,6 +1040,10 @@ static void SampleLoop( pid_t pid )
         if( ret < 0 )
             perror( "waitpid()" );
         do_cont = true;
+        if( UsePerf ) {
+            /* keep samples ahead of library load/unload records */
+            PerfDrain();
+        }
 
         /* record current execution point */
 #if MADARCH & MADARCH_X86
@@ -709,7 +1099,8 @@ static void SampleLoop( pid_t pid )
                 break;
             case SIGSTOP:
                 /* presumably we were behind this SIGSTOP */
-                RecordSample( regs.eip, 1 );
+                if( !UsePerf )
+                    RecordSample( regs.eip, 1 );
                 ptrace_sig = 0;
                 sample_continue = true;
                 break;
@@ -846,7 +1237,11 @@ void StartProg( const char *cmd, const char *prog, const char *full_args, char *
          */
         InitLibMap();
         CodeLoad( exe_name, 0, SAMP_MAIN_LOAD );
+        UsePerf = PerfOpen( pid );
+        if( !UsePerf )
+            PerfClose();
         SampleLoop( pid );
+        PerfClose();
         FiniLibMap();
     }
     return;
@@ -876,6 +1271,9 @@ void SysParseOptions( char c, const char **cmd )
     case 'r':
         SetTimerRate( cmd );
         break;
+    case 'u':
+        SetTimerRateMicro( cmd );
+        break;
     case 'p':
         SetPid( cmd );
         break;
@@ -162,6 +162,12 @@
 :usage.  start the program in a new session
 :jusage. 新しいセッションでのプログラムの開始
 
+:option. u
+:target. linux
+:id.     . <usec>
+:usage.  specify the sampling interval in microseconds
+:jusage. サンプリング間隔 (単位:マイクロ秒)
+
 :footer.  ..
 :jfooter. ..
 :target.  any
@@ -197,6 +203,13 @@
 :jfooter. .           指定する数値 (範囲:1 から 1000まで) です (ﾃﾞﾌｫﾙﾄ: 10)
 :target.  linux
 
+:footer.  .   <usec>  is a number (range 50 to 1000000) specifying the time
+:jfooter. .   <usec>  はサンプリング間の時間間隔 (単位:マイクロ秒) を
+:target.  linux
+:footer.  .           interval (in microseconds) between samples, used instead of -r
+:jfooter. .           指定する数値 (範囲:50 から 1000000まで) です. -r の代りに使います
+:target.  linux
+
 :footer.  .   <intr>  is a hex (base 16) number (range 20 to ff) specifying
 :jfooter. .   <intr>  は16進数(範囲:20からffまで)で、以下の特別な方法で処理する
 :target.  dos
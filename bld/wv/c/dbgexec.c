@@ -55,6 +55,7 @@
 #include "dbgmisc.h"
 #include "remthrd.h"
 #include "remasync.h"
+#include "rembatch.h"
 #include "dbgreg.h"
 #include "dbgevent.h"
 #include "dlgscan.h"
@@ -89,6 +90,7 @@ static void SetThreadStates( void )
 {
     thread_state        *thd;
 
+    RemoteBatchStart();
     for( thd = HeadThd; thd != NULL; thd = thd->link ) {
         if( thd->tid == DbgRegs->tid ) {
             RemoteThawThread( thd->tid );
@@ -105,6 +107,7 @@ static void SetThreadStates( void )
             }
         }
     }
+    RemoteBatchFlush();
 }
 
 static void AddMessageText( char *str )
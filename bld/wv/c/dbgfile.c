@@ -220,6 +220,29 @@ unsigned long SeekStream( file_handle fh, long p, seek_method m )
     }
 }
 
+#if !defined( BUILD_RFX )
+void *FileMapView( file_handle fh, unsigned long offset, unsigned long size )
+{
+#if defined( __NT__ ) || defined( __LINUX__ )
+    if( !ISREMOTE( fh ) ) {
+        return( LocalMapView( SYSHANDLE( fh ), offset, size ) );
+    }
+#else
+    /* unused parameters */ (void)fh; (void)offset; (void)size;
+#endif
+    return( NULL );
+}
+
+void FileUnmapView( void *view, unsigned long size )
+{
+#if defined( __NT__ ) || defined( __LINUX__ )
+    LocalUnmapView( view, size );
+#else
+    /* unused parameters */ (void)view; (void)size;
+#endif
+}
+#endif
+
 file_handle FileOpen( const char *name, obj_attrs oattrs )
 {
     sys_handle  sh;
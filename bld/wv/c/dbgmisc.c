@@ -765,7 +765,6 @@ static void RefreshRunThreads( bool set_exec )
 
     for( tid = 0; (tid = RemoteGetNextRunThread( tid )) != 0; ) {
         thd = AddThread( tid, 0 );
-        RemoteUpdateRunThread( thd );
         if( set_exec && thd != NULL && thd->tid == DbgRegs->tid ) {
             ExecThd = thd;
         }
@@ -783,6 +782,9 @@ void CheckForNewThreads( bool set_exec )
         RefreshThreads( set_exec );
     }
     KillDeadThreads();
+    if( HaveRemoteRunThread() ) {
+        RemoteUpdateRunThreads( HeadThd );
+    }
     _SwitchOff( SW_THREAD_EXTRA_CHANGED );
 }
 
@@ -307,15 +307,11 @@ a_window WndRunTrdOpen( void )
 
 void RunThreadNotify( void )
 {
-    thread_state    *thd;
-
     if( HeadThd != NULL && HaveRemoteRunThread() ) {
         RemotePollRunThread();
 
         if( RunThreadWnd ) {
-            for( thd = HeadThd; thd != NULL; thd = thd->link ) {
-                RemoteUpdateRunThread( thd );
-            }
+            RemoteUpdateRunThreads( HeadThd );
             WndSetRepaint( RunThreadWnd );
         }
     }
@@ -42,6 +42,7 @@
 #include "dbgmem.h"
 #include "dbgio.h"
 #include "dipimp.h"
+#include "posixfp.h"
 #include "mad.h"
 #include "strutil.h"
 #include "dbgloc.h"
@@ -239,6 +240,16 @@ dig_arch DIPCLIENTRY( CurrArch )( void )
     return( SysConfig.arch );
 }
 
+void *DIPCLIENTRY( MapView )( FILE *fp, unsigned long offset, unsigned long size )
+{
+    return( FileMapView( FP2POSIX( fp ), offset, size ) );
+}
+
+void DIPCLIENTRY( UnmapView )( void *view, unsigned long size )
+{
+    FileUnmapView( view, size );
+}
+
 /*
  * Dealiasing cover routines
  */
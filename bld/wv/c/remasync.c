@@ -76,6 +76,7 @@ unsigned MakeAsyncRun( bool single )
     if( SuppAsyncId == 0 )
         return( 0 );
 
+    ClearMemCache();
     acc.supp.core_req = REQ_PERFORM_SUPPLEMENTARY_SERVICE;
     acc.supp.id = SuppAsyncId;
 
@@ -123,6 +124,7 @@ unsigned PollAsync( void )
     if( SuppAsyncId == 0 )
         return( 0 );
 
+    ClearMemCache();
     acc.supp.core_req = REQ_PERFORM_SUPPLEMENTARY_SERVICE;
     acc.supp.id = SuppAsyncId;
 
@@ -167,6 +169,7 @@ unsigned StopAsync( void )
     if( SuppAsyncId == 0 )
         return( 0 );
 
+    ClearMemCache();
     acc.supp.core_req = REQ_PERFORM_SUPPLEMENTARY_SERVICE;
     acc.supp.id = SuppAsyncId;
 
@@ -209,6 +212,7 @@ bool AsyncAddBreak( address addr, bool local )
     if( SuppAsyncId == 0 )
         return( false );
 
+    ClearMemCache();
     AddrFix( &addr );
     acc.break_addr = addr.mach;
     CONV_LE_32( acc.break_addr.offset );
@@ -231,6 +235,7 @@ void AsyncRemoveBreak( address addr, bool local )
     if( SuppAsyncId == 0 )
         return;
 
+    ClearMemCache();
     AddrFix( &addr );
     acc.break_addr = addr.mach;
     CONV_LE_32( acc.break_addr.offset );
@@ -0,0 +1,211 @@
+/****************************************************************************
+*
+*                            Open Watcom Project
+*
+* Copyright (c) 2026 The Open Watcom Contributors. All Rights Reserved.
+*
+*  ========================================================================
+*
+*    This file contains Original Code and/or Modifications of Original
+*    Code as defined in and that are subject to the Sybase Open Watcom
+*    Public License version 1.0 (the 'License'). You may not use this file
+*    except in compliance with the License. BY USING THIS FILE YOU AGREE TO
+*    ALL TERMS AND CONDITIONS OF THE LICENSE. A copy of the License is
+*    provided with the Original Code and Modifications, and is also
+*    available at www.sybase.com/developer/opensource.
+*
+*    The Original Code and all software distributed under the License are
+*    distributed on an 'AS IS' basis, WITHOUT WARRANTY OF ANY KIND, EITHER
+*    EXPRESS OR IMPLIED, AND SYBASE AND ALL CONTRIBUTORS HEREBY DISCLAIM
+*    ALL SUCH WARRANTIES, INCLUDING WITHOUT LIMITATION, ANY WARRANTIES OF
+*    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, QUIET ENJOYMENT OR
+*    NON-INFRINGEMENT. Please see the License for the specific language
+*    governing rights and limitations under the License.
+*
+*  ========================================================================
+*
+* Description:  Remote batched requests access.
+*
+****************************************************************************/
+
+
+#include <string.h>
+#include "dbgdefn.h"
+#include "dbgdata.h"
+#include "dbgmem.h"
+#include "trpcore.h"
+#include "trpbatch.h"
+#include "trapglbl.h"
+#include "trpld.h"
+#include "rembatch.h"
+
+
+#define MAX_BATCH_COUNT     32
+
+#define SUPP_BATCH_SERVICE( in, request )       \
+        in.supp.core_req        = REQ_PERFORM_SUPPLEMENTARY_SERVICE;    \
+        in.supp.id              = SuppBatchId;  \
+        in.req                  = request;
+
+typedef struct {
+    trap_elen       in_len;
+    trap_elen       out_len;
+    out_data_p      out_data;
+} batch_info;
+
+extern trap_elen        MaxPacketLen;
+
+static trap_shandle     SuppBatchId = 0;
+
+static bool             Batching = false;
+static unsigned         BatchCount;
+static trap_elen        BatchInLen;     /* size of the queued requests */
+static trap_elen        BatchOutLen;    /* size of the expected replies */
+static char             *BatchBuff = NULL;
+static batch_info       BatchInfo[MAX_BATCH_COUNT];
+
+bool InitBatchSupp( void )
+{
+    FiniBatchSupp();
+    SuppBatchId = GETSUPPID( BATCH_SUPP_NAME );
+    if( SuppBatchId != 0 ) {
+        _Alloc( BatchBuff, MaxPacketLen );
+        if( BatchBuff == NULL ) {
+            SuppBatchId = 0;
+        }
+    }
+    return( SuppBatchId != 0 );
+}
+
+void FiniBatchSupp( void )
+{
+    _Free( BatchBuff );
+    BatchBuff = NULL;
+    SuppBatchId = 0;
+    Batching = false;
+}
+
+bool HaveRemoteBatch( void )
+{
+    return( SuppBatchId != 0 );
+}
+
+/*
+ * Send the queued requests. Any request the server didn't perform
+ * (an older server, or one that ran out of reply space) is done on
+ * its own.
+ */
+static void BatchSend( void )
+{
+    in_mx_entry         in[2];
+    mx_entry            out[2];
+    batch_access_req    acc;
+    batch_access_ret    ret;
+    batch_access_result result;
+    char                *reply;
+    char                *req;
+    trap_elen           reply_len;
+    trap_elen           len;
+    unsigned            i;
+
+    if( BatchCount == 0 )
+        return;
+    SUPP_BATCH_SERVICE( acc, REQ_BATCH_ACCESS );
+    acc.count = (unsigned_8)BatchCount;
+    in[0].ptr = &acc;
+    in[0].len = sizeof( acc );
+    in[1].ptr = BatchBuff;
+    in[1].len = BatchInLen;
+    _AllocA( reply, MaxPacketLen );
+    ret.count = 0;
+    out[0].ptr = &ret;
+    out[0].len = sizeof( ret );
+    out[1].ptr = reply;
+    out[1].len = MaxPacketLen - sizeof( ret );
+    reply_len = TrapAccess( 2, in, 2, out );
+    if( reply_len == REQUEST_FAILED || reply_len < sizeof( ret ) ) {
+        ret.count = 0;
+        reply_len = 0;
+    } else {
+        reply_len -= sizeof( ret );
+    }
+    req = BatchBuff;
+    for( i = 0; i < BatchCount; i++ ) {
+        req += sizeof( batch_access_entry );
+        if( i < ret.count && reply_len >= sizeof( result ) ) {
+            memcpy( &result, reply, sizeof( result ) );
+            CONV_LE_16( result.len );
+            reply += sizeof( result );
+            reply_len -= sizeof( result );
+            if( result.len > reply_len )
+                result.len = reply_len;
+            len = result.len;
+            if( len > BatchInfo[i].out_len )
+                len = BatchInfo[i].out_len;
+            memcpy( BatchInfo[i].out_data, reply, len );
+            reply += result.len;
+            reply_len -= result.len;
+        } else {
+            TrapSimpleAccess( BatchInfo[i].in_len, req, BatchInfo[i].out_len, BatchInfo[i].out_data );
+        }
+        req += BatchInfo[i].in_len;
+    }
+    BatchCount = 0;
+    BatchInLen = 0;
+    BatchOutLen = 0;
+}
+
+void RemoteBatchStart( void )
+{
+    Batching = ( SuppBatchId != 0 );
+    BatchCount = 0;
+    BatchInLen = 0;
+    BatchOutLen = 0;
+}
+
+/*
+ * Queue a request which doesn't depend on the result of any other queued
+ * one. The request is copied, but 'out_data' is written only by
+ * RemoteBatchFlush, so it must stay valid until then. Without a batch in
+ * progress the request is performed immediately. The server stops a batch
+ * at a request which runs or changes the program (a write, a breakpoint
+ * or watchpoint, go or step) and the rest is then sent one at a time, so
+ * queue only reads and thread freeze/thaw.
+ */
+void RemoteBatchAccess( trap_elen in_len, in_data_p in_data, trap_elen out_len, out_data_p out_data )
+{
+    batch_access_entry  entry;
+
+    if( Batching ) {
+        if( sizeof( batch_access_req ) + BatchInLen + sizeof( entry ) + in_len > MaxPacketLen
+          || sizeof( batch_access_ret ) + BatchOutLen + sizeof( batch_access_result ) + out_len > MaxPacketLen ) {
+            BatchSend();
+        }
+        if( sizeof( batch_access_req ) + sizeof( entry ) + in_len <= MaxPacketLen
+          && sizeof( batch_access_ret ) + sizeof( batch_access_result ) + out_len <= MaxPacketLen ) {
+            entry.in_len = in_len;
+            entry.out_len = out_len;
+            CONV_LE_16( entry.in_len );
+            CONV_LE_16( entry.out_len );
+            memcpy( BatchBuff + BatchInLen, &entry, sizeof( entry ) );
+            memcpy( BatchBuff + BatchInLen + sizeof( entry ), in_data, in_len );
+            BatchInLen += sizeof( entry ) + in_len;
+            BatchOutLen += sizeof( batch_access_result ) + out_len;
+            BatchInfo[BatchCount].in_len = in_len;
+            BatchInfo[BatchCount].out_len = out_len;
+            BatchInfo[BatchCount].out_data = out_data;
+            if( ++BatchCount == MAX_BATCH_COUNT )
+                BatchSend();
+            return;
+        }
+    }
+    TrapSimpleAccess( in_len, in_data, out_len, out_data );
+}
+
+void RemoteBatchFlush( void )
+{
+    if( Batching ) {
+        BatchSend();
+        Batching = false;
+    }
+}
@@ -49,6 +49,7 @@
 #include "removl.h"
 #include "addarith.h"
 #include "dbginit.h"
+#include "remrtrd.h"
 
 
 extern trap_elen        MaxPacketLen;
@@ -57,6 +58,12 @@ extern trap_elen        CurrRegSize;
 //NYI: We don't know the size of the incoming err msg. Now assume max is 80.
 #define MAX_ERR_MSG_SIZE        80
 
+#define MEM_PAGE_SHIFT          8
+#define MEM_PAGE_SIZE           (1U << MEM_PAGE_SHIFT)
+#define MEM_PAGE_MASK           (MEM_PAGE_SIZE - 1)
+#define MEM_CACHE_PAGES         64
+#define MEM_FETCH_PAGES         16  /* most pages a single peek may fetch */
+
 typedef struct{
     address         addr;
     size_t          len;
@@ -71,8 +78,23 @@ typedef struct {
     unsigned_8      data[1];    /* variable sized */
 } machine_data_cache;
 
+typedef struct {
+    addr_seg        segment;
+    addr48_off      offset;         /* page aligned */
+    unsigned long   used;           /* LRU stamp, 0 if the page is free */
+    unsigned        len;            /* bytes the target returned */
+    unsigned_8      data[MEM_PAGE_SIZE];
+} mem_page;
+
+typedef struct {
+    unsigned long   clock;
+    mem_page        page[MEM_CACHE_PAGES];
+    unsigned_8      fetch[MEM_FETCH_PAGES * MEM_PAGE_SIZE];
+} mem_cache;
+
 static cache_block              Cache;
 static machine_data_cache       *MData = NULL;
+static mem_cache                *MemCache = NULL;
 
 static bool IsInterrupt( addr_ptr *addr, trap_elen size )
 {
@@ -118,6 +140,137 @@ static size_t MemRead( address addr, void *ptr, size_t size )
     return( size - left );
 }
 
+/*
+ * Target memory is cached in MEM_PAGE_SIZE pages which are valid only
+ * while the program is stopped. Anything that may change the memory
+ * (running or stepping, writing memory or registers, switching threads)
+ * must call ClearMemCache.
+ */
+void ClearMemCache( void )
+{
+    int     i;
+
+    if( MemCache != NULL ) {
+        for( i = 0; i < MEM_CACHE_PAGES; i++ ) {
+            MemCache->page[i].used = 0;
+        }
+    }
+}
+
+static mem_page *FindMemPage( addr_seg segment, addr48_off offset )
+{
+    mem_page    *page;
+    int         i;
+
+    page = MemCache->page;
+    for( i = 0; i < MEM_CACHE_PAGES; i++, page++ ) {
+        if( page->used != 0 && page->offset == offset && page->segment == segment ) {
+            page->used = MemCache->clock;
+            return( page );
+        }
+    }
+    return( NULL );
+}
+
+static mem_page *NewMemPage( addr_seg segment, addr48_off offset )
+{
+    mem_page    *page;
+    mem_page    *lru;
+    int         i;
+
+    /*
+     * pages used by the current peek carry the current clock and are
+     * never the least recently used one
+     */
+    lru = page = MemCache->page;
+    for( i = 0; i < MEM_CACHE_PAGES; i++, page++ ) {
+        if( page->used == 0 ) {
+            lru = page;
+            break;
+        }
+        if( page->used < lru->used ) {
+            lru = page;
+        }
+    }
+    lru->segment = segment;
+    lru->offset = offset;
+    lru->used = MemCache->clock;
+    lru->len = 0;
+    return( lru );
+}
+
+/*
+ * Read the missing pages starting at 'offset' with one MemRead. The run
+ * stops at the first page that is already cached or after 'count' pages.
+ */
+static void FetchMemPages( address addr, addr48_off offset, unsigned count )
+{
+    mem_page    *page;
+    unsigned    pages;
+    size_t      len;
+    unsigned    i;
+
+    for( pages = 1; pages < count; pages++ ) {
+        if( FindMemPage( addr.mach.segment, offset + pages * MEM_PAGE_SIZE ) != NULL ) {
+            break;
+        }
+    }
+    addr.mach.offset = offset;
+    len = MemRead( addr, MemCache->fetch, pages * MEM_PAGE_SIZE );
+    for( i = 0; i < pages; i++ ) {
+        page = NewMemPage( addr.mach.segment, offset + i * MEM_PAGE_SIZE );
+        page->len = MEM_PAGE_SIZE;
+        if( len < MEM_PAGE_SIZE ) {
+            page->len = (unsigned)len;
+        }
+        memcpy( page->data, MemCache->fetch + i * MEM_PAGE_SIZE, page->len );
+        len -= page->len;
+    }
+}
+
+static size_t ReadMemCache( address addr, char *data, size_t len )
+{
+    mem_page    *page;
+    addr48_off  offset;
+    unsigned    start;
+    unsigned    pages;
+    size_t      piece;
+    size_t      left;
+    unsigned    i;
+
+    if( len == 0 || MemCache == NULL || addr.sect_id != 0 || HaveRemoteRunThread() )
+        return( 0 );
+    offset = addr.mach.offset & ~(addr48_off)MEM_PAGE_MASK;
+    start = (unsigned)( addr.mach.offset & MEM_PAGE_MASK );
+    if( len > MEM_FETCH_PAGES * MEM_PAGE_SIZE - start )
+        return( 0 );
+    pages = (unsigned)( ( start + len + MEM_PAGE_MASK ) >> MEM_PAGE_SHIFT );
+    MemCache->clock++;
+    left = len;
+    for( i = 0; i < pages; i++ ) {
+        page = FindMemPage( addr.mach.segment, offset );
+        if( page == NULL ) {
+            FetchMemPages( addr, offset, pages - i );
+            page = FindMemPage( addr.mach.segment, offset );
+        }
+        if( page->len <= start )
+            break;
+        piece = page->len - start;
+        if( piece > left )
+            piece = left;
+        memcpy( data, page->data + start, piece );
+        data += piece;
+        left -= piece;
+        if( left == 0 )
+            break;
+        if( page->len != MEM_PAGE_SIZE )
+            break;
+        start = 0;
+        offset += MEM_PAGE_SIZE;
+    }
+    return( len - left );
+}
+
 void FiniCache( void )
 {
     _Free( Cache.data );
@@ -165,7 +318,13 @@ size_t ProgPeek( address addr, void *data, size_t len )
 {
     if( ReadCache( addr, data, len ) ) {
         return( len );
+    } else if( ReadMemCache( addr, data, len ) == len ) {
+        return( len );
     } else {
+        /*
+         * let the trap file decide about reads the page cache
+         * can not satisfy completely
+         */
         return( MemRead( addr, data, len ) );
     }
 }
@@ -180,6 +339,7 @@ size_t ProgPoke( address addr, const void *data, size_t len )
     size_t              left;
     trap_elen           piece_len;
 
+    ClearMemCache();
     SectLoad( addr.sect_id );
     acc.req = REQ_WRITE_MEM;
     AddrFix( &addr );
@@ -248,6 +408,7 @@ trap_retval PortPoke( unsigned port, const void *data, uint_8 size )
     write_io_req        acc;
     write_io_ret        ret;
 
+    ClearMemCache();
     acc.req = REQ_WRITE_IO;
     acc.IO_offset = port;
     in[0].ptr = &acc;
@@ -284,6 +445,7 @@ static void WriteRegs( machine_state *state )
     write_regs_req      acc;
 //    mad_status          ms;
 
+    ClearMemCache();
 //    ms = MADRegistersTarget( &state->mr );
     MADRegistersTarget( &state->mr );
     acc.req = REQ_WRITE_REGS;
@@ -333,6 +495,7 @@ error_handle DoLoad( const char *args, unsigned long *phandle )
     prog_load_ret       ret;
 
     ClearMachineDataCache();
+    ClearMemCache();
     acc.req = REQ_PROG_LOAD;
     acc.true_argv = _IsOn( SW_TRUE_ARGV );
     in[0].ptr = &acc;
@@ -395,6 +558,7 @@ bool KillProgOvlay( void )
     FreeThreads();
     RemoteGetSysConfig();
     ClearMachineDataCache();
+    ClearMemCache();
     CONV_LE_32( ret.err );
     return( ( ret.err == 0 ) );
 }
@@ -406,6 +570,7 @@ unsigned MakeProgRun( bool single )
     prog_go_ret         ret;
     addr_ptr            tmp;
 
+    ClearMemCache();
     acc.req = single ? REQ_PROG_STEP : REQ_PROG_GO;
     RestoreHandlers();
     DUIExitCriticalSection();
@@ -598,6 +763,7 @@ dword RemoteSetBreak( address addr )
     set_break_req       acc;
     set_break_ret       ret;
 
+    ClearMemCache();
     acc.req = REQ_SET_BREAK;
     AddrFix( &addr );
     acc.break_addr = addr.mach;
@@ -611,6 +777,7 @@ void RemoteRestoreBreak( address addr, dword value )
 {
     clear_break_req     acc;
 
+    ClearMemCache();
     acc.req = REQ_CLEAR_BREAK;
     AddrFix( &addr );
     acc.break_addr = addr.mach;
@@ -710,6 +877,11 @@ bool InitCoreSupp( void )
         _Alloc( MData, sizeof( *MData ) );
         MData->len = sizeof( MData->data );
         ClearMachineDataCache();
+        _Alloc( MemCache, sizeof( *MemCache ) );
+        if( MemCache != NULL ) {
+            MemCache->clock = 0;
+            ClearMemCache();
+        }
         RemoteGetSysConfig();
         CheckMADChange();
         return( true );
@@ -720,6 +892,8 @@ bool InitCoreSupp( void )
 
 void FiniCoreSupp( void )
 {
+    _Free( MemCache );
+    MemCache = NULL;
     _Free( MData );
     MData = NULL;
 }
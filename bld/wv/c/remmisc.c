@@ -50,6 +50,7 @@
 #include "remfile.h"
 #include "removl.h"
 #include "remasync.h"
+#include "rembatch.h"
 #include "remenv.h"
 #include "dbginit.h"
 #include "dbgerr.h"
@@ -83,11 +84,13 @@ void InitSuppServices( void )
         InitOvlSupp();
         InitAsyncSupp();
         InitCapabilities();
+        InitBatchSupp();
     }
 }
 
 void FiniSuppServices( void )
 {
+    FiniBatchSupp();
     FiniCoreSupp();
 }
 
@@ -202,6 +205,7 @@ void RemoteResume( void )
 {
     resume_req          acc;
 
+    ClearMemCache();
     acc.req = REQ_RESUME;
     TrapSimpleAccess( sizeof( acc ), &acc, 0, NULL );
 }
@@ -37,6 +37,7 @@
 #include "dbgovl.h"
 #include "trpld.h"
 #include "removl.h"
+#include "remcore.h"
 
 
 static trap_shandle     SuppOvlId = 0;
@@ -115,6 +116,7 @@ void RemoteSectTblWrite( const byte *ovl )
     in_mx_entry         in[2];
     ovl_write_state_req acc;
 
+    ClearMemCache();
     SUPP_OVL_SERVICE( acc, REQ_OVL_WRITE_STATE );
     in[0].ptr = &acc;
     in[0].len = sizeof( acc );
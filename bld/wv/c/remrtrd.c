@@ -30,8 +30,10 @@
 ****************************************************************************/
 
 
+#include <string.h>
 #include "dbgdefn.h"
 #include "dbgdata.h"
+#include "dbgmem.h"
 #include "dbgio.h"
 #include "trprtrd.h"
 #include "trapaccs.h"
@@ -41,6 +43,7 @@
 #include "remcore.h"
 #include "dbgmisc.h"
 #include "remrtrd.h"
+#include "rembatch.h"
 #include "trpld.h"
 
 
@@ -163,6 +166,54 @@ void RemoteUpdateRunThread( thread_state *thd )
     thd->eip = ret.eip;
 }
 
+#define RUNTIME_INFO_SIZE   (sizeof( run_thread_get_runtime_ret ) + MAX_THD_EXTRA_SIZE)
+
+void RemoteUpdateRunThreads( thread_state *head )
+{
+    run_thread_get_runtime_req      acc;
+    run_thread_get_runtime_ret      ret;
+    thread_state                    *thd;
+    char                            *info;
+    char                            *p;
+    unsigned                        count;
+
+    if( SuppRunThreadId == 0 )
+        return;
+
+    count = 0;
+    for( thd = head; thd != NULL; thd = thd->link ) {
+        count++;
+    }
+    _Alloc( info, count * RUNTIME_INFO_SIZE );
+    if( info == NULL ) {
+        for( thd = head; thd != NULL; thd = thd->link ) {
+            RemoteUpdateRunThread( thd );
+        }
+        return;
+    }
+    memset( info, 0, count * RUNTIME_INFO_SIZE );
+
+    acc.supp.core_req = REQ_PERFORM_SUPPLEMENTARY_SERVICE;
+    acc.supp.id = SuppRunThreadId;
+    acc.req = REQ_RUN_THREAD_GET_RUNTIME;
+
+    RemoteBatchStart();
+    for( p = info, thd = head; thd != NULL; p += RUNTIME_INFO_SIZE, thd = thd->link ) {
+        acc.thread = thd->tid;
+        RemoteBatchAccess( sizeof( acc ), &acc, RUNTIME_INFO_SIZE, p );
+    }
+    RemoteBatchFlush();
+
+    for( p = info, thd = head; thd != NULL; p += RUNTIME_INFO_SIZE, thd = thd->link ) {
+        memcpy( &ret, p, sizeof( ret ) );
+        memcpy( thd->extra, p + sizeof( ret ), MAX_THD_EXTRA_SIZE );
+        thd->state = ret.state;
+        thd->cs = ret.cs;
+        thd->eip = ret.eip;
+    }
+    _Free( info );
+}
+
 //NYI: We don't know the size of the incoming name. Now assume max is 80.
 #define MAX_THD_NAME_LEN       80
 
@@ -189,6 +240,8 @@ dtid_t RemoteSetRunThreadWithErr( dtid_t tid, error_handle *errh )
 
     if( SuppRunThreadId == 0 )
         return( DEFAULT_TID );
+    if( tid != 0 )
+        ClearMemCache();
     acc.supp.core_req = REQ_PERFORM_SUPPLEMENTARY_SERVICE;
     acc.supp.id = SuppRunThreadId;
     acc.req = REQ_RUN_THREAD_SET;
@@ -37,6 +37,8 @@
 #include "trpthrd.h"
 #include "trapglbl.h"
 #include "trpld.h"
+#include "remcore.h"
+#include "rembatch.h"
 #include "remthrd.h"
 
 #define DEFAULT_TID     1
@@ -77,6 +79,8 @@ dtid_t RemoteSetThreadWithErr( dtid_t tid, error_handle *errh )
 
     if( SuppThreadId == 0 )
         return( DEFAULT_TID );
+    if( tid != 0 )
+        ClearMemCache();
     SUPP_THREAD_SERVICE( acc, REQ_THREAD_SET );
     acc.thread = tid;
     TrapSimpleAccess( sizeof( acc ), &acc, sizeof( ret ), &ret );
@@ -87,30 +91,32 @@ dtid_t RemoteSetThreadWithErr( dtid_t tid, error_handle *errh )
     return( ret.old_thread );
 }
 
-long RemoteFreezeThread( dtid_t tid )
+/*
+ * Freeze and thaw can be part of a batch, so their error (which nobody
+ * looks at) goes to a static buffer.
+ */
+static thread_freeze_ret    FreezeRet;
+
+void RemoteFreezeThread( dtid_t tid )
 {
     thread_freeze_req   acc;
-    thread_freeze_ret   ret;
 
     if( SuppThreadId == 0 )
-        return( 0 );
+        return;
     SUPP_THREAD_SERVICE( acc, REQ_THREAD_FREEZE );
     acc.thread = tid;
-    TrapSimpleAccess( sizeof( acc ), &acc, sizeof( ret ), &ret );
-    return( ret.err );
+    RemoteBatchAccess( sizeof( acc ), &acc, sizeof( FreezeRet ), &FreezeRet );
 }
 
-long RemoteThawThread( dtid_t tid )
+void RemoteThawThread( dtid_t tid )
 {
     thread_thaw_req     acc;
-    thread_thaw_ret     ret;
 
     if( SuppThreadId == 0 )
-        return( 0 );
+        return;
     SUPP_THREAD_SERVICE( acc, REQ_THREAD_THAW );
     acc.thread = tid;
-    TrapSimpleAccess( sizeof( acc ), &acc, sizeof( ret ), &ret );
-    return( ret.err );
+    RemoteBatchAccess( sizeof( acc ), &acc, sizeof( FreezeRet ), &FreezeRet );
 }
 
 //NYI: We don't know the size of the incoming name. Now assume max is 80.
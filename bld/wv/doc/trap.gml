@@ -3231,6 +3231,80 @@ contains status if exact breakpoints are currently active on the remote system.
 .endlevel
 .*
 .*
+.section Batch requests
+.*
+.np
+This section describes requests that let the debugger send several
+independent requests to a remote server in one packet.
+These requests are actually performed by the
+core request REQ_PERFORM_SUPPLEMENTARY_SERVICE and appropriate service ID.
+The following descriptions do not show that "prefix" to the request messages.
+.np
+The service name to be used in the REQ_GET_SUPPLEMENTARY_SERVICE is
+"Batch".
+The service is provided by the remote server and not by the trap file,
+so it is available for any trap file used through the server.
+An older server passes the query to the trap file which returns a zero
+service ID and the debugger sends each request on its own.
+.*
+.beglevel
+.*
+.section REQ_BATCH_ACCESS
+.*
+.np
+Request to perform a number of requests with one packet exchange.
+.np
+Request message:
+.millust begin
+trap_req        req
+unsigned_8      count
+--------------------------
+unsigned_16     in_len
+unsigned_16     out_len
+bytes           request
+--------------------------
+ ...
+.millust end
+.pp
+The
+.id count
+field contains the number of requests which follow.
+Every request is preceded by its size in
+.id in_len
+and the maximum size of its return message in
+.id out_len
+.period
+An
+.id out_len
+of zero means the request has no return message.
+The requests must not depend on each other and they must not be
+REQ_CONNECT, REQ_DISCONNECT, REQ_SUSPEND, REQ_RESUME,
+REQ_PROG_LOAD, REQ_PROG_KILL,
+REQ_GET_SUPPLEMENTARY_SERVICE or another REQ_BATCH_ACCESS.
+.np
+Return message:
+.millust begin
+unsigned_8      count
+--------------------------
+unsigned_16     len
+bytes           reply
+--------------------------
+ ...
+.millust end
+.pp
+The server performs the requests in order.
+The
+.id count
+field contains the number of requests performed, each one followed by its
+return message and its size in
+.id len
+.period
+The server stops at the first request which it can not perform or whose
+return message would not fit in the packet. The debugger must perform the
+remaining requests on their own.
+.endlevel
+.*
+.*
 .chap System Dependent Aspects
 .*
 Every environment has a different method of loading the code for the trap
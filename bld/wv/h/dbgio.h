@@ -68,6 +68,8 @@ extern size_t           WriteNL( file_handle );
 extern size_t           WriteText( file_handle, const void *, size_t );
 
 extern unsigned long    SeekStream( file_handle, long, seek_method );
+extern void             *FileMapView( file_handle, unsigned long, unsigned long );
+extern void             FileUnmapView( void *, unsigned long );
 
 extern file_handle      FileOpen( char const *, obj_attrs );
 extern error_handle     FileClose( file_handle );
@@ -39,6 +39,8 @@ extern error_handle     LocalClose( sys_handle );
 extern sys_handle       LocalHandleSys( file_handle );
 extern long             LocalGetFileDate( const char *name );
 extern bool             LocalSetFileDate( const char *name, long date );
+extern void             *LocalMapView( sys_handle, unsigned long offset, unsigned long size );
+extern void             LocalUnmapView( void *view, unsigned long size );
 
 extern const file_components    LclFile;
 extern const char               LclPathSep;
@@ -42,6 +42,7 @@ extern void             ReadDbgRegs( void );
 extern void             WriteDbgRegs( void );
 extern trap_elen        ArgsLen( const char *args );
 extern void             ClearMachineDataCache( void );
+extern void             ClearMemCache( void );
 extern error_handle     DoLoad( const char *args, unsigned long *phandle );
 extern bool             KillProgOvlay( void );
 extern unsigned         MakeProgRun( bool single );
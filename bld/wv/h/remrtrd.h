@@ -35,6 +35,7 @@ extern bool     RemoteGetRunThreadInfo( int row, unsigned char *infotype, int *w
 extern dtid_t   RemoteGetNextRunThread( dtid_t tid );
 extern void     RemotePollRunThread( void );
 extern void     RemoteUpdateRunThread( thread_state *thd );
+extern void     RemoteUpdateRunThreads( thread_state *head );
 extern void     RemoteRunThdName( dtid_t tid, char *name );
 extern dtid_t   RemoteSetRunThreadWithErr( dtid_t tid, error_handle *errh );
 extern dtid_t   RemoteSetRunThread( dtid_t tid );
@@ -36,6 +36,7 @@
 #include <stddef.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include "dbgdefn.h"
 #include "dbgdata.h"
@@ -174,3 +175,26 @@ sys_handle LocalHandleSys( file_handle fh )
     FH2SYSH( sh, fh );
     return( sh );
 }
+
+void *LocalMapView( sys_handle sh, unsigned long offset, unsigned long size )
+{
+    unsigned long   delta;
+    char            *base;
+
+    /*
+     * mmap wants a page aligned file offset
+     */
+    delta = offset % sysconf( _SC_PAGESIZE );
+    base = mmap( NULL, size + delta, PROT_READ, MAP_PRIVATE, SYSH2LH( sh ), offset - delta );
+    if( base == MAP_FAILED )
+        return( NULL );
+    return( base + delta );
+}
+
+void LocalUnmapView( void *view, unsigned long size )
+{
+    unsigned long   delta;
+
+    delta = (unsigned long)view % sysconf( _SC_PAGESIZE );
+    munmap( (char *)view - delta, size + delta );
+}
@@ -33,6 +33,7 @@
 
 #include <limits.h>
 #include <stddef.h>
+#include <windows.h>
 #include "wio.h"
 #include "dbgdefn.h"
 #if !defined( BUILD_RFX )
@@ -204,3 +205,39 @@ sys_handle LocalHandleSys( file_handle fh )
     FH2SYSH( sh, fh );
     return( sh );
 }
+
+void *LocalMapView( sys_handle sh, unsigned long offset, unsigned long size )
+{
+    SYSTEM_INFO         si;
+    HANDLE              map;
+    DWORD               delta;
+    char                *base;
+
+    /*
+     * the view must start on an allocation granularity boundary
+     */
+    GetSystemInfo( &si );
+    delta = offset % si.dwAllocationGranularity;
+    map = CreateFileMapping( (HANDLE)_get_osfhandle( SYSH2LH( sh ) ), NULL, PAGE_READONLY, 0, 0, NULL );
+    if( map == NULL ) {
+        return( NULL );
+    }
+    base = MapViewOfFile( map, FILE_MAP_READ, 0, offset - delta, size + delta );
+    /* the view keeps the mapping object alive */
+    CloseHandle( map );
+    if( base == NULL ) {
+        return( NULL );
+    }
+    return( base + delta );
+}
+
+void LocalUnmapView( void *view, unsigned long size )
+{
+    MEMORY_BASIC_INFORMATION    mbi;
+
+    /* unused parameters */ (void)size;
+
+    if( VirtualQuery( view, &mbi, sizeof( mbi ) ) != 0 ) {
+        UnmapViewOfFile( mbi.AllocationBase );
+    }
+}
@@ -90,6 +90,12 @@ treat source files as C code
 .ix '&wclcmdup16 options' 'cc++'
 .ix '&wclcmdup32 options' 'cc++'
 treat source files as C++ code
+.note j<num>
+.ix '&wclcmdup16 options' 'j<num>'
+.ix '&wclcmdup32 options' 'j<num>'
+run up to <num> compiles in parallel; the output of each compile is
+displayed in command line order and the linker is run only when all
+compiles have succeeded
 .note y
 .ix '&wclcmdup16 options' 'y'
 .ix '&wclcmdup32 options' 'y'
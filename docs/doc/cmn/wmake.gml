@@ -147,6 +147,8 @@ debug mode - echo all work as it progresses
 always erase target after error/interrupt (disables prompting)
 .note &sw.f
 the next parameter is a name of dependency description file
+.note &sw.g n
+execute up to n command lists in parallel (UNIX hosts only)
 .note &sw.h
 do not print out &maksname identification lines (no header)
 .note &sw.i
@@ -269,6 +271,24 @@ Any number of makefiles may be processed with the "f" option.
 &makcmd /f myfile
 &makcmd /f myfile1 /f myfile2
 .exam end
+:OPT name='g'
+.ix '&makcmdup options' 'g'
+.ix '&makcmdup' 'parallel execution'
+.ix 'parallel execution'
+execute up to n command lists in parallel
+.np
+The "g" option is followed by
+the maximum number of command lists that &maksname may execute at the
+same time.
+Each command list is executed by a separate process and the output of
+each command list is displayed when it terminates, so lines from
+different command lists are not mixed.
+Targets are updated only after all their dependents are up to date.
+Changes of the environment or of the current directory done by a command
+list are not seen by the other command lists.
+The "k" option and the
+.id &sysper.ERROR
+directive work in the same way as without the "g" option.
 :OPT name='h'
 .ix '&makcmdup options' 'h'
 do not print out &maksname identification lines (no header)
@@ -287,6 +307,7 @@ ignore return status of all commands executed
 The "i" option is equivalent to the
 .id &sysper.IGNORE
 directive.
+This option is available on UNIX hosts only.
 :OPT name='k'
 .ix '&makcmdup options' 'k'
 on error/interrupt: continue on next target